@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+배치 본문의 JSON 대비 MessagePack 인코딩 비용과 크기 비교 벤치마크
+
+사용법:
+    pip install msgpack
+    python mcp_server/benchmarks/encoding_benchmark.py --paths 1000
+    python mcp_server/benchmarks/encoding_benchmark.py --paths 1000 --live
+
+기본 모드는 클라이언트 쪽 인코딩/디코딩만 측정합니다(/stamp 요청 본문과 응답).
+--live 를 주면 실행 중인 에디터에 /assets/query 를 두 형식으로 번갈아 보내 왕복 시간을 비교합니다.
+/assets/query 는 읽기 전용이므로 프로젝트에 애셋이 생기지 않습니다.
+플러그인 쪽 디코딩/인코딩 비용은 UnrealMCP.Perf 의 BatchJsonParse / BatchMsgPackParse,
+BatchJsonSerialize / BatchMsgPackSerialize 테스트로 측정합니다.
+"""
+
+import argparse
+import asyncio
+import json
+import statistics
+import time
+
+import aiohttp
+import msgpack
+
+MSGPACK_CONTENT_TYPE = "application/msgpack"
+
+
+def make_stamp_request(path_count):
+    """경로 목록을 가진 /stamp 요청 본문"""
+    return {
+        "template": "PrintStringActor",
+        "node_types": ["PrintString"],
+        "paths": [f"/Game/Generated/BP_Stamped_{index}" for index in range(path_count)],
+    }
+
+
+def make_stamp_response(path_count):
+    """모든 경로를 생성한 /stamp 응답 본문"""
+    return {
+        "success": True,
+        "message": f"Stamped {path_count} of {path_count} asset(s) from template 'PrintStringActor' (0 unchanged)",
+        "template": "PrintStringActor",
+        "created": [f"/Game/Generated/BP_Stamped_{index}" for index in range(path_count)],
+        "unchanged": [],
+        "failed": [],
+        "skipped": 0,
+        "template_build_ms": 212.75,
+        "elapsed_ms": 1840.5,
+        "job_id": 4711,
+    }
+
+
+def time_us(function, iterations):
+    """function 을 iterations 회 실행하고 회당 시간(µs)의 중앙값을 반환"""
+    samples = []
+    for _ in range(iterations):
+        start = time.perf_counter()
+        function()
+        samples.append((time.perf_counter() - start) * 1_000_000.0)
+    return statistics.median(samples)
+
+
+def measure_codecs(body, iterations):
+    """한 본문에 대해 두 형식의 크기와 인코딩/디코딩 시간을 측정"""
+    json_bytes = json.dumps(body).encode("utf-8")
+    msgpack_bytes = msgpack.packb(body, use_bin_type=True)
+    return {
+        "json": {
+            "bytes": len(json_bytes),
+            "encode_us": time_us(lambda: json.dumps(body).encode("utf-8"), iterations),
+            "decode_us": time_us(lambda: json.loads(json_bytes), iterations),
+        },
+        "msgpack": {
+            "bytes": len(msgpack_bytes),
+            "encode_us": time_us(lambda: msgpack.packb(body, use_bin_type=True), iterations),
+            "decode_us": time_us(lambda: msgpack.unpackb(msgpack_bytes, raw=False), iterations),
+        },
+    }
+
+
+async def measure_live(args):
+    """/assets/query 왕복 시간을 두 형식으로 번갈아 측정"""
+    base_url = f"http://{args.host}:{args.port}"
+    payload = {"paths": [f"{args.path_prefix}/BP_Query_{index}" for index in range(args.paths)]}
+    latencies_ms = {"json": [], "msgpack": []}
+
+    async with aiohttp.ClientSession(timeout=aiohttp.ClientTimeout(total=args.timeout)) as session:
+        # 번갈아 보내 에디터 상태 변화가 한쪽에만 몰리지 않게 함
+        for _ in range(args.requests):
+            for encoding in ("json", "msgpack"):
+                if encoding == "json":
+                    request = {"json": payload}
+                else:
+                    request = {
+                        "data": msgpack.packb(payload, use_bin_type=True),
+                        "headers": {"Content-Type": MSGPACK_CONTENT_TYPE, "Accept": MSGPACK_CONTENT_TYPE},
+                    }
+
+                start = time.perf_counter()
+                async with session.post(f"{base_url}/assets/query", **request) as response:
+                    raw = await response.read()
+                    if response.status != 200:
+                        raise RuntimeError(f"{encoding}: HTTP {response.status}")
+                    if response.content_type == MSGPACK_CONTENT_TYPE:
+                        result = msgpack.unpackb(raw, raw=False)
+                    else:
+                        result = json.loads(raw)
+                latencies_ms[encoding].append((time.perf_counter() - start) * 1000.0)
+
+                if result.get("count") != args.paths:
+                    raise RuntimeError(f"{encoding}: expected {args.paths} results, got {result.get('count')}")
+
+    return {
+        encoding: {
+            "requests": len(samples),
+            "median_ms": statistics.median(samples),
+            "p90_ms": sorted(samples)[int(0.9 * (len(samples) - 1))],
+        }
+        for encoding, samples in latencies_ms.items()
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare JSON and MessagePack encodings on batch payloads")
+    parser.add_argument("--paths", type=int, default=1000, help="Paths per batch body")
+    parser.add_argument("--iterations", type=int, default=200, help="Codec iterations per measurement")
+    parser.add_argument("--live", action="store_true", help="Also measure /assets/query round trips against a running editor")
+    parser.add_argument("--requests", type=int, default=50, help="Round trips per encoding in --live mode")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--path-prefix", default="/Game/MCPBench/Encoding")
+    parser.add_argument("--timeout", type=float, default=60.0)
+    parser.add_argument("--output", help="Write the result JSON to this file")
+    args = parser.parse_args()
+
+    result = {
+        "paths": args.paths,
+        "stamp_request": measure_codecs(make_stamp_request(args.paths), args.iterations),
+        "stamp_response": measure_codecs(make_stamp_response(args.paths), args.iterations),
+    }
+    if args.live:
+        result["assets_query_round_trip"] = asyncio.run(measure_live(args))
+
+    print(json.dumps(result, indent=2))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            json.dump(result, output_file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
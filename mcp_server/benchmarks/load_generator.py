@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+"""
+언리얼 MCP HTTP API 부하 생성기 및 지연 시간 벤치마크
+
+요청 코퍼스를 실행 중인 서버에 재생하면서 라우트별 처리량, p50/p90/p99/p999 지연 시간,
+오류 분포를 측정하고 결과를 JSON으로 기록합니다(실행 간 diff 가능).
+
+모드:
+    closed  - 동시 처리 중인 요청 수를 --concurrency 로 고정 (응답을 받으면 다음 요청 전송)
+    open    - --rate 요청/초로 도착 시각을 미리 정해 전송 (서버가 느려져도 전송 속도 유지).
+              지연 시간은 예정 전송 시각부터 측정하므로 대기열 지연이 누락되지 않습니다.
+
+사용법:
+    python mcp_server/benchmarks/load_generator.py --mode closed --concurrency 4 --duration 30
+    python mcp_server/benchmarks/load_generator.py --mode open --rate 50 --duration 30 --output run.json
+    python mcp_server/benchmarks/load_generator.py --corpus Ops.jsonl --mode closed --concurrency 8
+
+라우트 구성:
+    --config 로 지정한 JSON의 "routes" 목록에서 요청을 가중치대로 생성합니다.
+    새 라우트는 코드 수정 없이 구성에 항목을 추가하면 됩니다 (기본값: load_routes.json).
+    본문 문자열의 {run_id}, {seq} 는 실행 ID와 요청 번호로 치환됩니다.
+"""
+
+import argparse
+import asyncio
+import itertools
+import json
+import math
+import os
+import random
+import time
+import uuid
+from collections import Counter, defaultdict
+
+import aiohttp
+
+DEFAULT_CONFIG = os.path.join(os.path.dirname(os.path.abspath(__file__)), "load_routes.json")
+
+
+def percentile(sorted_values, fraction):
+    """정렬된 값의 nearest-rank 백분위"""
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, max(0, math.ceil(fraction * len(sorted_values)) - 1))
+    return sorted_values[index]
+
+
+def substitute(value, run_id, seq):
+    """본문 템플릿의 {run_id}, {seq} 치환 (중첩 구조 포함)"""
+    if isinstance(value, str):
+        return value.replace("{run_id}", run_id).replace("{seq}", str(seq))
+    if isinstance(value, list):
+        return [substitute(item, run_id, seq) for item in value]
+    if isinstance(value, dict):
+        return {key: substitute(item, run_id, seq) for key, item in value.items()}
+    return value
+
+
+def generated_corpus(routes, run_id, seed):
+    """구성된 라우트에서 가중치대로 요청을 무한히 생성"""
+    rng = random.Random(seed)
+    weights = [route.get("weight", 1) for route in routes]
+    for seq in itertools.count():
+        route = rng.choices(routes, weights=weights)[0]
+        body = route.get("body")
+        yield {
+            "name": route.get("name", route["path"]),
+            "method": route.get("method", "POST" if body is not None else "GET").upper(),
+            "path": route["path"],
+            "port": route.get("port"),
+            "body": substitute(body, run_id, seq) if body is not None else None,
+        }
+
+
+def file_corpus(corpus_path, loop):
+    """
+    JSONL 코퍼스 파일에서 요청을 읽음 (커맨드릿 매니페스트와 같은 형식)
+    {"route": "/stamp", "body": {...}}, {"method": "GET", "route": "/status"}, 또는 /add_node 본문 그대로
+    """
+    while True:
+        with open(corpus_path, "r", encoding="utf-8") as corpus:
+            for line in corpus:
+                line = line.strip()
+                if not line or line.startswith("#"):
+                    continue
+                entry = json.loads(line)
+                route = entry.get("route", "/add_node")
+                body = entry.get("body", None if "route" in entry else entry)
+                if isinstance(body, str):
+                    body = json.loads(body)
+                yield {
+                    "name": route,
+                    "method": entry.get("method", "POST" if body is not None else "GET").upper(),
+                    "path": route,
+                    "body": body,
+                }
+        if not loop:
+            return
+
+
+class Recorder:
+    """라우트별 지연 시간과 오류 집계"""
+
+    def __init__(self):
+        self.latencies_ms = defaultdict(list)
+        self.errors = defaultdict(Counter)
+        self.completed = 0
+
+    def record(self, name, latency_ms, error):
+        self.completed += 1
+        if error:
+            self.errors[name][error] += 1
+        else:
+            self.latencies_ms[name].append(latency_ms)
+
+    def summary(self, elapsed_seconds):
+        routes = {}
+        all_latencies = []
+        for name in sorted(set(self.latencies_ms) | set(self.errors)):
+            latencies = sorted(self.latencies_ms[name])
+            all_latencies.extend(latencies)
+            routes[name] = {
+                "ok": len(latencies),
+                "errors": dict(self.errors[name]),
+                "throughput_rps": len(latencies) / elapsed_seconds if elapsed_seconds > 0 else 0.0,
+                "latency_ms": latency_summary(latencies),
+            }
+
+        all_latencies.sort()
+        error_count = sum(sum(counter.values()) for counter in self.errors.values())
+        return {
+            "requests": self.completed,
+            "ok": len(all_latencies),
+            "errors": error_count,
+            "elapsed_seconds": elapsed_seconds,
+            "throughput_rps": len(all_latencies) / elapsed_seconds if elapsed_seconds > 0 else 0.0,
+            "latency_ms": latency_summary(all_latencies),
+            "routes": routes,
+        }
+
+
+def latency_summary(sorted_latencies):
+    return {
+        "p50": percentile(sorted_latencies, 0.50),
+        "p90": percentile(sorted_latencies, 0.90),
+        "p99": percentile(sorted_latencies, 0.99),
+        "p999": percentile(sorted_latencies, 0.999),
+        "max": sorted_latencies[-1] if sorted_latencies else 0.0,
+        "mean": sum(sorted_latencies) / len(sorted_latencies) if sorted_latencies else 0.0,
+    }
+
+
+async def send(session, base_url, request, recorder, start_time):
+    """요청 하나를 보내고 start_time 기준 지연 시간을 기록"""
+    error = None
+    if request.get("port"):
+        # 헬스 포트처럼 다른 포트로 보내는 라우트
+        base_url = f"{base_url.rsplit(':', 1)[0]}:{request['port']}"
+    try:
+        async with session.request(request["method"], base_url + request["path"], json=request["body"]) as response:
+            payload = await response.read()
+            if response.status >= 400:
+                error = f"http_{response.status}"
+            elif response.content_type == "application/json":
+                # 플러그인은 일부 실패를 200 + success=false 로 보고
+                try:
+                    if json.loads(payload).get("success") is False:
+                        error = "success_false"
+                except (ValueError, AttributeError):
+                    error = "invalid_json"
+    except asyncio.TimeoutError:
+        error = "timeout"
+    except aiohttp.ClientError as exc:
+        error = type(exc).__name__
+    recorder.record(request["name"], (time.perf_counter() - start_time) * 1000.0, error)
+
+
+async def run_closed(session, base_url, corpus, recorder, args):
+    """closed-loop: 워커 --concurrency 개가 응답을 받을 때마다 다음 요청 전송"""
+    deadline = time.perf_counter() + args.duration
+
+    async def worker():
+        while time.perf_counter() < deadline:
+            request = next(corpus, None)
+            if request is None:
+                return
+            await send(session, base_url, request, recorder, time.perf_counter())
+
+    await asyncio.gather(*(worker() for _ in range(args.concurrency)))
+
+
+async def run_open(session, base_url, corpus, recorder, args):
+    """open-loop: 도착 시각을 1/rate 간격(또는 포아송)으로 정해 응답과 무관하게 전송"""
+    rng = random.Random(args.seed)
+    in_flight = set()
+    start = time.perf_counter()
+    scheduled = start
+    dropped = 0
+
+    while scheduled - start < args.duration:
+        request = next(corpus, None)
+        if request is None:
+            break
+
+        delay = scheduled - time.perf_counter()
+        if delay > 0:
+            await asyncio.sleep(delay)
+
+        if len(in_flight) >= args.max_in_flight:
+            # 클라이언트 보호용 상한; 초과분은 전송하지 않고 오류로 집계
+            dropped += 1
+            recorder.record(request["name"], 0.0, "client_overload")
+        else:
+            task = asyncio.create_task(send(session, base_url, request, recorder, scheduled))
+            in_flight.add(task)
+            task.add_done_callback(in_flight.discard)
+
+        scheduled += rng.expovariate(args.rate) if args.poisson else 1.0 / args.rate
+
+    if in_flight:
+        await asyncio.gather(*in_flight)
+    return dropped
+
+
+async def run(args):
+    base_url = f"http://{args.host}:{args.port}"
+    run_id = uuid.uuid4().hex[:8]
+
+    with open(args.config, "r", encoding="utf-8") as config_file:
+        config = json.load(config_file)
+    routes = [route for route in config["routes"] if not args.routes or route.get("name", route["path"]) in args.routes]
+    if not routes and not args.corpus:
+        raise SystemExit("No routes selected")
+
+    corpus = file_corpus(args.corpus, loop=args.loop_corpus) if args.corpus else generated_corpus(routes, run_id, args.seed)
+    recorder = Recorder()
+
+    connector = aiohttp.TCPConnector(limit=max(args.concurrency, args.max_in_flight))
+    timeout = aiohttp.ClientTimeout(total=args.timeout)
+    async with aiohttp.ClientSession(connector=connector, timeout=timeout) as session:
+        # 측정 전 워밍업 요청 (집계에서 제외)
+        warmup_recorder = Recorder()
+        for _ in range(args.warmup):
+            request = next(corpus, None)
+            if request is None:
+                break
+            await send(session, base_url, request, warmup_recorder, time.perf_counter())
+
+        start = time.perf_counter()
+        dropped = 0
+        if args.mode == "open":
+            dropped = await run_open(session, base_url, corpus, recorder, args)
+        else:
+            await run_closed(session, base_url, corpus, recorder, args)
+        elapsed = time.perf_counter() - start
+
+    result = {
+        "run_id": run_id,
+        "target": base_url,
+        "mode": args.mode,
+        "concurrency": args.concurrency if args.mode == "closed" else None,
+        "rate": args.rate if args.mode == "open" else None,
+        "duration": args.duration,
+        "corpus": args.corpus or args.config,
+        "client_dropped": dropped,
+        **recorder.summary(elapsed),
+    }
+    print(json.dumps(result, indent=2))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            json.dump(result, output_file, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay a request corpus against the Unreal MCP HTTP server")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--mode", choices=("closed", "open"), default="closed")
+    parser.add_argument("--concurrency", type=int, default=1, help="In-flight requests (closed loop)")
+    parser.add_argument("--rate", type=float, default=10.0, help="Requests per second (open loop)")
+    parser.add_argument("--poisson", action="store_true", help="Exponential inter-arrival times (open loop)")
+    parser.add_argument("--max-in-flight", type=int, default=256, help="Client-side cap on outstanding requests (open loop)")
+    parser.add_argument("--duration", type=float, default=30.0, help="Seconds to run")
+    parser.add_argument("--warmup", type=int, default=5, help="Requests sent before measuring")
+    parser.add_argument("--config", default=DEFAULT_CONFIG, help="Route configuration JSON")
+    parser.add_argument("--routes", nargs="*", help="Only use these configured route names")
+    parser.add_argument("--corpus", help="JSONL corpus to replay instead of generating requests")
+    parser.add_argument("--loop-corpus", action="store_true", help="Restart the corpus when it runs out")
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--timeout", type=float, default=60.0)
+    parser.add_argument("--output", help="Write the result JSON to this file")
+    args = parser.parse_args()
+
+    if args.concurrency < 1 or args.rate <= 0:
+        parser.error("--concurrency must be at least 1 and --rate must be positive")
+    asyncio.run(run(args))
+
+
+if __name__ == "__main__":
+    main()
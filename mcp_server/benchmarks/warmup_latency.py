@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+첫 요청(cold) 대비 이후 요청(warm)의 /add_node 지연 시간 측정 벤치마크
+
+사용법:
+    1. 언리얼 에디터를 새로 실행하고 MCP 서버를 시작합니다.
+    2. python mcp_server/benchmarks/warmup_latency.py --requests 20
+
+설정의 "Warm Up On Start" 를 켠 경우와 끈 경우를 각각 측정하면
+워밍업 단계가 첫 요청 지연을 얼마나 줄이는지 비교할 수 있습니다.
+"""
+
+import argparse
+import asyncio
+import json
+import statistics
+import time
+import uuid
+
+import aiohttp
+
+
+async def wait_until_ready(session, base_url, timeout):
+    """서버가 /status 에서 ready 를 보고할 때까지 대기하고 걸린 시간을 반환"""
+    start = time.perf_counter()
+    while time.perf_counter() - start < timeout:
+        try:
+            async with session.get(f"{base_url}/status") as response:
+                status = await response.json()
+                if status.get("ready", True):
+                    return time.perf_counter() - start, status
+        except aiohttp.ClientError:
+            pass
+        await asyncio.sleep(0.05)
+    raise TimeoutError("Server did not become ready in time")
+
+
+async def run(args):
+    base_url = f"http://{args.host}:{args.port}"
+    run_id = uuid.uuid4().hex[:8]
+    latencies_ms = []
+
+    async with aiohttp.ClientSession(timeout=aiohttp.ClientTimeout(total=args.timeout)) as session:
+        ready_seconds, _ = await wait_until_ready(session, base_url, args.timeout)
+
+        # 요청을 순차적으로 보내 각 요청의 순수 처리 시간을 측정
+        for index in range(args.requests):
+            payload = {
+                "blueprint_path": f"{args.path_prefix}_{run_id}_{index}",
+                "node_type": "PrintString",
+            }
+            start = time.perf_counter()
+            async with session.post(f"{base_url}/add_node", json=payload) as response:
+                await response.read()
+            latencies_ms.append((time.perf_counter() - start) * 1000.0)
+
+        async with session.get(f"{base_url}/status") as response:
+            final_status = await response.json()
+
+    warm = latencies_ms[1:] or latencies_ms
+    result = {
+        "run_id": run_id,
+        "requests": len(latencies_ms),
+        "time_to_ready_ms": ready_seconds * 1000.0,
+        "cold_ms": latencies_ms[0],
+        "warm_median_ms": statistics.median(warm),
+        "warm_max_ms": max(warm),
+        "cold_to_warm_ratio": latencies_ms[0] / statistics.median(warm),
+        "server_warmup": final_status.get("warmup"),
+        "server_latency": final_status.get("latency"),
+    }
+    print(json.dumps(result, indent=2))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            json.dump(result, output_file, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure cold vs warm /add_node latency")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--requests", type=int, default=20)
+    parser.add_argument("--path-prefix", default="/Game/MCPBench/WarmUp")
+    parser.add_argument("--timeout", type=float, default=120.0)
+    parser.add_argument("--output", help="Write the result JSON to this file")
+    asyncio.run(run(parser.parse_args()))
+
+
+if __name__ == "__main__":
+    main()
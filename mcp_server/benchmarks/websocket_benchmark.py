@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+작은 요청의 HTTP 대비 WebSocket 왕복 시간 비교 벤치마크
+
+사용법:
+    python mcp_server/benchmarks/websocket_benchmark.py --requests 200
+    python mcp_server/benchmarks/websocket_benchmark.py --requests 200 --burst 32 --output ws.json
+
+실행 중인 에디터에 /status 와 경로 하나짜리 /assets/query 를 HTTP(keep-alive 세션)와
+WebSocket(지속 연결 하나)으로 번갈아 보내 왕복 시간의 중앙값과 p90을 비교합니다.
+--burst 를 주면 요청 N개를 한꺼번에 보내 모두 끝날 때까지의 시간도 측정합니다. WebSocket은 한 연결에서
+id로 응답을 구분하므로 순서와 상관없이 완료되고, HTTP는 aiohttp 연결 풀이 허용하는 만큼 연결을 엽니다.
+두 라우트 모두 읽기 전용이므로 프로젝트에 애셋이 생기지 않습니다.
+"""
+
+import argparse
+import asyncio
+import json
+import statistics
+import struct
+import time
+import uuid
+
+import aiohttp
+
+
+def encode_message(envelope):
+    """4바이트 리틀 엔디언 길이 뒤에 JSON 본문"""
+    data = json.dumps(envelope).encode("utf-8")
+    return struct.pack("<I", len(data)) + data
+
+
+def decode_message(message):
+    return json.loads(message[4:])
+
+
+class WebSocketClient:
+    """요청 id로 응답을 찾아 주는 최소 클라이언트"""
+
+    def __init__(self, ws):
+        self.ws = ws
+        self.pending = {}
+        self.reader = asyncio.create_task(self.read_loop())
+
+    async def read_loop(self):
+        async for message in self.ws:
+            if message.type != aiohttp.WSMsgType.BINARY:
+                continue
+            envelope = decode_message(message.data)
+            future = self.pending.pop(envelope.get("id"), None)
+            if future is not None:
+                future.set_result(envelope)
+
+    async def request(self, route, body):
+        request_id = uuid.uuid4().hex
+        future = asyncio.get_running_loop().create_future()
+        self.pending[request_id] = future
+        await self.ws.send_bytes(encode_message({"id": request_id, "route": route, "body": body}))
+        envelope = await future
+        if envelope["status"] != 200:
+            raise RuntimeError(f"websocket {route}: status {envelope['status']}")
+        return envelope["body"]
+
+
+async def http_request(session, base_url, route, body):
+    if route == "/status":
+        request = session.get(f"{base_url}{route}")
+    else:
+        request = session.post(f"{base_url}{route}", json=body)
+    async with request as response:
+        result = await response.json()
+        if response.status != 200:
+            raise RuntimeError(f"http {route}: HTTP {response.status}")
+        return result
+
+
+def summarize(samples):
+    ordered = sorted(samples)
+    return {
+        "requests": len(samples),
+        "median_ms": statistics.median(samples),
+        "p90_ms": ordered[int(0.9 * (len(ordered) - 1))],
+        "min_ms": ordered[0],
+    }
+
+
+async def measure(args):
+    base_url = f"http://{args.host}:{args.port}"
+    ws_url = f"ws://{args.host}:{args.ws_port}"
+    routes = {
+        "status": ("/status", {}),
+        "assets_query": ("/assets/query", {"paths": [f"{args.path_prefix}/BP_Query_0"]}),
+    }
+
+    result = {}
+    async with aiohttp.ClientSession(timeout=aiohttp.ClientTimeout(total=args.timeout)) as session:
+        async with session.ws_connect(ws_url, max_msg_size=0) as ws:
+            client = WebSocketClient(ws)
+            transports = {
+                "http": lambda route, body: http_request(session, base_url, route, body),
+                "websocket": client.request,
+            }
+
+            for name, (route, body) in routes.items():
+                # 연결을 미리 열어 두어 첫 요청의 핸드셰이크가 측정에 섞이지 않게 함
+                for send in transports.values():
+                    await send(route, body)
+
+                latencies_ms = {transport: [] for transport in transports}
+                for _ in range(args.requests):
+                    # 번갈아 보내 에디터 상태 변화가 한쪽에만 몰리지 않게 함
+                    for transport, send in transports.items():
+                        start = time.perf_counter()
+                        await send(route, body)
+                        latencies_ms[transport].append((time.perf_counter() - start) * 1000.0)
+
+                result[name] = {transport: summarize(samples) for transport, samples in latencies_ms.items()}
+
+                if args.burst > 0:
+                    for transport, send in transports.items():
+                        start = time.perf_counter()
+                        await asyncio.gather(*(send(route, body) for _ in range(args.burst)))
+                        result[name][transport]["burst_ms"] = (time.perf_counter() - start) * 1000.0
+
+            client.reader.cancel()
+
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare HTTP and WebSocket round trips for small requests")
+    parser.add_argument("--requests", type=int, default=200, help="Round trips per transport and route")
+    parser.add_argument("--burst", type=int, default=0, help="Also time this many concurrent requests per transport")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--ws-port", type=int, default=8082)
+    parser.add_argument("--path-prefix", default="/Game/MCPBench/WebSocket")
+    parser.add_argument("--timeout", type=float, default=60.0)
+    parser.add_argument("--output", help="Write the result JSON to this file")
+    args = parser.parse_args()
+
+    result = {"requests": args.requests, "burst": args.burst, "round_trip": asyncio.run(measure(args))}
+    print(json.dumps(result, indent=2))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            json.dump(result, output_file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -9,15 +9,312 @@ Claude Code와 언리얼 엔진 플러그인 간의 MCP 브릿지 역할 수행
 """
 
 import asyncio
+import gzip
+import json
+import random
+import struct
+import time
+import uuid
+
 import aiohttp
 from fastmcp import FastMCP
 
+try:
+    # 선택 의존성: 설치되어 있으면 요청/응답 본문을 MessagePack으로 주고받음
+    import msgpack
+except ImportError:
+    msgpack = None
+
 # ✅ 확인됨: FastMCP 클래스 인스턴스 생성 (server.py:129)
 mcp = FastMCP(name="unreal_mcp")
 
 
+# ✅ 확인됨: spec.md에 따라 언리얼 플러그인은 포트 8080에서 HTTP 서버 운영
+UNREAL_BASE_URL = "http://localhost:8080"
+
+# 요청 하나에 허용하는 전체 시간(재시도 포함)
+REQUEST_TIMEOUT_SECONDS = 10.0
+
+# 429 재시도 횟수 상한
+MAX_BUSY_RETRIES = 5
+
+# 시간 초과 후 작업 취소 요청에 허용하는 시간
+CANCEL_TIMEOUT_SECONDS = 1.0
+
+# 플러그인이 Content-Type/Accept로 협상하는 바이너리 본문 형식
+MSGPACK_CONTENT_TYPE = "application/msgpack"
+
+# /events 구독자 ID. 브리지 프로세스마다 하나를 써서 플러그인이 구독자별 버퍼를 유지하게 함
+EVENT_SUBSCRIBER_ID = f"bridge-{uuid.uuid4().hex[:12]}"
+
+# /events 한 번의 롱 폴링에서 이벤트를 기다리는 최대 시간 (플러그인 상한 60초)
+MAX_EVENT_WAIT_SECONDS = 60.0
+
+# 이 크기 이상인 요청 본문은 gzip으로 압축해 Content-Encoding: gzip 으로 보냄
+# 응답은 aiohttp가 Accept-Encoding: gzip, deflate 를 보내고 압축을 자동으로 풀어 줌
+REQUEST_GZIP_THRESHOLD_BYTES = 8192
+
+# 플러그인의 WebSocket 엔드포인트 (설정 WebSocket Port, 기본 0이면 꺼져 있으므로 8082로 켜야 사용)
+# 연결되면 요청을 지속 연결 하나로 다중화해 보내고, 연결할 수 없으면 HTTP로 보냄
+UNREAL_WS_URL = "ws://localhost:8082"
+
+# WebSocket 연결 시도에 허용하는 시간과, 실패한 뒤 다시 시도하기까지 HTTP만 쓰는 시간
+WS_CONNECT_TIMEOUT_SECONDS = 1.0
+WS_RETRY_SECONDS = 30.0
+
+
+def encode_request_body(payload: dict) -> tuple:
+    """
+    session.post()에 넘길 (본문 바이트, 헤더)를 만듭니다. msgpack이 있으면 MessagePack, 없으면 JSON.
+    큰 본문(대량 경로 목록 등)은 gzip으로 압축합니다.
+    """
+    if msgpack is None:
+        data = json.dumps(payload).encode("utf-8")
+        headers = {"Content-Type": "application/json"}
+    else:
+        data = msgpack.packb(payload, use_bin_type=True)
+        headers = {"Content-Type": MSGPACK_CONTENT_TYPE, "Accept": MSGPACK_CONTENT_TYPE}
+
+    if len(data) >= REQUEST_GZIP_THRESHOLD_BYTES:
+        data = gzip.compress(data, compresslevel=6, mtime=0)
+        headers["Content-Encoding"] = "gzip"
+    return data, headers
+
+
+async def read_response_body(response: aiohttp.ClientResponse):
+    """응답 본문을 (dict, 텍스트)로 읽습니다. MessagePack 응답은 오류 메시지용 JSON 텍스트로도 바꿉니다."""
+    if response.content_type == MSGPACK_CONTENT_TYPE and msgpack is not None:
+        result = msgpack.unpackb(await response.read(), raw=False)
+        return result, json.dumps(result, ensure_ascii=False)
+
+    text = await response.text()
+    try:
+        return json.loads(text), text
+    except ValueError:
+        return None, text
+
+
+def encode_ws_message(envelope: dict) -> bytes:
+    """WebSocket 메시지 하나를 만듭니다. 4바이트 리틀 엔디언 길이 뒤에 MessagePack(있으면) 또는 JSON 본문."""
+    if msgpack is None:
+        data = json.dumps(envelope).encode("utf-8")
+    else:
+        data = msgpack.packb(envelope, use_bin_type=True)
+    return struct.pack("<I", len(data)) + data
+
+
+def decode_ws_message(message: bytes):
+    """길이 접두사를 떼고 JSON 또는 MessagePack 메시지를 dict로 읽습니다. 읽을 수 없으면 None."""
+    if len(message) < 4 or struct.unpack_from("<I", message)[0] != len(message) - 4:
+        return None
+    data = message[4:]
+    try:
+        if data.lstrip()[:1] == b"{":
+            return json.loads(data)
+        return msgpack.unpackb(data, raw=False) if msgpack is not None else None
+    except ValueError:
+        return None
+
+
+class UnrealWebSocket:
+    """
+    플러그인 WebSocket 엔드포인트와의 지속 연결 하나를 여러 요청이 함께 씁니다.
+
+    요청마다 고유한 id를 붙여 보내고, 응답은 도착하는 순서대로 같은 id를 기다리는 요청에 전달합니다.
+    그래서 큐에서 기다리는 생성 작업이 뒤에 보낸 읽기 요청의 응답을 막지 않습니다.
+    id가 없는 메시지는 플러그인이 보내는 이벤트 푸시(/subscribe)이며, 브리지는 구독하지 않으므로 무시합니다.
+    연결할 수 없거나 연결이 끊기면 None을 반환해 호출자가 HTTP로 보내게 합니다.
+    """
+
+    def __init__(self, url: str):
+        self.url = url
+        self._session = None
+        self._ws = None
+        self._pending = {}
+        self._connect_lock = asyncio.Lock()
+        self._retry_at = 0.0
+
+    async def _connect(self):
+        if self._ws is not None and not self._ws.closed:
+            return self._ws
+        if time.monotonic() < self._retry_at:
+            return None
+
+        async with self._connect_lock:
+            if self._ws is not None and not self._ws.closed:
+                return self._ws
+            try:
+                if self._session is None or self._session.closed:
+                    self._session = aiohttp.ClientSession()
+                self._ws = await asyncio.wait_for(
+                    self._session.ws_connect(self.url, max_msg_size=0, autoping=True),
+                    WS_CONNECT_TIMEOUT_SECONDS
+                )
+            except (aiohttp.ClientError, asyncio.TimeoutError, OSError):
+                # 플러그인이 WebSocket을 끈 경우 매 요청마다 연결을 시도하지 않도록 잠시 HTTP만 사용
+                self._ws = None
+                self._retry_at = time.monotonic() + WS_RETRY_SECONDS
+                return None
+
+            asyncio.create_task(self._read_loop(self._ws))
+            return self._ws
+
+    async def _read_loop(self, ws):
+        try:
+            async for message in ws:
+                if message.type == aiohttp.WSMsgType.BINARY:
+                    envelope = decode_ws_message(message.data)
+                elif message.type == aiohttp.WSMsgType.TEXT:
+                    envelope = decode_ws_message(message.data.encode("utf-8"))
+                else:
+                    continue
+
+                future = self._pending.get(envelope.get("id")) if isinstance(envelope, dict) else None
+                if future is not None and not future.done():
+                    future.set_result(envelope)
+        finally:
+            for future in self._pending.values():
+                if not future.done():
+                    future.set_exception(ConnectionError("WebSocket connection closed"))
+
+    async def request(self, envelope: dict, timeout: float):
+        """
+        envelope(id, route, body, deadline_ms, idempotency_key)를 보내고 응답 envelope을 기다립니다.
+        연결할 수 없거나 응답 전에 연결이 끊기면 None. 시간 초과는 asyncio.TimeoutError로 전달합니다.
+        """
+        ws = await self._connect()
+        if ws is None:
+            return None
+
+        future = asyncio.get_running_loop().create_future()
+        self._pending[envelope["id"]] = future
+        try:
+            await ws.send_bytes(encode_ws_message(envelope))
+            return await asyncio.wait_for(future, timeout)
+        except (ConnectionError, aiohttp.ClientError):
+            return None
+        finally:
+            self._pending.pop(envelope["id"], None)
+
+
+unreal_socket = UnrealWebSocket(UNREAL_WS_URL)
+
+
+async def send_over_websocket(route: str, payload: dict, request_id: str, idempotency_key: str, remaining: float):
+    """
+    WebSocket으로 요청을 보내고 (상태 코드, dict, 오류 텍스트, Retry-After)를 반환합니다.
+    WebSocket을 쓸 수 없으면 None.
+    """
+    envelope = await unreal_socket.request({
+        "id": request_id,
+        "route": route,
+        "body": payload,
+        "deadline_ms": int(remaining * 1000),
+        "idempotency_key": idempotency_key,
+    }, remaining)
+    if envelope is None:
+        return None
+
+    result = envelope.get("body")
+    error_text = envelope.get("text") if result is None else json.dumps(result, ensure_ascii=False)
+    return envelope.get("status", 0), result, error_text or "", envelope.get("headers", {}).get("retry-after")
+
+
+async def send_over_http(session: aiohttp.ClientSession, route: str, body: bytes, headers: dict, remaining: float):
+    """HTTP POST로 요청을 보내고 (상태 코드, dict, 오류 텍스트, Retry-After)를 반환합니다."""
+    async with session.post(
+        f"{UNREAL_BASE_URL}{route}",
+        headers=headers,
+        timeout=aiohttp.ClientTimeout(total=remaining),
+        data=body
+    ) as response:
+        result, error_text = await read_response_body(response)
+        return response.status, result, error_text, response.headers.get("Retry-After")
+
+
+async def post_to_unreal(route: str, payload: dict, timeout: float = REQUEST_TIMEOUT_SECONDS, idempotency_key: str = None):
+    """
+    언리얼 플러그인에 POST 요청을 보내고 (상태 코드, JSON 결과, 오류 본문)을 반환합니다.
+
+    플러그인의 작업 큐가 가득 차면 429 Too Many Requests와 Retry-After를 돌려주므로,
+    남은 시간 안에서 Retry-After에 지터(jitter)를 더한 만큼 기다린 뒤 재시도합니다.
+    여러 클라이언트가 같은 시점에 몰려 다시 요청하지 않도록 대기 시간을 무작위로 분산합니다.
+
+    매 요청에 남은 시간(X-MCP-Deadline-Ms)과 요청 ID(X-MCP-Request-Id)를 함께 보내므로,
+    플러그인은 기한이 지난 작업을 컴파일·저장 전에 버립니다. 시간 초과로 포기하면
+    /jobs/{요청 ID}/cancel 로 아직 대기 중인 작업을 취소합니다.
+
+    Idempotency-Key는 도구 호출마다 새로 만들고 그 호출의 재시도와 HTTP 대체 전송에만 다시 쓰므로,
+    재시도는 이미 끝난 결과를 다시 받거나 실행 중인 요청의 결과를 기다리고,
+    같은 인자로 일부러 다시 호출한 요청은 새 작업으로 실행됩니다.
+
+    msgpack 패키지가 설치되어 있으면 본문을 MessagePack(application/msgpack)으로 보내고 받아
+    대량 경로 목록 같은 큰 본문의 인코딩·디코딩 비용을 줄입니다. 반환값은 두 형식 모두 같은 dict입니다.
+    REQUEST_GZIP_THRESHOLD_BYTES 이상인 본문은 gzip으로 압축해 보내고, 큰 응답은 플러그인이 압축해 보냅니다.
+
+    플러그인의 WebSocket 엔드포인트(UNREAL_WS_URL)에 연결할 수 있으면 지속 연결로 보내 요청마다
+    TCP 연결과 HTTP 헤더를 만드는 비용을 줄이고, 연결할 수 없거나 끊기면 같은 Idempotency-Key로 HTTP에 다시 보냅니다.
+    """
+    deadline = time.monotonic() + timeout
+    request_id = uuid.uuid4().hex
+    idempotency_key = idempotency_key or uuid.uuid4().hex
+    body, body_headers = encode_request_body(payload)
+
+    # ✅ 확인됨: aiohttp는 비동기 HTTP 클라이언트 라이브러리
+    async with aiohttp.ClientSession() as session:
+        for attempt in range(MAX_BUSY_RETRIES + 1):
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                raise asyncio.TimeoutError()
+
+            headers = {
+                "X-MCP-Deadline-Ms": str(int(remaining * 1000)),
+                "X-MCP-Request-Id": request_id,
+                "Idempotency-Key": idempotency_key,
+                **body_headers,
+            }
+            try:
+                response = await send_over_websocket(route, payload, request_id, idempotency_key, remaining)
+                if response is None:
+                    response = await send_over_http(session, route, body, headers, remaining)
+            except asyncio.TimeoutError:
+                await cancel_unreal_job(session, request_id)
+                raise
+
+            status, result, error_text, retry_after_header = response
+            if status == 200:
+                return status, result, ""
+
+            if status != 429 or attempt == MAX_BUSY_RETRIES:
+                return status, None, error_text
+
+            try:
+                retry_after = float(retry_after_header or "1")
+            except ValueError:
+                retry_after = 1.0
+
+            # 지수 백오프와 Retry-After 중 큰 값을 기준으로 0.5~1.5배 지터 적용
+            delay = max(retry_after, 0.25 * (2 ** attempt)) * random.uniform(0.5, 1.5)
+            remaining = deadline - time.monotonic()
+            if delay >= remaining:
+                return 429, None, error_text
+            await asyncio.sleep(delay)
+
+
+async def cancel_unreal_job(session: aiohttp.ClientSession, request_id: str):
+    """대기 중인 작업 취소를 시도합니다. 이미 실행됐거나 연결할 수 없으면 무시합니다."""
+    try:
+        async with session.post(
+            f"{UNREAL_BASE_URL}/jobs/{request_id}/cancel",
+            timeout=aiohttp.ClientTimeout(total=CANCEL_TIMEOUT_SECONDS)
+        ):
+            pass
+    except (aiohttp.ClientError, asyncio.TimeoutError):
+        pass
+
+
 @mcp.tool
-async def add_blueprint_node(blueprint_path: str, node_type: str = "PrintString") -> dict:
+async def add_blueprint_node(blueprint_path: str, node_type: str = "PrintString", dry_run: bool = False) -> dict:
     """
     언리얼 엔진 블루프린트에 노드를 추가합니다.
 
@@ -28,38 +325,211 @@ async def add_blueprint_node(blueprint_path: str, node_type: str = "PrintString"
     Args:
         blueprint_path (str): 블루프린트 애셋 경로 (예: "/Game/MyBP")
         node_type (str): 추가할 노드 타입 (기본값: "PrintString")
+        dry_run (bool): 저장하지 않고 빌드·컴파일 결과만 확인 (기본값: False).
+            응답의 dry_run_id를 commit_blueprint에 넘기면 다시 빌드하지 않고 저장합니다.
 
     Returns:
         dict: 노드 추가 결과
     """
     try:
         # 언리얼 플러그인 HTTP 서버에 요청 전송
-        # ✅ 확인됨: aiohttp는 비동기 HTTP 클라이언트 라이브러리
-        async with aiohttp.ClientSession() as session:
-            payload = {
-                "blueprint_path": blueprint_path,
-                "node_type": node_type
+        payload = {
+            "blueprint_path": blueprint_path,
+            "node_type": node_type
+        }
+        if dry_run:
+            payload["dry_run"] = True
+
+        status, result, error_text = await post_to_unreal("/add_node", payload)
+        if status == 200 and dry_run:
+            return {
+                "success": result.get("success", False),
+                "message": f"Dry run for '{blueprint_path}': {result.get('message', '')}",
+                "data": result
+            }
+        elif status == 200 and not result.get("success", True):
+            # 컴파일 실패: 진단(노드 GUID, 핀, 메시지)을 그대로 돌려주어 한 번에 고칠 수 있게 함
+            return {
+                "success": False,
+                "error": result.get("message", "Blueprint failed to compile."),
+                "diagnostics": result.get("compile", {}).get("diagnostics", []),
+                "data": result
+            }
+        elif status == 200:
+            return {
+                "success": True,
+                "message": f"Node '{node_type}' added to '{blueprint_path}' successfully.",
+                "data": result
+            }
+        else:
+            return {
+                "success": False,
+                "error": f"HTTP {status}: {error_text}"
+            }
+
+    except aiohttp.ClientConnectorError:
+        return {
+            "success": False,
+            "error": "Cannot connect to Unreal plugin. Make sure Unreal Editor is running with the plugin enabled."
+        }
+    except asyncio.TimeoutError:
+        return {
+            "success": False,
+            "error": "Request timeout. Unreal plugin may be busy or unresponsive."
+        }
+    except Exception as e:
+        return {
+            "success": False,
+            "error": f"Unexpected error: {str(e)}"
+        }
+
+
+
+@mcp.tool
+async def commit_blueprint(dry_run_id: str) -> dict:
+    """
+    add_blueprint_node(dry_run=True)로 빌드해 둔 블루프린트를 원래 경로에 저장합니다.
+
+    Args:
+        dry_run_id (str): 드라이런 응답의 dry_run_id
+
+    Returns:
+        dict: 저장 결과 (만료되었거나 이미 커밋된 id면 실패)
+    """
+    try:
+        status, result, error_text = await post_to_unreal("/commit", {"dry_run_id": dry_run_id})
+        if status == 200:
+            return {
+                "success": True,
+                "message": result.get("message", f"Dry run '{dry_run_id}' committed."),
+                "data": result
+            }
+        else:
+            return {
+                "success": False,
+                "error": f"HTTP {status}: {error_text}"
+            }
+
+    except aiohttp.ClientConnectorError:
+        return {
+            "success": False,
+            "error": "Cannot connect to Unreal plugin. Make sure Unreal Editor is running with the plugin enabled."
+        }
+    except asyncio.TimeoutError:
+        return {
+            "success": False,
+            "error": "Request timeout. Unreal plugin may be busy or unresponsive."
+        }
+    except Exception as e:
+        return {
+            "success": False,
+            "error": f"Unexpected error: {str(e)}"
+        }
+
+
+@mcp.tool
+async def query_assets(paths: list[str] = None, path_prefix: str = None, recursive: bool = True) -> dict:
+    """
+    여러 애셋의 존재 여부, 클래스, 저장 상태를 한 번에 조회합니다.
+
+    플러그인이 에셋 레지스트리에서 바로 답하므로 패키지를 로드하지 않고, 생성 작업 큐에서 기다리지도 않습니다.
+    애셋을 만들기 전에 이미 있는지 확인할 때 경로마다 요청하지 말고 이 도구로 한 번에 조회합니다.
+
+    Args:
+        paths (list[str]): 조회할 패키지 경로 목록 (예: ["/Game/BP_001", "/Game/BP_002"], 최대 10000개)
+        path_prefix (str): 폴더 경로 또는 패키지 이름 접두사 (지정하면 paths는 무시)
+        recursive (bool): path_prefix 조회 시 하위 폴더 포함 여부 (기본값: True)
+
+    Returns:
+        dict: 경로별 exists / class / state(missing, unsaved, dirty, saved) 목록
+    """
+    if path_prefix:
+        payload = {"path_prefix": path_prefix, "recursive": recursive}
+    elif paths:
+        payload = {"paths": paths}
+    else:
+        return {
+            "success": False,
+            "error": "Provide 'paths' or 'path_prefix'."
+        }
+
+    try:
+        status, result, error_text = await post_to_unreal("/assets/query", payload)
+        if status == 200:
+            return {
+                "success": True,
+                "message": f"{result['found']} of {result['count']} asset(s) found.",
+                "data": result
+            }
+        else:
+            return {
+                "success": False,
+                "error": f"HTTP {status}: {error_text}"
             }
 
-            # ✅ 확인됨: spec.md에 따라 언리얼 플러그인은 포트 8080에서 HTTP 서버 운영
-            async with session.post(
-                "http://localhost:8080/add_node",
-                json=payload,
-                timeout=aiohttp.ClientTimeout(total=10)
+    except aiohttp.ClientConnectorError:
+        return {
+            "success": False,
+            "error": "Cannot connect to Unreal plugin. Make sure Unreal Editor is running with the plugin enabled."
+        }
+    except asyncio.TimeoutError:
+        return {
+            "success": False,
+            "error": "Request timeout. Unreal plugin may be busy or unresponsive."
+        }
+    except Exception as e:
+        return {
+            "success": False,
+            "error": f"Unexpected error: {str(e)}"
+        }
+
+
+@mcp.tool
+async def watch_events(topics: str = "job,compile", wait_seconds: float = 20.0, last_event_id: int = 0) -> dict:
+    """
+    플러그인의 작업 상태 변화, 컴파일 결과, 요청 로그 이벤트를 기다렸다가 받아 옵니다.
+
+    /events 롱 폴링을 사용하므로 /jobs 를 반복해서 조회하지 않아도 됩니다. 새 이벤트가 있으면 바로,
+    없으면 wait_seconds 동안 기다린 뒤 빈 목록을 반환합니다. 반환된 last_event_id 를 다음 호출에 넘기면
+    이어서 받고, 같은 값을 다시 넘기면 응답을 놓쳤을 때 이벤트를 다시 받습니다.
+    읽는 속도가 느려 플러그인 버퍼가 넘치면 오래된 이벤트부터 버려지고 dropped 에 개수가 표시됩니다.
+
+    Args:
+        topics (str): 쉼표로 구분한 토픽 (job, compile, log; 기본값: "job,compile")
+        wait_seconds (float): 이벤트가 없을 때 기다릴 시간(초, 0~60, 기본값: 20)
+        last_event_id (int): 마지막으로 받은 이벤트 ID (처음이면 0)
+
+    Returns:
+        dict: events(id, type, data), last_event_id, dropped
+    """
+    wait_seconds = max(0.0, min(wait_seconds, MAX_EVENT_WAIT_SECONDS))
+    params = {
+        "subscriber": EVENT_SUBSCRIBER_ID,
+        "topics": topics,
+        "timeout": str(wait_seconds),
+        "format": "json",
+    }
+    if last_event_id > 0:
+        params["last_event_id"] = str(last_event_id)
+
+    try:
+        async with aiohttp.ClientSession() as session:
+            async with session.get(
+                f"{UNREAL_BASE_URL}/events",
+                params=params,
+                timeout=aiohttp.ClientTimeout(total=wait_seconds + REQUEST_TIMEOUT_SECONDS),
             ) as response:
+                result, error_text = await read_response_body(response)
                 if response.status == 200:
-                    result = await response.json()
                     return {
                         "success": True,
-                        "message": f"Node '{node_type}' added to '{blueprint_path}' successfully.",
+                        "message": f"{len(result['events'])} event(s), {result['dropped']} dropped.",
                         "data": result
                     }
-                else:
-                    error_text = await response.text()
-                    return {
-                        "success": False,
-                        "error": f"HTTP {response.status}: {error_text}"
-                    }
+                return {
+                    "success": False,
+                    "error": f"HTTP {response.status}: {error_text}"
+                }
 
     except aiohttp.ClientConnectorError:
         return {
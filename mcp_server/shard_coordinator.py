@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""
+여러 헤드리스 언리얼 에디터 워커로 대량 작업 매니페스트를 분산 실행하는 코디네이터
+
+하나의 에디터 프로세스는 게임 스레드 하나에 묶이므로, 대량 애셋 생성은
+매니페스트를 패키지 경로 기준으로 나눠 N개의 `-run=UnrealMCP` 커맨드릿 워커에서
+동시에 실행합니다. 같은 패키지는 항상 같은 샤드로 가므로 두 워커가 같은 애셋을
+건드리지 않습니다.
+
+사용법:
+    python mcp_server/shard_coordinator.py \
+        --editor "/opt/UnrealEngine/Engine/Binaries/Linux/UnrealEditor-Cmd" \
+        --project /path/to/Project.uproject \
+        --manifest Ops.jsonl --workers 8 --output Merged.json
+
+샤드 전달 방식:
+    커맨드릿은 매니페스트를 파일 핸들로 읽으므로(크기를 알아야 스트리밍 가능)
+    파이프 대신 작업 디렉터리의 샤드 파일로 전달하고, 결과는 각 워커의
+    `-report` JSON을 모아 합칩니다.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import zlib
+from collections import defaultdict
+
+
+def package_of(asset_path):
+    """애셋 경로("/Game/BP" 또는 "/Game/BP.BP")에서 패키지 이름을 반환"""
+    return asset_path.split(".", 1)[0]
+
+
+def shard_of(asset_path, shard_count):
+    """패키지 이름의 안정적인 해시로 샤드 번호를 결정 (실행마다 같은 결과)"""
+    return zlib.crc32(package_of(asset_path).encode("utf-8")) % shard_count
+
+
+class UnshardableOperation(ValueError):
+    """샤드로 나눠 실행할 수 없는 매니페스트 줄"""
+
+
+def split_operation(route, body, shard_count):
+    """
+    작업 하나를 샤드별 작업으로 분할
+
+    Returns:
+        list[tuple[int, dict]]: (샤드 번호, 매니페스트 줄) 목록
+
+    Raises:
+        UnshardableOperation: /commit 처럼 다른 워커의 상태에 의존하는 작업
+    """
+    if route == "/commit":
+        # dry_run_id는 드라이런을 만든 에디터 프로세스 안에서만 유효하고("dry0", "dry1", ... 프로세스별 순번),
+        # 샤드로 나누면 그 드라이런이 어느 워커에서 몇 번째로 실행될지 알 수 없음
+        raise UnshardableOperation(
+            f"/commit {body.get('dry_run_id', '')!r} cannot be sharded: a dry_run_id only exists in the worker that "
+            "built it; run dry runs and their commits with a single -run=UnrealMCP worker, or use /add_node without dry_run"
+        )
+
+    if route == "/stamp":
+        paths = body.get("paths")
+        if paths is None and "path_prefix" in body:
+            # <prefix><index> 범위도 명시적 경로로 펼쳐 다른 작업과 같은 규칙으로 분배
+            count = int(body.get("count", 1))
+            start_index = int(body.get("start_index", 0))
+            paths = [f"{body['path_prefix']}{start_index + index}" for index in range(count)]
+
+        if paths is not None:
+            # 샤드마다 /stamp 하나로 묶어 워커 쪽 배치 효율을 유지
+            groups = defaultdict(list)
+            for path in paths:
+                groups[shard_of(path, shard_count)].append(path)
+            shard_body = {key: value for key, value in body.items() if key not in ("path_prefix", "count", "start_index")}
+            return [
+                (shard, {"route": route, "body": dict(shard_body, paths=group)})
+                for shard, group in sorted(groups.items())
+            ]
+
+        return [(0, {"route": route, "body": body})]
+
+    return [(shard_of(body.get("blueprint_path", ""), shard_count), {"route": route, "body": body})]
+
+
+def write_shards(manifest_path, shard_count, work_dir):
+    """매니페스트를 스트리밍으로 읽어 샤드 파일에 분배하고 (샤드 경로 목록, 샤드별 줄 수)를 반환"""
+    shard_paths = [os.path.join(work_dir, f"shard_{index}.jsonl") for index in range(shard_count)]
+    shard_files = [open(path, "w", encoding="utf-8") for path in shard_paths]
+    line_counts = [0] * shard_count
+    skipped = 0
+    rejected = 0
+
+    try:
+        with open(manifest_path, "r", encoding="utf-8") as manifest:
+            for line in manifest:
+                line = line.strip()
+                if not line or line.startswith("#"):
+                    continue
+
+                # 커맨드릿과 같은 규칙: {"route", "body"} 또는 /add_node 본문 그대로
+                # 객체가 아닌 줄, 문자열 본문이 JSON 객체가 아닌 줄, 필드 타입이 맞지 않는 줄은 건너뜀
+                try:
+                    entry = json.loads(line)
+                    if not isinstance(entry, dict):
+                        raise ValueError("manifest line is not an object")
+                    route = entry.get("route", "/add_node")
+                    body = entry.get("body", entry)
+                    if isinstance(body, str):
+                        body = json.loads(body)
+                    if not isinstance(route, str) or not isinstance(body, dict):
+                        raise ValueError("route must be a string and body an object")
+                    shard_entries = split_operation(route, body, shard_count)
+                except UnshardableOperation as error:
+                    rejected += 1
+                    print(f"Rejected manifest line: {error}", file=sys.stderr)
+                    continue
+                except (ValueError, TypeError, AttributeError, KeyError):
+                    skipped += 1
+                    continue
+
+                for shard, shard_entry in shard_entries:
+                    shard_files[shard].write(json.dumps(shard_entry, separators=(",", ":")) + "\n")
+                    line_counts[shard] += 1
+    finally:
+        for shard_file in shard_files:
+            shard_file.close()
+
+    if skipped:
+        print(f"Skipped {skipped} malformed manifest line(s)", file=sys.stderr)
+    if rejected:
+        print(f"Rejected {rejected} manifest line(s) that cannot be sharded", file=sys.stderr)
+    return shard_paths, line_counts, skipped, rejected
+
+
+def launch_worker(args, index, shard_path, work_dir):
+    """샤드 하나를 실행하는 헤드리스 커맨드릿 워커 시작"""
+    report_path = os.path.join(work_dir, f"report_{index}.json")
+    log_path = os.path.join(work_dir, f"worker_{index}.log")
+    command = [
+        args.editor,
+        args.project,
+        "-run=UnrealMCP",
+        f"-manifest={shard_path}",
+        f"-report={report_path}",
+        f"-savebatch={args.save_batch}",
+        # 워커끼리 로그 파일이 겹치지 않도록 분리
+        f"-abslog={log_path}",
+        "-nullrhi",
+        "-unattended",
+        "-nosplash",
+        "-nopause",
+        "-stdout",
+    ] + args.extra_args
+
+    stdout = open(os.path.join(work_dir, f"worker_{index}.out"), "w", encoding="utf-8")
+    process = subprocess.Popen(command, stdout=stdout, stderr=subprocess.STDOUT)
+    return process, stdout, report_path
+
+
+def merge_reports(reports, wall_seconds):
+    """워커 리포트를 하나로 합침"""
+    merged = {
+        "workers": len(reports),
+        "operations": 0,
+        "failed": 0,
+        "parse_errors": 0,
+        "packages_saved": 0,
+        "failed_saves": 0,
+        "unchanged": 0,
+        "wall_seconds": wall_seconds,
+        "routes": {},
+    }
+
+    for report in reports:
+        for key in ("operations", "failed", "parse_errors", "packages_saved", "failed_saves", "unchanged"):
+            merged[key] += report.get(key, 0)
+
+        for route, stats in report.get("routes", {}).items():
+            route_total = merged["routes"].setdefault(route, {"count": 0, "failed": 0, "total_ms": 0.0})
+            route_total["count"] += stats.get("count", 0)
+            route_total["failed"] += stats.get("failed", 0)
+            route_total["total_ms"] += stats.get("mean_ms", 0.0) * stats.get("count", 0)
+
+    for stats in merged["routes"].values():
+        stats["mean_ms"] = stats.pop("total_ms") / stats["count"] if stats["count"] else 0.0
+
+    merged["ops_per_second"] = merged["operations"] / wall_seconds if wall_seconds > 0 else 0.0
+
+    # 워커는 백분위만 보고하므로 정확한 병합은 불가: p50은 작업 수 가중 평균, 꼬리는 최악 워커 기준
+    weighted = [(r.get("operations", 0), r.get("latency", {})) for r in reports if r.get("operations")]
+    total_ops = sum(ops for ops, _ in weighted)
+    merged["latency"] = {
+        "p50_ms": sum(ops * lat.get("p50_ms", 0.0) for ops, lat in weighted) / total_ops if total_ops else 0.0,
+        "p90_ms_worst": max((lat.get("p90_ms", 0.0) for _, lat in weighted), default=0.0),
+        "p99_ms_worst": max((lat.get("p99_ms", 0.0) for _, lat in weighted), default=0.0),
+        "max_ms": max((lat.get("max_ms", 0.0) for _, lat in weighted), default=0.0),
+    }
+
+    # 가장 느린 워커 대비 합산 실행 시간으로 병렬 효율을 추정
+    busy_seconds = sum(r.get("total_seconds", 0.0) for r in reports)
+    merged["parallel_speedup"] = busy_seconds / wall_seconds if wall_seconds > 0 else 0.0
+    merged["per_worker"] = reports
+    return merged
+
+
+def run(args):
+    work_dir = args.work_dir or tempfile.mkdtemp(prefix="unreal_mcp_shards_")
+    os.makedirs(work_dir, exist_ok=True)
+
+    shard_paths, line_counts, skipped, rejected = write_shards(args.manifest, args.workers, work_dir)
+    print(f"Wrote {sum(line_counts)} operation(s) into {args.workers} shard(s) under {work_dir}: {line_counts}")
+
+    # 거부된 줄은 실행되지 않았으므로 나머지가 모두 성공해도 실패로 종료
+    if args.shard_only:
+        return 1 if rejected else 0
+
+    start = time.perf_counter()
+    workers = []
+    for index, shard_path in enumerate(shard_paths):
+        if line_counts[index] == 0:
+            continue
+        workers.append((index,) + launch_worker(args, index, shard_path, work_dir))
+
+    reports = []
+    exit_code = 0
+    for index, process, stdout, report_path in workers:
+        return_code = process.wait()
+        stdout.close()
+        wall = time.perf_counter() - start
+        print(f"Worker {index} exited with {return_code} after {wall:.1f} s")
+
+        if return_code != 0:
+            exit_code = 1
+        try:
+            with open(report_path, "r", encoding="utf-8") as report_file:
+                report = json.load(report_file)
+        except (OSError, json.JSONDecodeError):
+            print(f"Worker {index} produced no report; see {work_dir}/worker_{index}.log", file=sys.stderr)
+            exit_code = 1
+            continue
+        report["worker"] = index
+        report["exit_code"] = return_code
+        reports.append(report)
+
+    merged = merge_reports(reports, time.perf_counter() - start)
+    merged["skipped"] = skipped
+    merged["rejected"] = rejected
+    if rejected:
+        exit_code = 1
+    print(json.dumps({key: value for key, value in merged.items() if key != "per_worker"}, indent=2))
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output_file:
+            json.dump(merged, output_file, indent=2)
+
+    return exit_code
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run an MCP operation manifest across several headless editor workers")
+    parser.add_argument("--editor", help="Path to UnrealEditor-Cmd")
+    parser.add_argument("--project", help="Path to the .uproject file")
+    parser.add_argument("--manifest", required=True, help="JSONL manifest (same format as -run=UnrealMCP)")
+    parser.add_argument("--workers", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--save-batch", type=int, default=100)
+    parser.add_argument("--work-dir", help="Directory for shards, worker logs and reports (default: temp dir)")
+    parser.add_argument("--output", help="Write the merged report JSON to this file")
+    parser.add_argument("--shard-only", action="store_true", help="Only write shard files; do not launch workers")
+    parser.add_argument("extra_args", nargs="*", help="Extra arguments passed to every worker (after --)")
+    args = parser.parse_args()
+
+    if args.workers < 1:
+        parser.error("--workers must be at least 1")
+    if not args.shard_only and not (args.editor and args.project):
+        parser.error("--editor and --project are required unless --shard-only is set")
+
+    sys.exit(run(args))
+
+
+if __name__ == "__main__":
+    main()
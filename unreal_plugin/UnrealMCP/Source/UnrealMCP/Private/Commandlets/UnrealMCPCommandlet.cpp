@@ -0,0 +1,331 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/UnrealMCPCommandlet.h"
+#include "MCPOperationRunner.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+namespace
+{
+	/**
+	 * Reads a manifest one line at a time through a fixed-size buffer,
+	 * so memory use does not depend on the manifest size
+	 */
+	class FMCPManifestLineReader
+	{
+	public:
+		explicit FMCPManifestLineReader(IFileHandle* InHandle)
+			: Handle(InHandle)
+		{
+			Buffer.SetNumUninitialized(ChunkSize);
+		}
+
+		/**
+		 * Read the next line, without its line terminator
+		 * @return False at end of file
+		 */
+		bool ReadLine(FString& OutLine)
+		{
+			LineBytes.Reset();
+
+			while (true)
+			{
+				if (BufferPos >= BufferLen && !Refill())
+				{
+					break;
+				}
+
+				const uint8* Start = Buffer.GetData() + BufferPos;
+				int32 NewlinePos = BufferPos;
+				while (NewlinePos < BufferLen && Buffer[NewlinePos] != '\n')
+				{
+					++NewlinePos;
+				}
+
+				if (NewlinePos < BufferLen)
+				{
+					const int32 Count = NewlinePos - BufferPos;
+					LineBytes.Append(Start, Count);
+					BufferPos = NewlinePos + 1;
+					OutLine = ConvertLine();
+					return true;
+				}
+
+				LineBytes.Append(Start, BufferLen - BufferPos);
+				BufferPos = BufferLen;
+			}
+
+			if (LineBytes.Num() > 0)
+			{
+				OutLine = ConvertLine();
+				return true;
+			}
+			return false;
+		}
+
+	private:
+		bool Refill()
+		{
+			const int64 Remaining = Handle->Size() - Handle->Tell();
+			if (Remaining <= 0)
+			{
+				return false;
+			}
+
+			BufferLen = static_cast<int32>(FMath::Min<int64>(Remaining, ChunkSize));
+			BufferPos = 0;
+			return Handle->Read(Buffer.GetData(), BufferLen);
+		}
+
+		FString ConvertLine()
+		{
+			if (LineBytes.Num() > 0 && LineBytes.Last() == '\r')
+			{
+				LineBytes.Pop(EAllowShrinking::No);
+			}
+
+			FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(LineBytes.GetData()), LineBytes.Num());
+			return FString(Converted.Length(), Converted.Get());
+		}
+
+		static constexpr int32 ChunkSize = 64 * 1024;
+
+		TUniquePtr<IFileHandle> Handle;
+		TArray<uint8> Buffer;
+		TArray<uint8> LineBytes;
+		int32 BufferPos = 0;
+		int32 BufferLen = 0;
+	};
+
+	/** Per-route counters for the summary */
+	struct FMCPRouteStats
+	{
+		int32 Count = 0;
+		int32 Failed = 0;
+		double TotalMs = 0.0;
+	};
+
+	/**
+	 * Split a manifest line into a route and a body
+	 * Accepts {"route": ..., "body": {...}}, {"route": ..., "body": "<json>"}, {"route": ..., <fields>} and bare /add_node bodies
+	 */
+	bool ParseManifestLine(const FString& Line, FString& OutRoute, TSharedPtr<FJsonObject>& OutBody)
+	{
+		TSharedPtr<FJsonObject> LineJson;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+		if (!FJsonSerializer::Deserialize(Reader, LineJson) || !LineJson.IsValid())
+		{
+			return false;
+		}
+
+		if (!LineJson->TryGetStringField(TEXT("route"), OutRoute))
+		{
+			OutRoute = TEXT("/add_node");
+		}
+
+		const TSharedPtr<FJsonObject>* BodyObject = nullptr;
+		FString BodyString;
+		if (LineJson->TryGetObjectField(TEXT("body"), BodyObject))
+		{
+			OutBody = *BodyObject;
+		}
+		else if (LineJson->TryGetStringField(TEXT("body"), BodyString))
+		{
+			TSharedRef<TJsonReader<>> BodyReader = TJsonReaderFactory<>::Create(BodyString);
+			if (!FJsonSerializer::Deserialize(BodyReader, OutBody) || !OutBody.IsValid())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			OutBody = LineJson;
+		}
+		return true;
+	}
+
+	double Percentile(const TArray<float>& SortedValues, double Fraction)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.0;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+UUnrealMCPCommandlet::UUnrealMCPCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UUnrealMCPCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString* ManifestPath = ParamValues.Find(TEXT("manifest"));
+	if (!ManifestPath || ManifestPath->IsEmpty())
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Usage: -run=UnrealMCP -manifest=<ops.jsonl> [-report=<summary.json>] [-savebatch=<N>]"));
+		return 1;
+	}
+
+	IFileHandle* FileHandle = FPlatformFileManager::Get().GetPlatformFile().OpenRead(**ManifestPath);
+	if (!FileHandle)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Cannot open manifest '%s'"), **ManifestPath);
+		return 1;
+	}
+
+	const FString* SaveBatchParam = ParamValues.Find(TEXT("savebatch"));
+	const int32 SaveBatchSize = SaveBatchParam ? FMath::Max(FCString::Atoi(**SaveBatchParam), 1) : 100;
+
+	// Same engine path as FMCPHttpServer, with saves held until the end of the run
+	FMCPOperationRunner Runner;
+	Runner.SetDeferSaves(true);
+
+	// Unchanged assets are recognised from asset registry tags, so the initial scan has to finish first
+	const double RegistryStartTime = FPlatformTime::Seconds();
+	IAssetRegistry::GetChecked().WaitForCompletion();
+	const double RegistryWaitSeconds = FPlatformTime::Seconds() - RegistryStartTime;
+
+	FMCPManifestLineReader LineReader(FileHandle);
+	TArray<float> LatenciesMs;
+	TMap<FString, FMCPRouteStats> RouteStats;
+	int32 LineCount = 0;
+	int32 ParseErrors = 0;
+	int32 FailedOps = 0;
+
+	UE_LOG(LogUnrealMCP, Display, TEXT("Running MCP manifest '%s'"), **ManifestPath);
+	const double RunStartTime = FPlatformTime::Seconds();
+
+	// Registry notifications for the whole run are sent in one pass before the saves
+	Runner.GetAssetNotifier().BeginBatch();
+
+	FString Line;
+	while (LineReader.ReadLine(Line))
+	{
+		++LineCount;
+
+		Line.TrimStartAndEndInline();
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		FString Route;
+		TSharedPtr<FJsonObject> Body;
+		if (!ParseManifestLine(Line, Route, Body) || !FMCPOperationRunner::IsKnownOperation(Route))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Skipping manifest line %d: not a supported operation"), LineCount);
+			++ParseErrors;
+			continue;
+		}
+
+		const double OpStartTime = FPlatformTime::Seconds();
+		const FMCPOperationResult Result = Runner.Execute(Route, Body);
+		const double OpMs = (FPlatformTime::Seconds() - OpStartTime) * 1000.0;
+
+		LatenciesMs.Add(static_cast<float>(OpMs));
+		FMCPRouteStats& Stats = RouteStats.FindOrAdd(Route);
+		++Stats.Count;
+		Stats.TotalMs += OpMs;
+		if (!Result.IsSuccess())
+		{
+			++Stats.Failed;
+			++FailedOps;
+		}
+	}
+
+	const double ExecuteSeconds = FPlatformTime::Seconds() - RunStartTime;
+
+	const double NotifyStartTime = FPlatformTime::Seconds();
+	Runner.GetAssetNotifier().EndBatch();
+	const double NotifySeconds = FPlatformTime::Seconds() - NotifyStartTime;
+
+	// Batched save at the end of the run
+	const int32 PendingSaveCount = Runner.GetPendingSaveCount();
+	const double SaveStartTime = FPlatformTime::Seconds();
+	const int32 FailedSaves = Runner.FlushPendingSaves(SaveBatchSize);
+	const double SaveSeconds = FPlatformTime::Seconds() - SaveStartTime;
+	const double TotalSeconds = FPlatformTime::Seconds() - RunStartTime;
+
+	LatenciesMs.Sort();
+	const int32 OpCount = LatenciesMs.Num();
+
+	TSharedPtr<FJsonObject> SummaryJson = MakeShareable(new FJsonObject);
+	SummaryJson->SetStringField(TEXT("manifest"), *ManifestPath);
+	SummaryJson->SetNumberField(TEXT("lines"), LineCount);
+	SummaryJson->SetNumberField(TEXT("operations"), OpCount);
+	SummaryJson->SetNumberField(TEXT("failed"), FailedOps);
+	SummaryJson->SetNumberField(TEXT("parse_errors"), ParseErrors);
+	SummaryJson->SetNumberField(TEXT("packages_saved"), PendingSaveCount - FailedSaves);
+	SummaryJson->SetNumberField(TEXT("failed_saves"), FailedSaves);
+	SummaryJson->SetNumberField(TEXT("unchanged"), static_cast<double>(Runner.GetUnchangedAssetCount()));
+	SummaryJson->SetNumberField(TEXT("registry_wait_seconds"), RegistryWaitSeconds);
+	SummaryJson->SetNumberField(TEXT("execute_seconds"), ExecuteSeconds);
+	SummaryJson->SetNumberField(TEXT("notify_seconds"), NotifySeconds);
+	SummaryJson->SetNumberField(TEXT("save_seconds"), SaveSeconds);
+	SummaryJson->SetNumberField(TEXT("total_seconds"), TotalSeconds);
+	SummaryJson->SetNumberField(TEXT("ops_per_second"), TotalSeconds > 0.0 ? OpCount / TotalSeconds : 0.0);
+
+	TSharedPtr<FJsonObject> LatencyJson = MakeShareable(new FJsonObject);
+	LatencyJson->SetNumberField(TEXT("p50_ms"), Percentile(LatenciesMs, 0.50));
+	LatencyJson->SetNumberField(TEXT("p90_ms"), Percentile(LatenciesMs, 0.90));
+	LatencyJson->SetNumberField(TEXT("p99_ms"), Percentile(LatenciesMs, 0.99));
+	LatencyJson->SetNumberField(TEXT("max_ms"), OpCount > 0 ? LatenciesMs.Last() : 0.0);
+	SummaryJson->SetObjectField(TEXT("latency"), LatencyJson);
+
+	TSharedPtr<FJsonObject> RegistryJson = MakeShareable(new FJsonObject);
+	Runner.GetAssetNotifier().WriteStats(RegistryJson.ToSharedRef());
+	SummaryJson->SetObjectField(TEXT("asset_registry"), RegistryJson);
+
+	TSharedPtr<FJsonObject> RoutesJson = MakeShareable(new FJsonObject);
+	for (const TPair<FString, FMCPRouteStats>& Pair : RouteStats)
+	{
+		TSharedPtr<FJsonObject> RouteJson = MakeShareable(new FJsonObject);
+		RouteJson->SetNumberField(TEXT("count"), Pair.Value.Count);
+		RouteJson->SetNumberField(TEXT("failed"), Pair.Value.Failed);
+		RouteJson->SetNumberField(TEXT("mean_ms"), Pair.Value.Count > 0 ? Pair.Value.TotalMs / Pair.Value.Count : 0.0);
+		RoutesJson->SetObjectField(Pair.Key, RouteJson);
+
+		UE_LOG(LogUnrealMCP, Display, TEXT("  %-12s %8d ops  %6d failed  %8.2f ms mean"),
+			*Pair.Key, Pair.Value.Count, Pair.Value.Failed, Pair.Value.Count > 0 ? Pair.Value.TotalMs / Pair.Value.Count : 0.0);
+	}
+	SummaryJson->SetObjectField(TEXT("routes"), RoutesJson);
+
+	UE_LOG(LogUnrealMCP, Display, TEXT("MCP manifest complete: %d ops (%d failed, %d skipped) in %.2f s = %.1f ops/s"),
+		OpCount, FailedOps, ParseErrors, TotalSeconds, TotalSeconds > 0.0 ? OpCount / TotalSeconds : 0.0);
+	UE_LOG(LogUnrealMCP, Display, TEXT("Latency p50 %.2f ms, p90 %.2f ms, p99 %.2f ms; saved %d package(s) in %.2f s"),
+		Percentile(LatenciesMs, 0.50), Percentile(LatenciesMs, 0.90), Percentile(LatenciesMs, 0.99), PendingSaveCount - FailedSaves, SaveSeconds);
+
+	if (const FString* ReportPath = ParamValues.Find(TEXT("report")))
+	{
+		FString ReportString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+		FJsonSerializer::Serialize(SummaryJson.ToSharedRef(), Writer);
+
+		if (!FFileHelper::SaveStringToFile(ReportString, **ReportPath))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write report to '%s'"), **ReportPath);
+		}
+	}
+
+	return (FailedOps == 0 && FailedSaves == 0) ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/UnrealMCPSoakCommandlet.h"
+#include "MCPOperationRunner.h"
+#include "MCPMemoryTracker.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	/** Root of every package the soak creates */
+	const TCHAR* SoakRoot = TEXT("/Temp/UnrealMCP/Soak/");
+
+	/** Consecutive failed operations before the run is abandoned */
+	constexpr int32 MaxConsecutiveFailures = 100;
+
+	/**
+	 * Unregister, unroot and delete everything created under SoakRoot so the next collection can reclaim it
+	 * @return Number of packages released
+	 */
+	int32 ReleaseSoakAssets()
+	{
+		TArray<UPackage*> SoakPackages;
+		for (TObjectIterator<UPackage> It; It; ++It)
+		{
+			if (It->GetName().StartsWith(SoakRoot))
+			{
+				SoakPackages.Add(*It);
+			}
+		}
+
+		for (UPackage* Package : SoakPackages)
+		{
+			ForEachObjectWithPackage(Package, [](UObject* Object)
+			{
+				if (Object->IsA<UBlueprint>())
+				{
+					FAssetRegistryModule::AssetDeleted(Object);
+				}
+				Object->ClearFlags(RF_Public | RF_Standalone);
+				Object->MarkAsGarbage();
+				return true;
+			});
+			Package->ClearFlags(RF_Standalone);
+			Package->MarkAsGarbage();
+
+			const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+			IFileManager::Get().Delete(*Filename, false, true, true);
+		}
+		return SoakPackages.Num();
+	}
+}
+
+UUnrealMCPSoakCommandlet::UUnrealMCPSoakCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UUnrealMCPSoakCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	auto GetIntParam = [&ParamValues](const TCHAR* Name, int64 Default)
+	{
+		const FString* Value = ParamValues.Find(Name);
+		return Value ? FMath::Max<int64>(FCString::Atoi64(**Value), 1) : Default;
+	};
+
+	const int64 TargetOps = GetIntParam(TEXT("ops"), 200000);
+	const int64 SampleEvery = GetIntParam(TEXT("sampleevery"), 1000);
+	const int32 StampBatch = static_cast<int32>(FMath::Min<int64>(GetIntParam(TEXT("batch"), 100), 10000));
+	const bool bSave = !Switches.Contains(TEXT("nosave"));
+	const FString* RouteParam = ParamValues.Find(TEXT("route"));
+	const bool bStamp = RouteParam && (*RouteParam == TEXT("stamp") || *RouteParam == TEXT("/stamp"));
+
+	FMCPOperationRunner Runner;
+	Runner.SetDeferSaves(!bSave);
+
+	FMCPMemoryTracker Tracker;
+	Tracker.Sample(0, true);
+
+	UE_LOG(LogUnrealMCP, Display, TEXT("MCP soak: %lld asset(s) via %s, sampling every %lld, %s"),
+		TargetOps, bStamp ? TEXT("/stamp") : TEXT("/add_node"), SampleEvery, bSave ? TEXT("saving") : TEXT("not saving"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	int64 NextAssetIndex = 0;
+	int64 LastSampleOps = 0;
+	int32 FailedOps = 0;
+	int32 ConsecutiveFailures = 0;
+	double ReleaseSeconds = 0.0;
+
+	while (Runner.GetCreatedAssetCount() < TargetOps)
+	{
+		TSharedPtr<FJsonObject> Body = MakeShareable(new FJsonObject);
+		FMCPOperationResult Result;
+		if (bStamp)
+		{
+			TArray<TSharedPtr<FJsonValue>> Paths;
+			const int64 BatchCount = FMath::Min<int64>(StampBatch, TargetOps - Runner.GetCreatedAssetCount());
+			for (int64 Index = 0; Index < BatchCount; ++Index)
+			{
+				Paths.Add(MakeShareable(new FJsonValueString(FString::Printf(TEXT("%sBP_Soak_%lld"), SoakRoot, NextAssetIndex++))));
+			}
+			Body->SetArrayField(TEXT("paths"), Paths);
+			Result = Runner.Stamp(Body);
+		}
+		else
+		{
+			Body->SetStringField(TEXT("blueprint_path"), FString::Printf(TEXT("%sBP_Soak_%lld"), SoakRoot, NextAssetIndex++));
+			Body->SetStringField(TEXT("node_type"), TEXT("PrintString"));
+			Result = Runner.AddNode(Body);
+		}
+
+		if (Result.IsSuccess())
+		{
+			ConsecutiveFailures = 0;
+		}
+		else
+		{
+			++FailedOps;
+			if (++ConsecutiveFailures >= MaxConsecutiveFailures)
+			{
+				UE_LOG(LogUnrealMCP, Error, TEXT("MCP soak aborted after %d consecutive failures"), ConsecutiveFailures);
+				break;
+			}
+		}
+
+		const int64 CreatedCount = Runner.GetCreatedAssetCount();
+		if (CreatedCount - LastSampleOps >= SampleEvery || CreatedCount >= TargetOps)
+		{
+			Runner.DiscardPendingSaves();
+
+			const double ReleaseStartTime = FPlatformTime::Seconds();
+			ReleaseSoakAssets();
+			ReleaseSeconds += FPlatformTime::Seconds() - ReleaseStartTime;
+
+			const FMCPMemorySample& Sample = Tracker.Sample(CreatedCount, true);
+			LastSampleOps = CreatedCount;
+
+			const double Elapsed = FPlatformTime::Seconds() - StartTime;
+			UE_LOG(LogUnrealMCP, Display, TEXT("[%8lld] %d objects, %d packages, %.1f MB RSS, GC %.1f ms, %.1f assets/s"),
+				CreatedCount, Sample.ObjectCount, Sample.PackageCount, Sample.UsedPhysicalBytes / (1024.0 * 1024.0),
+				Sample.GCSeconds * 1000.0, Elapsed > 0.0 ? CreatedCount / Elapsed : 0.0);
+		}
+	}
+
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TSharedRef<FJsonObject> ReportJson = MakeShared<FJsonObject>();
+	ReportJson->SetNumberField(TEXT("assets_created"), static_cast<double>(Runner.GetCreatedAssetCount()));
+	ReportJson->SetNumberField(TEXT("failed_operations"), FailedOps);
+	ReportJson->SetNumberField(TEXT("total_seconds"), TotalSeconds);
+	ReportJson->SetNumberField(TEXT("release_seconds"), ReleaseSeconds);
+	ReportJson->SetBoolField(TEXT("saved"), bSave);
+	Tracker.WriteJson(ReportJson);
+
+	const TArray<FMCPMemoryTrend> Trends = Tracker.FindUnboundedGrowth();
+	for (const FMCPMemoryTrend& Trend : Trends)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Unbounded growth in %s: %.2f per 1000 ops (early %.2f), +%.0f since start"),
+			*Trend.Metric, Trend.SlopePerOp * 1000.0, Trend.EarlySlopePerOp * 1000.0, Trend.Growth);
+	}
+
+	UE_LOG(LogUnrealMCP, Display, TEXT("MCP soak complete: %lld asset(s) in %.1f s, %d failed operation(s), %d suspected leak(s)"),
+		Runner.GetCreatedAssetCount(), TotalSeconds, FailedOps, Trends.Num());
+
+	if (const FString* ReportPath = ParamValues.Find(TEXT("report")))
+	{
+		FString ReportString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+		FJsonSerializer::Serialize(ReportJson, Writer);
+
+		if (!FFileHelper::SaveStringToFile(ReportString, **ReportPath))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write report to '%s'"), **ReportPath);
+		}
+	}
+
+	return (Trends.Num() == 0 && ConsecutiveFailures < MaxConsecutiveFailures) ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPAssetNotifier.h"
+#include "IUnrealMCP.h"
+#include "UnrealMCPSettings.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+FMCPAssetNotifier::~FMCPAssetNotifier()
+{
+	if (Pending.Num() > 0)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("%d asset registry notification(s) were held past the end of their batch"), Pending.Num());
+		Flush();
+	}
+}
+
+void FMCPAssetNotifier::BeginBatch()
+{
+	++BatchDepth;
+}
+
+void FMCPAssetNotifier::EndBatch()
+{
+	BatchDepth = FMath::Max(BatchDepth - 1, 0);
+	if (BatchDepth == 0)
+	{
+		Flush();
+	}
+}
+
+void FMCPAssetNotifier::NotifyAssetCreated(UObject* Asset)
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	if (BatchDepth > 0 && Settings->bBatchAssetNotifications)
+	{
+		Pending.Add(Asset);
+		++BatchedCount;
+		return;
+	}
+
+	Broadcast(Asset);
+}
+
+void FMCPAssetNotifier::Flush()
+{
+	if (Pending.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	TArray<TWeakObjectPtr<UObject>> Assets = MoveTemp(Pending);
+	Pending.Reset();
+
+	for (const TWeakObjectPtr<UObject>& WeakAsset : Assets)
+	{
+		// Assets discarded later in the batch (deadline, rebuilt content) were never announced
+		if (UObject* Asset = WeakAsset.Get())
+		{
+			Broadcast(Asset);
+		}
+		else
+		{
+			++DroppedCount;
+		}
+	}
+
+	LastFlushSeconds = FPlatformTime::Seconds() - StartSeconds;
+	MaxFlushSeconds = FMath::Max(MaxFlushSeconds, LastFlushSeconds);
+	LargestFlush = FMath::Max(LargestFlush, Assets.Num());
+	++FlushCount;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Sent %d held asset registry notification(s) in %.2f ms"), Assets.Num(), LastFlushSeconds * 1000.0);
+}
+
+void FMCPAssetNotifier::Broadcast(UObject* Asset)
+{
+#if WITH_EDITOR
+	const double StartSeconds = FPlatformTime::Seconds();
+	FAssetRegistryModule::AssetCreated(Asset);
+	TotalNotifySeconds += FPlatformTime::Seconds() - StartSeconds;
+	++NotifiedCount;
+#endif
+}
+
+void FMCPAssetNotifier::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutJson->SetBoolField(TEXT("batching"), Settings->bBatchAssetNotifications);
+	OutJson->SetNumberField(TEXT("notified"), static_cast<double>(NotifiedCount));
+	OutJson->SetNumberField(TEXT("batched"), static_cast<double>(BatchedCount));
+	OutJson->SetNumberField(TEXT("dropped"), static_cast<double>(DroppedCount));
+	OutJson->SetNumberField(TEXT("pending"), Pending.Num());
+	OutJson->SetNumberField(TEXT("flushes"), FlushCount);
+	OutJson->SetNumberField(TEXT("largest_flush"), LargestFlush);
+	OutJson->SetNumberField(TEXT("total_ms"), TotalNotifySeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("mean_us"), NotifiedCount > 0 ? TotalNotifySeconds * 1000000.0 / NotifiedCount : 0.0);
+	OutJson->SetNumberField(TEXT("last_flush_ms"), LastFlushSeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("max_flush_ms"), MaxFlushSeconds * 1000.0);
+}
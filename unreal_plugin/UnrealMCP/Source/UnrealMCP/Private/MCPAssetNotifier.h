@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Sends asset registry notifications for newly created assets, configured in UUnrealMCPSettings.
+ * Each FAssetRegistryModule::AssetCreated call fans out to the content browser, thumbnails and every
+ * other registry listener. Inside a batch the notifications are held back and sent in one pass when
+ * the outermost batch ends, so listener work is not interleaved with compiles and saves. There is no
+ * bulk registration API, so the pass still makes one AssetCreated call per asset at the same cost.
+ * The time spent in the notifications is recorded for /status.
+ */
+class FMCPAssetNotifier
+{
+public:
+	~FMCPAssetNotifier();
+
+	/** Mark the start of a batch; batches may nest */
+	void BeginBatch();
+
+	/** Mark the end of a batch; the outermost one sends the held notifications */
+	void EndBatch();
+
+	/**
+	 * Register a new asset with the asset registry, now or at the end of the current batch
+	 * @param Asset The created asset
+	 */
+	void NotifyAssetCreated(UObject* Asset);
+
+	/** Number of notifications held for the current batch */
+	int32 GetPendingCount() const { return Pending.Num(); }
+
+	/** Write notification counts and timings */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	/** Send every held notification */
+	void Flush();
+
+	/** Send one notification and time it */
+	void Broadcast(UObject* Asset);
+
+	/** Batch state */
+	int32 BatchDepth = 0;
+	TArray<TWeakObjectPtr<UObject>> Pending;
+
+	/** Notification accounting */
+	int64 NotifiedCount = 0;
+	int64 BatchedCount = 0;
+	int64 DroppedCount = 0;
+	int32 FlushCount = 0;
+	int32 LargestFlush = 0;
+	double TotalNotifySeconds = 0.0;
+	double LastFlushSeconds = 0.0;
+	double MaxFlushSeconds = 0.0;
+};
+
+/**
+ * Holds an FMCPAssetNotifier batch open for the lifetime of the scope
+ */
+class FMCPAssetNotifyBatchScope
+{
+public:
+	explicit FMCPAssetNotifyBatchScope(FMCPAssetNotifier& InNotifier)
+		: Notifier(InNotifier)
+	{
+		Notifier.BeginBatch();
+	}
+
+	~FMCPAssetNotifyBatchScope()
+	{
+		Notifier.EndBatch();
+	}
+
+private:
+	FMCPAssetNotifier& Notifier;
+};
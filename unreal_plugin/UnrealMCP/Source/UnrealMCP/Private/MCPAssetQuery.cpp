@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPAssetQuery.h"
+#include "MCPBlueprintUtils.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Dom/JsonObject.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Asset to report for a package: the one named after it, otherwise the lexically first */
+	const FAssetData* FindPrimaryAsset(const TArray<const FAssetData*>& PackageAssets, FName PackageName)
+	{
+		const FName ShortName(*FPackageName::GetShortName(PackageName));
+		const FAssetData* FirstAsset = nullptr;
+		for (const FAssetData* Asset : PackageAssets)
+		{
+			if (Asset->AssetName == ShortName)
+			{
+				return Asset;
+			}
+			if (!FirstAsset || Asset->AssetName.LexicalLess(FirstAsset->AssetName))
+			{
+				FirstAsset = Asset;
+			}
+		}
+		return FirstAsset;
+	}
+
+	/** Build the entry for one package; Asset is null when the registry knows no asset in it */
+	TSharedRef<FJsonObject> MakeAssetJson(const IAssetRegistry& AssetRegistry, const FString& Path, FName PackageName, const FAssetData* Asset)
+	{
+		// FindPackage only looks at packages already in memory; it never loads
+		const UPackage* Package = FindPackage(nullptr, *PackageName.ToString());
+		const bool bExists = Asset != nullptr;
+		const bool bOnDisk = AssetRegistry.GetAssetPackageDataCopy(PackageName).IsSet();
+		const bool bDirty = Package && Package->IsDirty();
+
+		TSharedRef<FJsonObject> AssetJson = MakeShared<FJsonObject>();
+		AssetJson->SetStringField(TEXT("path"), Path);
+		AssetJson->SetBoolField(TEXT("exists"), bExists);
+		if (bExists)
+		{
+			AssetJson->SetStringField(TEXT("class"), Asset->AssetClassPath.ToString());
+
+			FString ContentHash;
+			if (Asset->GetTagValue(FMCPBlueprintUtils::ContentHashTag, ContentHash))
+			{
+				AssetJson->SetStringField(TEXT("content_hash"), ContentHash);
+			}
+		}
+		AssetJson->SetBoolField(TEXT("loaded"), Package != nullptr);
+		AssetJson->SetBoolField(TEXT("dirty"), bDirty);
+		AssetJson->SetBoolField(TEXT("on_disk"), bOnDisk);
+		AssetJson->SetStringField(TEXT("state"), !bExists ? TEXT("missing") : !bOnDisk ? TEXT("unsaved") : bDirty ? TEXT("dirty") : TEXT("saved"));
+		return AssetJson;
+	}
+}
+
+void FMCPAssetQuery::Run(const FMCPAssetQueryOptions& Options, const TSharedRef<FJsonObject>& OutJson)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<TSharedPtr<FJsonValue>> AssetsJson;
+	int32 Found = 0;
+	bool bTruncated = false;
+
+	if (!Options.PathPrefix.IsEmpty())
+	{
+		FString Prefix = Options.PathPrefix;
+		Prefix.RemoveFromEnd(TEXT("/"));
+
+		// A known folder is listed as is. Anything else is a package name prefix: only the parent folder itself
+		// is searched, since a name prefix never matches packages in sub-folders of the parent
+		FARFilter Filter;
+		FString NamePrefix;
+		if (AssetRegistry.PathExists(Prefix))
+		{
+			Filter.PackagePaths.Add(FName(*Prefix));
+			Filter.bRecursivePaths = Options.bRecursive;
+		}
+		else
+		{
+			Filter.PackagePaths.Add(FName(*FPackageName::GetLongPackagePath(Prefix)));
+			NamePrefix = Prefix;
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssets(Filter, Assets);
+
+		TMap<FName, TArray<const FAssetData*>> AssetsByPackage;
+		for (const FAssetData& Asset : Assets)
+		{
+			if (NamePrefix.IsEmpty() || Asset.PackageName.ToString().StartsWith(NamePrefix))
+			{
+				AssetsByPackage.FindOrAdd(Asset.PackageName).Add(&Asset);
+			}
+		}
+
+		TArray<FName> PackageNames;
+		AssetsByPackage.GenerateKeyArray(PackageNames);
+
+		// The limit is applied before sorting: a bounded heap keeps the lexically first Limit packages,
+		// so a limited result is stable between calls without sorting the whole folder
+		const int32 Limit = FMath::Max(Options.Limit, 0);
+		if (PackageNames.Num() > Limit)
+		{
+			bTruncated = true;
+			const auto GreaterName = [](FName A, FName B) { return B.LexicalLess(A); };
+			TArray<FName> FirstNames;
+			FirstNames.Reserve(Limit);
+			for (FName Name : PackageNames)
+			{
+				if (FirstNames.Num() < Limit)
+				{
+					FirstNames.HeapPush(Name, GreaterName);
+				}
+				else if (Limit > 0 && Name.LexicalLess(FirstNames.HeapTop()))
+				{
+					FirstNames.HeapPopDiscard(GreaterName, EAllowShrinking::No);
+					FirstNames.HeapPush(Name, GreaterName);
+				}
+			}
+			PackageNames = MoveTemp(FirstNames);
+		}
+
+		PackageNames.Sort([](FName A, FName B) { return A.LexicalLess(B); });
+
+		AssetsJson.Reserve(PackageNames.Num());
+		for (FName PackageName : PackageNames)
+		{
+			const FAssetData* Asset = FindPrimaryAsset(AssetsByPackage.FindChecked(PackageName), PackageName);
+			AssetsJson.Add(MakeShared<FJsonValueObject>(MakeAssetJson(AssetRegistry, PackageName.ToString(), PackageName, Asset)));
+			++Found;
+		}
+	}
+	else
+	{
+		// One registry query for all paths rather than one lookup per path
+		TArray<FName> PackageNames;
+		PackageNames.Reserve(Options.Paths.Num());
+		FARFilter Filter;
+		for (const FString& Path : Options.Paths)
+		{
+			const FString PackageString = Path.Contains(TEXT(".")) ? FPackageName::ObjectPathToPackageName(Path) : Path;
+			const FName PackageName = FPackageName::IsValidLongPackageName(PackageString) ? FName(*PackageString) : NAME_None;
+			PackageNames.Add(PackageName);
+			if (!PackageName.IsNone())
+			{
+				Filter.PackageNames.Add(PackageName);
+			}
+		}
+
+		// An empty filter would match every asset
+		TArray<FAssetData> Assets;
+		if (Filter.PackageNames.Num() > 0)
+		{
+			AssetRegistry.GetAssets(Filter, Assets);
+		}
+
+		TMap<FName, TArray<const FAssetData*>> AssetsByPackage;
+		AssetsByPackage.Reserve(Assets.Num());
+		for (const FAssetData& Asset : Assets)
+		{
+			AssetsByPackage.FindOrAdd(Asset.PackageName).Add(&Asset);
+		}
+
+		AssetsJson.Reserve(Options.Paths.Num());
+		for (int32 Index = 0; Index < Options.Paths.Num(); ++Index)
+		{
+			const FName PackageName = PackageNames[Index];
+			if (PackageName.IsNone())
+			{
+				TSharedRef<FJsonObject> InvalidJson = MakeShared<FJsonObject>();
+				InvalidJson->SetStringField(TEXT("path"), Options.Paths[Index]);
+				InvalidJson->SetBoolField(TEXT("exists"), false);
+				InvalidJson->SetStringField(TEXT("state"), TEXT("invalid"));
+				AssetsJson.Add(MakeShared<FJsonValueObject>(InvalidJson));
+				continue;
+			}
+
+			const TArray<const FAssetData*>* PackageAssets = AssetsByPackage.Find(PackageName);
+			const FAssetData* Asset = PackageAssets ? FindPrimaryAsset(*PackageAssets, PackageName) : nullptr;
+			AssetsJson.Add(MakeShared<FJsonValueObject>(MakeAssetJson(AssetRegistry, Options.Paths[Index], PackageName, Asset)));
+			Found += Asset ? 1 : 0;
+		}
+	}
+
+	OutJson->SetArrayField(TEXT("assets"), AssetsJson);
+	OutJson->SetNumberField(TEXT("count"), AssetsJson.Num());
+	OutJson->SetNumberField(TEXT("found"), Found);
+	OutJson->SetNumberField(TEXT("missing"), AssetsJson.Num() - Found);
+	OutJson->SetBoolField(TEXT("truncated"), bTruncated);
+	// While the initial scan runs, "missing" may only mean "not discovered yet"
+	OutJson->SetBoolField(TEXT("registry_loading"), AssetRegistry.IsLoadingAssets());
+	OutJson->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+}
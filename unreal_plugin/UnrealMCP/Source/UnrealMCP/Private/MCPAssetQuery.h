@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Options for one asset query
+ */
+struct FMCPAssetQueryOptions
+{
+	/** Package paths to look up (e.g., "/Game/MyBP"); object paths are reduced to their package */
+	TArray<FString> Paths;
+
+	/** When set, Paths is ignored and every asset in this folder, or whose package name starts with it, is returned */
+	FString PathPrefix;
+
+	/** Whether a folder prefix includes sub-folders; a package name prefix only matches within its parent folder */
+	bool bRecursive = true;
+
+	/** Maximum number of assets returned by a prefix query */
+	int32 Limit = 10000;
+};
+
+/**
+ * Answers existence, class and saved state for many assets from the in-memory asset registry.
+ * No package is loaded: loaded and dirty state come from packages that are already in memory,
+ * on-disk state from the registry's package data.
+ */
+class FMCPAssetQuery
+{
+public:
+	/** Largest number of explicit paths accepted in one query */
+	static constexpr int32 MaxPaths = 10000;
+
+	/**
+	 * Run a query
+	 * @param Options Paths or prefix to look up
+	 * @param OutJson Receives the "assets" array and summary counters
+	 */
+	static void Run(const FMCPAssetQueryOptions& Options, const TSharedRef<FJsonObject>& OutJson);
+};
@@ -0,0 +1,229 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPBlueprintTemplates.h"
+#include "MCPBlueprintUtils.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/AllOf.h"
+
+#if WITH_EDITOR
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "UObject/Package.h"
+#endif
+
+const TCHAR* FMCPBlueprintTemplateCache::DefaultTemplateName = TEXT("PrintStringActor");
+
+FMCPBlueprintTemplateCache::FMCPBlueprintTemplateCache()
+{
+	FString Error;
+	RegisterTemplate(DefaultTemplateName, { TEXT("PrintString") }, Error);
+}
+
+FMCPBlueprintTemplateCache::~FMCPBlueprintTemplateCache()
+{
+	ReleasePrototypes();
+}
+
+bool FMCPBlueprintTemplateCache::RegisterTemplate(const FString& Name, const TArray<FString>& NodeTypes, FString& OutError)
+{
+	// The name ends up in the prototype's package and object names, which also bound its length
+	const bool bValidName = !Name.IsEmpty() && Name.Len() <= 64
+		&& Algo::AllOf(Name, [](TCHAR Char) { return FChar::IsAlnum(Char) || Char == TEXT('_'); });
+	if (!bValidName)
+	{
+		OutError = FString::Printf(TEXT("Invalid template name '%s': use letters, digits and '_' only"), *Name);
+		return false;
+	}
+
+	for (const FString& NodeType : NodeTypes)
+	{
+		if (!FMCPBlueprintUtils::IsSupportedNodeType(NodeType))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Template '%s' uses unsupported node type '%s'"), *Name, *NodeType);
+			OutError = FString::Printf(TEXT("Template '%s' uses unsupported node type '%s'"), *Name, *NodeType);
+			return false;
+		}
+	}
+
+	if (!Templates.Contains(Name) && Templates.Num() >= MaxTemplates)
+	{
+		OutError = FString::Printf(TEXT("Cannot register template '%s': %d templates are already registered"), *Name, Templates.Num());
+		return false;
+	}
+
+	FMCPBlueprintTemplate& Template = Templates.FindOrAdd(Name);
+	if (Template.NodeTypes != NodeTypes)
+	{
+		Template.NodeTypes = NodeTypes;
+		DiscardPrototype(Template);
+		UE_LOG(LogUnrealMCP, Log, TEXT("Registered Blueprint template '%s' with %d node(s)"), *Name, NodeTypes.Num());
+	}
+	Template.ContentHash = FMCPBlueprintUtils::ComputeContentHash(NodeTypes);
+	return true;
+}
+
+bool FMCPBlueprintTemplateCache::HasTemplate(const FString& Name) const
+{
+	return Templates.Contains(Name);
+}
+
+FString FMCPBlueprintTemplateCache::GetContentHash(const FString& Name) const
+{
+	const FMCPBlueprintTemplate* Template = Templates.Find(Name);
+	return Template ? Template->ContentHash : FString();
+}
+
+double FMCPBlueprintTemplateCache::GetBuildSeconds(const FString& Name) const
+{
+	const FMCPBlueprintTemplate* Template = Templates.Find(Name);
+	return Template ? Template->BuildSeconds : 0.0;
+}
+
+TSharedPtr<FJsonObject> FMCPBlueprintTemplateCache::GetCompileResult(const FString& Name) const
+{
+	const FMCPBlueprintTemplate* Template = Templates.Find(Name);
+	return Template ? Template->CompileJson : nullptr;
+}
+
+bool FMCPBlueprintTemplateCache::Prebuild(const FString& Name)
+{
+	FMCPBlueprintTemplate* Template = Templates.Find(Name);
+	return Template && GetOrBuildPrototype(Name, *Template) != nullptr;
+}
+
+void FMCPBlueprintTemplateCache::ReleasePrototypes()
+{
+	for (TPair<FString, FMCPBlueprintTemplate>& Pair : Templates)
+	{
+		DiscardPrototype(Pair.Value);
+	}
+}
+
+void FMCPBlueprintTemplateCache::DiscardPrototype(FMCPBlueprintTemplate& Template)
+{
+	// Resetting the pointer alone would leave the RF_Standalone prototype in memory for good
+	if (UBlueprint* Prototype = Template.Prototype.Get())
+	{
+		UPackage* Package = Prototype->GetPackage();
+		Template.Prototype.Reset();
+		FMCPBlueprintUtils::DiscardPackage(Package);
+	}
+	Template.BuildSeconds = 0.0;
+	Template.CompileJson.Reset();
+	Template.bCompiled = false;
+}
+
+UBlueprint* FMCPBlueprintTemplateCache::GetOrBuildPrototype(const FString& Name, FMCPBlueprintTemplate& Template)
+{
+#if WITH_EDITOR
+	if (Template.Prototype.IsValid())
+	{
+		return Template.Prototype.Get();
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Prototypes live under /Temp so they are never saved or picked up by the asset registry
+	// A unique package per build, so a rebuild never creates the Blueprint over a prototype still awaiting collection
+	const FString PrototypeName = FString::Printf(TEXT("MCPTemplate_%s"), *Name);
+	const FName PackageName = MakeUniqueObjectName(nullptr, UPackage::StaticClass(), FName(*FString::Printf(TEXT("/Temp/UnrealMCP/Templates/%s"), *PrototypeName)));
+	UPackage* PrototypePackage = CreatePackage(*PackageName.ToString());
+	PrototypePackage->SetFlags(RF_Transient);
+
+	// Compile once here so every stamped copy starts from an up-to-date generated class
+	// The diagnostics are kept with the template, since every copy would report the same ones
+	TSharedRef<FJsonObject> CompileJson = MakeShared<FJsonObject>();
+	UBlueprint* Prototype = FMCPBlueprintUtils::BuildAndCompileActorBlueprint(PrototypePackage, PrototypeName, Template.NodeTypes, CompileJson, Template.bCompiled);
+	if (!Prototype)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to build prototype for template '%s'"), *Name);
+		FMCPBlueprintUtils::DiscardPackage(PrototypePackage);
+		return nullptr;
+	}
+
+	Template.CompileJson = CompileJson;
+	if (!Template.bCompiled)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Prototype for template '%s' failed to compile"), *Name);
+	}
+
+	Template.Prototype.Reset(Prototype);
+	Template.BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Built prototype for template '%s' in %.2f ms"), *Name, Template.BuildSeconds * 1000.0);
+	return Prototype;
+#else
+	return nullptr;
+#endif
+}
+
+UBlueprint* FMCPBlueprintTemplateCache::Stamp(const FString& Name, const FString& BlueprintPath, FString& OutError)
+{
+#if WITH_EDITOR
+	FMCPBlueprintTemplate* Template = Templates.Find(Name);
+	if (!Template)
+	{
+		OutError = FString::Printf(TEXT("Unknown template '%s'"), *Name);
+		return nullptr;
+	}
+
+	FString PackageName, AssetName;
+	if (!FMCPBlueprintUtils::SplitBlueprintPath(BlueprintPath, PackageName, AssetName))
+	{
+		OutError = FString::Printf(TEXT("Invalid blueprint path '%s'"), *BlueprintPath);
+		return nullptr;
+	}
+
+	UBlueprint* Prototype = GetOrBuildPrototype(Name, *Template);
+	if (!Prototype)
+	{
+		OutError = FString::Printf(TEXT("Failed to build template '%s'"), *Name);
+		return nullptr;
+	}
+
+	if (!Template->bCompiled)
+	{
+		OutError = FString::Printf(TEXT("Template '%s' does not compile; see \"compile\" for diagnostics"), *Name);
+		return nullptr;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
+	{
+		OutError = FString::Printf(TEXT("Failed to create package '%s'"), *PackageName);
+		return nullptr;
+	}
+
+	// UBlueprint::PostDuplicate renames and regenerates the skeleton and generated classes for the new name
+	UBlueprint* NewBlueprint = DuplicateObject<UBlueprint>(Prototype, Package, FName(*AssetName));
+	if (!NewBlueprint)
+	{
+		OutError = FString::Printf(TEXT("Failed to duplicate template '%s'"), *Name);
+		return nullptr;
+	}
+	NewBlueprint->SetFlags(RF_Public | RF_Standalone | RF_Transactional);
+
+	// Stamped copies must not share node identities with the prototype or with each other
+	TArray<UEdGraph*> Graphs;
+	NewBlueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				Node->CreateNewGuid();
+			}
+		}
+	}
+
+	++Template->StampCount;
+	return NewBlueprint;
+#else
+	OutError = TEXT("Template stamping is only supported in editor builds");
+	return nullptr;
+#endif
+}
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FJsonObject;
+class UBlueprint;
+
+/**
+ * A named Blueprint skeleton and its prototype, once built
+ */
+struct FMCPBlueprintTemplate
+{
+	/** Node types spawned into the event graph, in order */
+	TArray<FString> NodeTypes;
+
+	/** FMCPBlueprintUtils::ComputeContentHash of NodeTypes */
+	FString ContentHash;
+
+	/** Prototype kept alive in a transient package; empty until first use */
+	TStrongObjectPtr<UBlueprint> Prototype;
+
+	/** Time spent building and compiling the prototype */
+	double BuildSeconds = 0.0;
+
+	/** Compile status and diagnostics of the prototype; every stamped copy shares them */
+	TSharedPtr<FJsonObject> CompileJson;
+	bool bCompiled = false;
+
+	/** Number of assets stamped from this template */
+	int32 StampCount = 0;
+};
+
+/**
+ * Cache of prototype Blueprints that are built once and stamped out by duplication.
+ * Duplicating a compiled prototype skips node spawning and most of the Kismet work that
+ * FKismetEditorUtilities::CreateBlueprint pays for on every asset.
+ */
+class FMCPBlueprintTemplateCache
+{
+public:
+	/** Name of the built-in template matching the /add_node PrintString skeleton */
+	static const TCHAR* DefaultTemplateName;
+
+	FMCPBlueprintTemplateCache();
+	~FMCPBlueprintTemplateCache();
+
+	/** Most templates that can be registered, including the built-in one */
+	static constexpr int32 MaxTemplates = 64;
+
+	/**
+	 * Register or update a template definition
+	 * The cached prototype is discarded if the node list changed
+	 * @param Name Template name; letters, digits and '_' only, since it becomes part of the prototype's package name
+	 * @param NodeTypes Node types to spawn in the event graph
+	 * @param OutError Failure reason
+	 * @return True if the name is valid, all node types are supported and there is room for a new template
+	 */
+	bool RegisterTemplate(const FString& Name, const TArray<FString>& NodeTypes, FString& OutError);
+
+	/** Check whether a template with this name is registered */
+	bool HasTemplate(const FString& Name) const;
+
+	/**
+	 * Stamp a new asset from a template; the caller saves and registers it
+	 * @param Name Template name
+	 * @param BlueprintPath Target asset path (e.g., "/Game/MyBlueprint")
+	 * @param OutError Failure reason
+	 * @return The new, unsaved Blueprint, or nullptr on failure
+	 */
+	UBlueprint* Stamp(const FString& Name, const FString& BlueprintPath, FString& OutError);
+
+	/**
+	 * Build a template's prototype ahead of the first stamp
+	 * @return True if the prototype is available
+	 */
+	bool Prebuild(const FString& Name);
+
+	/**
+	 * Get the content hash recorded on assets stamped from a template
+	 * @return The hash, or an empty string for an unknown template
+	 */
+	FString GetContentHash(const FString& Name) const;
+
+	/**
+	 * Get the prototype build time of a template
+	 * @return Seconds spent building the prototype, or 0 if it has not been built
+	 */
+	double GetBuildSeconds(const FString& Name) const;
+
+	/**
+	 * Get the compile status and diagnostics of a template's prototype
+	 * @return The FMCPBlueprintUtils::CompileBlueprint output, or null if the prototype has not been built
+	 */
+	TSharedPtr<FJsonObject> GetCompileResult(const FString& Name) const;
+
+	/** Release all prototypes; they are rebuilt on next use */
+	void ReleasePrototypes();
+
+private:
+	/** Drop a template's prototype and discard its package, so the prototype is freed and can be rebuilt */
+	static void DiscardPrototype(FMCPBlueprintTemplate& Template);
+
+	/** Build the prototype for a template if it has not been built yet */
+	UBlueprint* GetOrBuildPrototype(const FString& Name, FMCPBlueprintTemplate& Template);
+
+	/** Registered templates by name */
+	TMap<FString, FMCPBlueprintTemplate> Templates;
+};
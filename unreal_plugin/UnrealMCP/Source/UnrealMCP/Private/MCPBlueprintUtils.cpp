@@ -0,0 +1,423 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPBlueprintUtils.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/PackageName.h"
+
+#if WITH_EDITOR
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "EdGraphToken.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/MetaData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/SecureHash.h"
+#include "ObjectTools.h"
+#endif
+
+const FName FMCPBlueprintUtils::ContentHashTag(TEXT("MCPContentHash"));
+
+namespace
+{
+	/** Bump when BuildAndCompileActorBlueprint changes what it generates, so existing assets are rebuilt */
+	constexpr int32 ContentHashVersion = 1;
+
+	/** Compiler messages reported per Blueprint; a broken graph can repeat the same error for every node */
+	constexpr int32 MaxCompileDiagnostics = 50;
+
+#if WITH_EDITOR
+	const TCHAR* GetSeverityName(EMessageSeverity::Type Severity)
+	{
+		switch (Severity)
+		{
+		case EMessageSeverity::Error:
+			return TEXT("error");
+		case EMessageSeverity::PerformanceWarning:
+		case EMessageSeverity::Warning:
+			return TEXT("warning");
+		default:
+			return TEXT("info");
+		}
+	}
+#endif
+}
+
+bool FMCPBlueprintUtils::SplitBlueprintPath(const FString& BlueprintPath, FString& OutPackageName, FString& OutAssetName)
+{
+	FString PackagePath;
+	if (!BlueprintPath.Split(TEXT("/"), &PackagePath, &OutAssetName, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Invalid blueprint path format: %s"), *BlueprintPath);
+		return false;
+	}
+
+	if (OutAssetName.IsEmpty())
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Asset name cannot be empty"));
+		return false;
+	}
+
+	// The full package name is the blueprint path itself
+	OutPackageName = BlueprintPath;
+	return true;
+}
+
+namespace
+{
+	/** Node type name to backing function, filled by BuildNodeFunctionIndex */
+	TMap<FString, TWeakObjectPtr<UFunction>> NodeFunctionIndex;
+}
+
+bool FMCPBlueprintUtils::IsSupportedNodeType(const FString& NodeType)
+{
+	// Only support PrintString for now
+	return NodeType == TEXT("PrintString");
+}
+
+void FMCPBlueprintUtils::BuildNodeFunctionIndex()
+{
+#if WITH_EDITOR
+	if (NodeFunctionIndex.Num() > 0)
+	{
+		return;
+	}
+
+	// ✅ 확인됨: UKismetSystemLibrary::PrintString UFUNCTION 검증
+	// D:\_Source\UnrealEngine\Engine\Source\Runtime\Engine\Classes\Kismet\KismetSystemLibrary.h:374
+	if (UFunction* PrintStringFunction = UKismetSystemLibrary::StaticClass()->FindFunctionByName(TEXT("PrintString")))
+	{
+		NodeFunctionIndex.Add(TEXT("PrintString"), PrintStringFunction);
+	}
+#endif
+}
+
+UFunction* FMCPBlueprintUtils::FindNodeFunction(const FString& NodeType)
+{
+	BuildNodeFunctionIndex();
+
+	const TWeakObjectPtr<UFunction>* Function = NodeFunctionIndex.Find(NodeType);
+	return Function ? Function->Get() : nullptr;
+}
+
+UEdGraphNode* FMCPBlueprintUtils::SpawnNode(UEdGraph* Graph, const FString& NodeType, int32 PosX, int32 PosY)
+{
+#if WITH_EDITOR
+	if (!Graph || !IsSupportedNodeType(NodeType))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Unsupported node type: %s. Only 'PrintString' is currently supported."), *NodeType);
+		return nullptr;
+	}
+
+	UFunction* NodeFunction = FindNodeFunction(NodeType);
+	if (!NodeFunction)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find %s function"), *NodeType);
+		return nullptr;
+	}
+
+	// ✅ 확인됨: UK2Node_CallFunction 노드 생성 패턴 검증
+	// D:\_Source\UnrealEngine\Engine\Source\Editor\Kismet\Private\BlueprintEditor.cpp:5279
+	UK2Node_CallFunction* NewFunctionNode = NewObject<UK2Node_CallFunction>(Graph);
+	NewFunctionNode->SetFromFunction(NodeFunction);
+
+	// Add the node to the graph
+	Graph->AddNode(NewFunctionNode, true, true);
+
+	// Position the node
+	NewFunctionNode->NodePosX = PosX;
+	NewFunctionNode->NodePosY = PosY;
+
+	// Allocate default pins for the node
+	NewFunctionNode->AllocateDefaultPins();
+
+	// Reconstruct the node to ensure proper setup
+	NewFunctionNode->ReconstructNode();
+
+	return NewFunctionNode;
+#else
+	return nullptr;
+#endif
+}
+
+UBlueprint* FMCPBlueprintUtils::BuildAndCompileActorBlueprint(UPackage* Package, const FString& AssetName, const TArray<FString>& NodeTypes, const TSharedRef<FJsonObject>& OutCompileJson, bool& bOutCompiled)
+{
+	bOutCompiled = false;
+#if WITH_EDITOR
+	// ✅ 확인됨: FKismetEditorUtilities::CreateBlueprint 함수 시그니처 검증
+	// D:\_Source\UnrealEngine\Engine\Source\Editor\UnrealEd\Public\Kismet2\KismetEditorUtilities.h:102
+	UBlueprint* NewBlueprint = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(),  // Parent class
+		Package,                // Outer package
+		FName(*AssetName),      // Blueprint name
+		BPTYPE_Normal,          // Blueprint type
+		NAME_None               // Calling context
+	);
+
+	if (!NewBlueprint)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to create Blueprint"));
+		return nullptr;
+	}
+
+	// ✅ 확인됨: FBlueprintEditorUtils::FindEventGraph 함수 검증
+	// D:\_Source\UnrealEngine\Engine\Source\Editor\UnrealEd\Public\Kismet2\BlueprintEditorUtils.h:1095
+	UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(NewBlueprint);
+	if (!EventGraph)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find Event Graph in Blueprint"));
+		return nullptr;
+	}
+
+	// Stack the nodes vertically so they do not overlap in the graph editor
+	for (int32 NodeIndex = 0; NodeIndex < NodeTypes.Num(); ++NodeIndex)
+	{
+		if (!FMCPBlueprintUtils::SpawnNode(EventGraph, NodeTypes[NodeIndex], 200, 200 + NodeIndex * 150))
+		{
+			return nullptr;
+		}
+	}
+
+	// The full compile regenerates the skeleton too, so no separate structural-modification pass is needed
+	bOutCompiled = CompileBlueprint(NewBlueprint, OutCompileJson);
+	return NewBlueprint;
+#else
+	return nullptr;
+#endif
+}
+
+bool FMCPBlueprintUtils::CompileBlueprint(UBlueprint* Blueprint, const TSharedRef<FJsonObject>& OutJson)
+{
+#if WITH_EDITOR
+	FCompilerResultsLog ResultsLog;
+	ResultsLog.bSilentMode = true;
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection, &ResultsLog);
+
+	const bool bSucceeded = Blueprint->Status != BS_Error && ResultsLog.NumErrors == 0;
+	OutJson->SetStringField(TEXT("status"), !bSucceeded ? TEXT("error") : ResultsLog.NumWarnings > 0 ? TEXT("warnings") : TEXT("ok"));
+	OutJson->SetNumberField(TEXT("errors"), ResultsLog.NumErrors);
+	OutJson->SetNumberField(TEXT("warnings"), ResultsLog.NumWarnings);
+
+	// The log's message tokens already point at the offending node and pin, so no graph walk is needed
+	TArray<TSharedPtr<FJsonValue>> DiagnosticValues;
+	for (const TSharedRef<FTokenizedMessage>& Message : ResultsLog.Messages)
+	{
+		if (DiagnosticValues.Num() >= MaxCompileDiagnostics)
+		{
+			break;
+		}
+
+		TSharedPtr<FJsonObject> DiagnosticJson = MakeShareable(new FJsonObject);
+		DiagnosticJson->SetStringField(TEXT("severity"), GetSeverityName(Message->GetSeverity()));
+		DiagnosticJson->SetStringField(TEXT("message"), Message->ToText().ToString());
+
+		for (const TSharedRef<IMessageToken>& Token : Message->GetMessageTokens())
+		{
+			if (Token->GetType() != EMessageToken::EdGraph)
+			{
+				continue;
+			}
+
+			const FEdGraphToken& GraphToken = static_cast<const FEdGraphToken&>(Token.Get());
+			const UEdGraphPin* Pin = GraphToken.GetPin();
+			const UEdGraphNode* Node = Pin ? Pin->GetOwningNodeUnchecked() : Cast<const UEdGraphNode>(GraphToken.GetGraphObject());
+
+			// The first node and pin named by a message are the ones it is about
+			if (Node && !DiagnosticJson->HasField(TEXT("node_guid")))
+			{
+				DiagnosticJson->SetStringField(TEXT("node_guid"), Node->NodeGuid.ToString(EGuidFormats::DigitsWithHyphens));
+				DiagnosticJson->SetStringField(TEXT("node"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+				if (const UEdGraph* Graph = Node->GetGraph())
+				{
+					DiagnosticJson->SetStringField(TEXT("graph"), Graph->GetName());
+				}
+			}
+			if (Pin && !DiagnosticJson->HasField(TEXT("pin")))
+			{
+				DiagnosticJson->SetStringField(TEXT("pin"), Pin->PinName.ToString());
+			}
+		}
+
+		DiagnosticValues.Add(MakeShareable(new FJsonValueObject(DiagnosticJson)));
+	}
+	OutJson->SetArrayField(TEXT("diagnostics"), DiagnosticValues);
+	if (ResultsLog.Messages.Num() > DiagnosticValues.Num())
+	{
+		OutJson->SetNumberField(TEXT("diagnostics_dropped"), ResultsLog.Messages.Num() - DiagnosticValues.Num());
+	}
+	return bSucceeded;
+#else
+	return false;
+#endif
+}
+
+void FMCPBlueprintUtils::WriteGraphSummary(UBlueprint* Blueprint, const TSharedRef<FJsonObject>& OutJson)
+{
+#if WITH_EDITOR
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+
+	TArray<TSharedPtr<FJsonValue>> GraphValues;
+	int32 TotalNodes = 0;
+	int32 TotalLinks = 0;
+	for (const UEdGraph* Graph : Graphs)
+	{
+		int32 Links = 0;
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			for (const UEdGraphPin* Pin : Node->Pins)
+			{
+				// Count each link once, from its output end
+				Links += Pin && Pin->Direction == EGPD_Output ? Pin->LinkedTo.Num() : 0;
+			}
+		}
+
+		TSharedPtr<FJsonObject> GraphJson = MakeShareable(new FJsonObject);
+		GraphJson->SetStringField(TEXT("name"), Graph->GetName());
+		GraphJson->SetNumberField(TEXT("nodes"), Graph->Nodes.Num());
+		GraphJson->SetNumberField(TEXT("links"), Links);
+		GraphValues.Add(MakeShareable(new FJsonValueObject(GraphJson)));
+
+		TotalNodes += Graph->Nodes.Num();
+		TotalLinks += Links;
+	}
+
+	OutJson->SetStringField(TEXT("parent_class"), Blueprint->ParentClass ? Blueprint->ParentClass->GetPathName() : FString());
+	OutJson->SetArrayField(TEXT("graphs"), GraphValues);
+	OutJson->SetNumberField(TEXT("nodes"), TotalNodes);
+	OutJson->SetNumberField(TEXT("links"), TotalLinks);
+#endif
+}
+
+bool FMCPBlueprintUtils::SaveBlueprintPackage(UPackage* Package, UBlueprint* Blueprint)
+{
+#if WITH_EDITOR
+	// Mark the package as dirty and save immediately to disk
+	Package->MarkAsFullyLoaded();
+	Package->SetDirtyFlag(true);
+
+	// Save the package to disk immediately
+	const FString PackageName = Package->GetName();
+	FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+	UE_LOG(LogUnrealMCP, Warning, TEXT("Package path conversion: '%s' -> '%s'"), *PackageName, *PackageFileName);
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
+	SaveArgs.Error = GError;
+	SaveArgs.bForceByteSwapping = true;
+	SaveArgs.bWarnOfLongFilename = true;
+	SaveArgs.SaveFlags = SAVE_NoError;
+
+	if (!UPackage::SavePackage(Package, Blueprint, *PackageFileName, SaveArgs))
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to save Blueprint package to disk"));
+		return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+FString FMCPBlueprintUtils::ComputeContentHash(const TArray<FString>& NodeTypes)
+{
+#if WITH_EDITOR
+	const FString Canonical = FString::Printf(TEXT("v%d|%s|%s"), ContentHashVersion, *AActor::StaticClass()->GetPathName(), *FString::Join(NodeTypes, TEXT(",")));
+	return FMD5::HashAnsiString(*Canonical);
+#else
+	return FString();
+#endif
+}
+
+void FMCPBlueprintUtils::SetContentHash(UBlueprint* Blueprint, const FString& Hash)
+{
+#if WITH_EDITOR
+	// Metadata keys in this set are written as asset registry tags on save
+	UObject::GetMetaDataTagsForAssetRegistry().Add(ContentHashTag);
+	Blueprint->GetOutermost()->GetMetaData().SetValue(Blueprint, ContentHashTag, *Hash);
+#endif
+}
+
+FMCPExistingAsset FMCPBlueprintUtils::FindExistingAsset(const FString& BlueprintPath)
+{
+	FMCPExistingAsset Existing;
+#if WITH_EDITOR
+	FString PackageName, AssetName;
+	if (!SplitBlueprintPath(BlueprintPath, PackageName, AssetName))
+	{
+		return Existing;
+	}
+
+	if (UPackage* Package = FindPackage(nullptr, *PackageName))
+	{
+		if (UObject* Asset = FindObject<UObject>(Package, *AssetName))
+		{
+			Existing.bExists = true;
+			Existing.LoadedAsset = Asset;
+			Existing.ContentHash = Package->GetMetaData().GetValue(Asset, ContentHashTag);
+			return Existing;
+		}
+	}
+
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(PackageName + TEXT(".") + AssetName));
+	if (AssetData.IsValid())
+	{
+		Existing.bExists = true;
+		AssetData.GetTagValue(ContentHashTag, Existing.ContentHash);
+	}
+#endif
+	return Existing;
+}
+
+int32 FMCPBlueprintUtils::DeleteAssets(const TArray<UObject*>& Assets)
+{
+#if WITH_EDITOR
+	if (Assets.Num() == 0)
+	{
+		return 0;
+	}
+
+	return ObjectTools::ForceDeleteObjects(Assets, false);
+#else
+	return 0;
+#endif
+}
+
+void FMCPBlueprintUtils::DiscardPackage(UPackage* Package)
+{
+#if WITH_EDITOR
+	if (!Package)
+	{
+		return;
+	}
+
+	// Move the package and its contents aside first so a retry can create the same path straight away
+	const FName DiscardedName = MakeUniqueObjectName(nullptr, UPackage::StaticClass(), FName(*(Package->GetName() + TEXT("_Discarded"))));
+	Package->Rename(*DiscardedName.ToString(), nullptr, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+
+	ForEachObjectWithPackage(Package, [](UObject* Object)
+	{
+		Object->ClearFlags(RF_Public | RF_Standalone);
+		Object->MarkAsGarbage();
+		return true;
+	});
+	Package->ClearFlags(RF_Standalone);
+	Package->MarkAsGarbage();
+#endif
+}
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UFunction;
+class UObject;
+class UPackage;
+
+/**
+ * The asset already at a target path, as far as MCP needs to know before creating one there
+ */
+struct FMCPExistingAsset
+{
+	/** An asset is loaded at the path or known to the asset registry */
+	bool bExists = false;
+
+	/** The loaded asset, if any; may have unsaved changes */
+	UObject* LoadedAsset = nullptr;
+
+	/** Content hash recorded by MCP; empty if the asset was not created by MCP */
+	FString ContentHash;
+};
+
+/**
+ * Shared Blueprint building blocks used by the HTTP routes and the template cache
+ */
+class FMCPBlueprintUtils
+{
+public:
+	/** Package metadata key holding the content hash; also written to the asset registry when the package is saved */
+	static const FName ContentHashTag;
+
+	/**
+	 * Split "/Game/Folder/MyBlueprint" into its package name and asset name
+	 * @return True if the path is a valid long package name with a non-empty asset name
+	 */
+	static bool SplitBlueprintPath(const FString& BlueprintPath, FString& OutPackageName, FString& OutAssetName);
+
+	/**
+	 * Check whether a node type can be spawned by SpawnNode
+	 */
+	static bool IsSupportedNodeType(const FString& NodeType);
+
+	/**
+	 * Build the node type to UFunction index used by SpawnNode
+	 * Safe to call more than once; later calls are no-ops
+	 */
+	static void BuildNodeFunctionIndex();
+
+	/**
+	 * Look up the function backing a node type, building the index on first use
+	 * @return The function, or nullptr if the node type is not supported
+	 */
+	static UFunction* FindNodeFunction(const FString& NodeType);
+
+	/**
+	 * Spawn a node of the given type in a graph
+	 * @param Graph The graph to add the node to
+	 * @param NodeType The node type (currently only "PrintString")
+	 * @param PosX Node X position
+	 * @param PosY Node Y position
+	 * @return The new node, or nullptr if the type is not supported
+	 */
+	static UEdGraphNode* SpawnNode(UEdGraph* Graph, const FString& NodeType, int32 PosX, int32 PosY);
+
+	/**
+	 * Create an actor Blueprint in the given package, populate its event graph and compile it once with diagnostics
+	 * @param Package The outer package
+	 * @param AssetName The Blueprint name
+	 * @param NodeTypes Node types to spawn in the event graph
+	 * @param OutCompileJson Receives the compile result, as written by CompileBlueprint
+	 * @param bOutCompiled True if the Blueprint compiled without errors
+	 * @return The new Blueprint, also when it failed to compile, or nullptr if it could not be built
+	 */
+	static UBlueprint* BuildAndCompileActorBlueprint(UPackage* Package, const FString& AssetName, const TArray<FString>& NodeTypes, const TSharedRef<FJsonObject>& OutCompileJson, bool& bOutCompiled);
+
+	/**
+	 * Compile a Blueprint and write its status and compiler diagnostics
+	 * Each diagnostic has a severity and message, plus the node GUID, node title, graph and pin it refers to when the compiler named one
+	 * @param Blueprint The Blueprint to compile
+	 * @param OutJson Receives "status", "errors", "warnings" and "diagnostics"
+	 * @return True if the Blueprint compiled without errors
+	 */
+	static bool CompileBlueprint(UBlueprint* Blueprint, const TSharedRef<FJsonObject>& OutJson);
+
+	/**
+	 * Write graph, node and link counts of a Blueprint
+	 */
+	static void WriteGraphSummary(UBlueprint* Blueprint, const TSharedRef<FJsonObject>& OutJson);
+
+	/**
+	 * Save a Blueprint package to disk
+	 * @return True if the package was written
+	 */
+	static bool SaveBlueprintPackage(UPackage* Package, UBlueprint* Blueprint);
+
+	/**
+	 * Hash the operation set that produces an actor Blueprint with these nodes
+	 * Equal node lists hash equally whichever route created the asset
+	 */
+	static FString ComputeContentHash(const TArray<FString>& NodeTypes);
+
+	/**
+	 * Record a content hash in the Blueprint's package metadata before it is saved
+	 */
+	static void SetContentHash(UBlueprint* Blueprint, const FString& Hash);
+
+	/**
+	 * Find the asset at a path and its content hash
+	 * A loaded asset is checked first since it may have unsaved changes; otherwise existence and the hash
+	 * are read from the asset registry, without loading the package
+	 * @param BlueprintPath Asset path (e.g., "/Game/MyBlueprint")
+	 */
+	static FMCPExistingAsset FindExistingAsset(const FString& BlueprintPath);
+
+	/**
+	 * Delete loaded assets through the editor's delete path, which clears references to them and removes
+	 * their package files, so new assets can be created at the same paths
+	 * Runs one garbage collection for the whole set; callers must not hold other unrooted objects
+	 * @return Number of assets deleted
+	 */
+	static int32 DeleteAssets(const TArray<UObject*>& Assets);
+
+	/**
+	 * Release an unsaved package and everything in it so the path can be created again
+	 * Only for packages MCP created and never saved; the objects are collected by the next garbage collection
+	 */
+	static void DiscardPackage(UPackage* Package);
+};
@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPCompression.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeLock.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace
+{
+	/** zlib window bits: 15 is the largest window; +16 writes a gzip wrapper, +32 detects gzip or zlib when inflating */
+	constexpr int32 ZlibWindowBits = 15;
+	constexpr int32 GzipWindowBits = ZlibWindowBits + 16;
+	constexpr int32 AutoDetectWindowBits = ZlibWindowBits + 32;
+
+	/** Output grown per inflate step */
+	constexpr int32 InflateChunkBytes = 64 * 1024;
+}
+
+bool FMCPCompression::HasZeroQuality(const FString& Parameters)
+{
+	TArray<FString> Params;
+	Parameters.ParseIntoArray(Params, TEXT(";"));
+	for (const FString& Param : Params)
+	{
+		FString Name;
+		FString Value;
+		if (Param.Split(TEXT("="), &Name, &Value) && Name.TrimStartAndEnd().Equals(TEXT("q"), ESearchCase::IgnoreCase))
+		{
+			return FCString::Atod(*Value.TrimStartAndEnd()) <= 0.0;
+		}
+	}
+	return false;
+}
+
+const TCHAR* FMCPCompression::GetCodingName(EMCPContentCoding Coding)
+{
+	switch (Coding)
+	{
+	case EMCPContentCoding::Gzip:
+		return TEXT("gzip");
+	case EMCPContentCoding::Deflate:
+		return TEXT("deflate");
+	default:
+		return TEXT("identity");
+	}
+}
+
+bool FMCPCompression::ParseContentEncoding(const FString& Value, EMCPContentCoding& OutCoding)
+{
+	const FString Coding = Value.TrimStartAndEnd();
+	if (Coding.IsEmpty() || Coding.Equals(TEXT("identity"), ESearchCase::IgnoreCase))
+	{
+		OutCoding = EMCPContentCoding::Identity;
+		return true;
+	}
+	if (Coding.Equals(TEXT("gzip"), ESearchCase::IgnoreCase) || Coding.Equals(TEXT("x-gzip"), ESearchCase::IgnoreCase))
+	{
+		OutCoding = EMCPContentCoding::Gzip;
+		return true;
+	}
+	if (Coding.Equals(TEXT("deflate"), ESearchCase::IgnoreCase))
+	{
+		OutCoding = EMCPContentCoding::Deflate;
+		return true;
+	}
+	return false;
+}
+
+EMCPContentCoding FMCPCompression::NegotiateAcceptEncoding(const TArray<FString>& AcceptValues)
+{
+	bool bAcceptsGzip = false;
+	bool bAcceptsDeflate = false;
+	for (const FString& AcceptValue : AcceptValues)
+	{
+		TArray<FString> Entries;
+		AcceptValue.ParseIntoArray(Entries, TEXT(","));
+		for (const FString& Entry : Entries)
+		{
+			FString Coding = Entry;
+			FString Parameters;
+			Entry.Split(TEXT(";"), &Coding, &Parameters);
+			if (HasZeroQuality(Parameters))
+			{
+				continue;
+			}
+
+			Coding.TrimStartAndEndInline();
+			bAcceptsGzip |= Coding.Equals(TEXT("gzip"), ESearchCase::IgnoreCase) || Coding.Equals(TEXT("x-gzip"), ESearchCase::IgnoreCase);
+			bAcceptsDeflate |= Coding.Equals(TEXT("deflate"), ESearchCase::IgnoreCase);
+		}
+	}
+
+	if (bAcceptsGzip)
+	{
+		return EMCPContentCoding::Gzip;
+	}
+	return bAcceptsDeflate ? EMCPContentCoding::Deflate : EMCPContentCoding::Identity;
+}
+
+bool FMCPCompression::Compress(EMCPContentCoding Coding, const TArray<uint8>& Bytes, int32 Level, TArray<uint8>& OutBytes)
+{
+	if (Coding == EMCPContentCoding::Identity)
+	{
+		return false;
+	}
+
+	z_stream Stream;
+	FMemory::Memzero(Stream);
+	const int32 WindowBits = Coding == EMCPContentCoding::Gzip ? GzipWindowBits : ZlibWindowBits;
+	if (deflateInit2(&Stream, FMath::Clamp(Level, 1, 9), Z_DEFLATED, WindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		return false;
+	}
+
+	// deflateBound covers the wrapper too, so a single Z_FINISH call always completes
+	OutBytes.SetNumUninitialized(static_cast<int32>(deflateBound(&Stream, Bytes.Num())));
+	Stream.next_in = const_cast<Bytef*>(Bytes.GetData());
+	Stream.avail_in = Bytes.Num();
+	Stream.next_out = OutBytes.GetData();
+	Stream.avail_out = OutBytes.Num();
+
+	const bool bFinished = deflate(&Stream, Z_FINISH) == Z_STREAM_END;
+	OutBytes.SetNum(static_cast<int32>(Stream.total_out), EAllowShrinking::No);
+	deflateEnd(&Stream);
+	return bFinished;
+}
+
+bool FMCPCompression::Decompress(const TArray<uint8>& Bytes, int64 MaxBytes, TArray<uint8>& OutBytes)
+{
+	z_stream Stream;
+	FMemory::Memzero(Stream);
+	if (inflateInit2(&Stream, AutoDetectWindowBits) != Z_OK)
+	{
+		return false;
+	}
+
+	Stream.next_in = const_cast<Bytef*>(Bytes.GetData());
+	Stream.avail_in = Bytes.Num();
+	OutBytes.Reset();
+
+	int32 Result = Z_OK;
+	while (Result == Z_OK)
+	{
+		if (OutBytes.Num() >= MaxBytes)
+		{
+			break;
+		}
+
+		const int32 Offset = OutBytes.Num();
+		const int32 ChunkBytes = static_cast<int32>(FMath::Min<int64>(InflateChunkBytes, MaxBytes - Offset));
+		OutBytes.AddUninitialized(ChunkBytes);
+		Stream.next_out = OutBytes.GetData() + Offset;
+		Stream.avail_out = ChunkBytes;
+
+		Result = inflate(&Stream, Z_NO_FLUSH);
+		OutBytes.SetNum(static_cast<int32>(Stream.total_out), EAllowShrinking::No);
+
+		// Z_BUF_ERROR with input left means the chunk filled up; with no input left the stream is truncated
+		if (Result == Z_BUF_ERROR && Stream.avail_in > 0)
+		{
+			Result = Z_OK;
+		}
+	}
+
+	inflateEnd(&Stream);
+	return Result == Z_STREAM_END;
+}
+
+void FMCPCompressionStats::RecordResponse(int64 BytesIn, int64 BytesOut, double Seconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	++ResponsesCompressed;
+	ResponseBytesIn += BytesIn;
+	ResponseBytesOut += BytesOut;
+	CompressSeconds += Seconds;
+}
+
+void FMCPCompressionStats::RecordSkippedResponse()
+{
+	FScopeLock ScopeLock(&Lock);
+	++ResponsesSkipped;
+}
+
+void FMCPCompressionStats::RecordRequest(int64 BytesIn, int64 BytesOut)
+{
+	FScopeLock ScopeLock(&Lock);
+	++RequestsInflated;
+	RequestBytesIn += BytesIn;
+	RequestBytesOut += BytesOut;
+}
+
+void FMCPCompressionStats::RecordRejectedRequest()
+{
+	FScopeLock ScopeLock(&Lock);
+	++RequestsRejected;
+}
+
+void FMCPCompressionStats::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	FScopeLock ScopeLock(&Lock);
+	OutJson->SetNumberField(TEXT("responses_compressed"), static_cast<double>(ResponsesCompressed));
+	OutJson->SetNumberField(TEXT("responses_below_threshold"), static_cast<double>(ResponsesSkipped));
+	OutJson->SetNumberField(TEXT("response_bytes_in"), static_cast<double>(ResponseBytesIn));
+	OutJson->SetNumberField(TEXT("response_bytes_out"), static_cast<double>(ResponseBytesOut));
+	OutJson->SetNumberField(TEXT("response_ratio"), ResponseBytesIn > 0 ? static_cast<double>(ResponseBytesOut) / ResponseBytesIn : 0.0);
+	OutJson->SetNumberField(TEXT("compress_ms"), CompressSeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("requests_inflated"), static_cast<double>(RequestsInflated));
+	OutJson->SetNumberField(TEXT("requests_rejected"), static_cast<double>(RequestsRejected));
+	OutJson->SetNumberField(TEXT("request_bytes_in"), static_cast<double>(RequestBytesIn));
+	OutJson->SetNumberField(TEXT("request_bytes_out"), static_cast<double>(RequestBytesOut));
+}
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FJsonObject;
+
+/** HTTP content coding of a request or response body */
+enum class EMCPContentCoding : uint8
+{
+	Identity,
+	/** RFC 1952 gzip stream */
+	Gzip,
+	/** RFC 1950 zlib stream, which is what HTTP calls "deflate" */
+	Deflate
+};
+
+/**
+ * zlib-backed gzip/deflate codec for HTTP bodies.
+ * Uses zlib directly rather than FCompression so the compression level is configurable and request
+ * bodies can be inflated without knowing their size up front. Stateless and safe on any thread.
+ */
+class FMCPCompression
+{
+public:
+	/** Token used in Content-Encoding and Accept-Encoding */
+	static const TCHAR* GetCodingName(EMCPContentCoding Coding);
+
+	/**
+	 * Parse a Content-Encoding header value
+	 * @return False for codings other than identity, gzip and deflate, or for stacked codings
+	 */
+	static bool ParseContentEncoding(const FString& Value, EMCPContentCoding& OutCoding);
+
+	/**
+	 * Choose a response coding from Accept-Encoding values, which may be split or comma-separated
+	 * Prefers gzip over deflate and skips codings listed with q=0
+	 */
+	static EMCPContentCoding NegotiateAcceptEncoding(const TArray<FString>& AcceptValues);
+
+	/**
+	 * Whether the parameters of an Accept or Accept-Encoding entry, e.g. "q=0" in "gzip;q=0", opt out of it
+	 * @param Parameters Everything after the entry's first ';'
+	 */
+	static bool HasZeroQuality(const FString& Parameters);
+
+	/**
+	 * Compress a body
+	 * @param Level zlib level, 1 (fastest) to 9 (smallest)
+	 * @return False if Coding is Identity or zlib fails
+	 */
+	static bool Compress(EMCPContentCoding Coding, const TArray<uint8>& Bytes, int32 Level, TArray<uint8>& OutBytes);
+
+	/**
+	 * Inflate a gzip or zlib body; the stream header decides which
+	 * @param MaxBytes Inflated size at which decoding gives up, so a small body cannot expand without bound
+	 * @return False if the stream is corrupt, truncated or larger than MaxBytes
+	 */
+	static bool Decompress(const TArray<uint8>& Bytes, int64 MaxBytes, TArray<uint8>& OutBytes);
+};
+
+/**
+ * Compression counters reported by /status
+ * Responses are compressed on worker threads, so every method locks.
+ */
+class FMCPCompressionStats
+{
+public:
+	/** Record a compressed response */
+	void RecordResponse(int64 BytesIn, int64 BytesOut, double Seconds);
+
+	/** Record a response below the size threshold, sent as is to a client that accepts compression */
+	void RecordSkippedResponse();
+
+	/** Record a compressed request body that was inflated */
+	void RecordRequest(int64 BytesIn, int64 BytesOut);
+
+	/** Record a request body with an unsupported, corrupt or oversized content coding */
+	void RecordRejectedRequest();
+
+	/** Write counters, byte totals and the overall response ratio */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	mutable FCriticalSection Lock;
+
+	int64 ResponsesCompressed = 0;
+	int64 ResponsesSkipped = 0;
+	int64 ResponseBytesIn = 0;
+	int64 ResponseBytesOut = 0;
+	double CompressSeconds = 0.0;
+
+	int64 RequestsInflated = 0;
+	int64 RequestsRejected = 0;
+	int64 RequestBytesIn = 0;
+	int64 RequestBytesOut = 0;
+};
@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPDryRunStore.h"
+#include "MCPBlueprintUtils.h"
+#include "IUnrealMCP.h"
+#include "UnrealMCPSettings.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_EDITOR
+#include "Engine/Blueprint.h"
+#endif
+
+const TCHAR* FMCPDryRunStore::PackageRoot = TEXT("/Temp/UnrealMCP/DryRun");
+
+FMCPDryRunStore::~FMCPDryRunStore()
+{
+	for (FMCPDryRunResult& Result : Results)
+	{
+		Release(Result.Blueprint.Get());
+	}
+}
+
+FString FMCPDryRunStore::MakePackageName(const FString& AssetName, FString& OutId)
+{
+	OutId = FString::Printf(TEXT("dry%llu"), NextId++);
+	return FString::Printf(TEXT("%s/%s/%s"), PackageRoot, *OutId, *AssetName);
+}
+
+bool FMCPDryRunStore::Add(const FString& Id, const FString& BlueprintPath, const FString& ContentHash, UBlueprint* Blueprint)
+{
+	++Built;
+
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	if (Settings->DryRunResultsKept <= 0)
+	{
+		Release(Blueprint);
+		++Released;
+		return false;
+	}
+
+	Trim(1);
+
+	FMCPDryRunResult& Result = Results.AddDefaulted_GetRef();
+	Result.Id = Id;
+	Result.BlueprintPath = BlueprintPath;
+	Result.ContentHash = ContentHash;
+	Result.Blueprint.Reset(Blueprint);
+	Result.CreatedSeconds = FPlatformTime::Seconds();
+	return true;
+}
+
+bool FMCPDryRunStore::Take(const FString& Id, FMCPDryRunResult& OutResult)
+{
+	Trim(0);
+
+	const int32 Index = Results.IndexOfByPredicate([&Id](const FMCPDryRunResult& Result) { return Result.Id == Id; });
+	if (Index == INDEX_NONE || !Results[Index].Blueprint.IsValid())
+	{
+		return false;
+	}
+
+	OutResult = MoveTemp(Results[Index]);
+	Results.RemoveAt(Index);
+	++Committed;
+	return true;
+}
+
+void FMCPDryRunStore::Trim(int32 Reserve)
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	const double NowSeconds = FPlatformTime::Seconds();
+	const int32 Capacity = FMath::Max(Settings->DryRunResultsKept - Reserve, 0);
+
+	// Oldest first, so expired results are always at the front
+	int32 ReleaseCount = 0;
+	while (ReleaseCount < Results.Num()
+		&& (Results.Num() - ReleaseCount > Capacity || NowSeconds - Results[ReleaseCount].CreatedSeconds > Settings->DryRunTTLSeconds))
+	{
+		Release(Results[ReleaseCount].Blueprint.Get());
+		++ReleaseCount;
+	}
+
+	if (ReleaseCount > 0)
+	{
+		UE_LOG(LogUnrealMCP, Verbose, TEXT("Released %d dry-run result(s)"), ReleaseCount);
+		Results.RemoveAt(0, ReleaseCount);
+		Released += ReleaseCount;
+	}
+}
+
+void FMCPDryRunStore::Release(UBlueprint* Blueprint)
+{
+#if WITH_EDITOR
+	if (Blueprint)
+	{
+		FMCPBlueprintUtils::DiscardPackage(Blueprint->GetOutermost());
+	}
+#endif
+}
+
+void FMCPDryRunStore::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutJson->SetNumberField(TEXT("kept"), Results.Num());
+	OutJson->SetNumberField(TEXT("capacity"), Settings->DryRunResultsKept);
+	OutJson->SetNumberField(TEXT("ttl_seconds"), Settings->DryRunTTLSeconds);
+	OutJson->SetNumberField(TEXT("built"), static_cast<double>(Built));
+	OutJson->SetNumberField(TEXT("committed"), static_cast<double>(Committed));
+	OutJson->SetNumberField(TEXT("released"), static_cast<double>(Released));
+}
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FJsonObject;
+class UBlueprint;
+
+/**
+ * A Blueprint built and compiled by a dry run, waiting to be committed or released
+ */
+struct FMCPDryRunResult
+{
+	/** Id returned to the client and passed to /commit */
+	FString Id;
+
+	/** Asset path the dry run was requested for; /commit saves the Blueprint there */
+	FString BlueprintPath;
+
+	/** Content hash of the operation set that built the Blueprint */
+	FString ContentHash;
+
+	/** The Blueprint, in its own package under PackageRoot */
+	TStrongObjectPtr<UBlueprint> Blueprint;
+
+	/** FPlatformTime::Seconds when the result was stored */
+	double CreatedSeconds = 0.0;
+};
+
+/**
+ * Bounded store of dry-run results, configured in UUnrealMCPSettings.
+ * Results live in /Temp packages that are never saved or registered with the asset registry.
+ * The oldest results, and those past the TTL, are released so that throwaway attempts do not
+ * accumulate; a kept result can be promoted to a real asset by /commit without rebuilding it.
+ */
+class FMCPDryRunStore
+{
+public:
+	/** Package root of dry-run Blueprints */
+	static const TCHAR* PackageRoot;
+
+	~FMCPDryRunStore();
+
+	/**
+	 * Get a fresh package name for a dry run
+	 * @param AssetName Name of the Blueprint that will be built in it
+	 * @param OutId Receives the id of the dry run
+	 */
+	FString MakePackageName(const FString& AssetName, FString& OutId);
+
+	/**
+	 * Keep a dry-run result for /commit, releasing the oldest and expired ones
+	 * @return True if the result was kept; false if keeping is disabled and the result was released
+	 */
+	bool Add(const FString& Id, const FString& BlueprintPath, const FString& ContentHash, UBlueprint* Blueprint);
+
+	/**
+	 * Remove a kept result so the caller can promote it
+	 * @return True if the id refers to a kept, unexpired result
+	 */
+	bool Take(const FString& Id, FMCPDryRunResult& OutResult);
+
+	/** Release a Blueprint built by a dry run and its package */
+	static void Release(UBlueprint* Blueprint);
+
+	/** Write kept results and counters */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	/** Release results past the TTL and trim the store to its capacity (minus Reserve slots) */
+	void Trim(int32 Reserve);
+
+	/** Kept results, oldest first */
+	TArray<FMCPDryRunResult> Results;
+
+	uint64 NextId = 1;
+
+	/** Counters */
+	int64 Built = 0;
+	int64 Committed = 0;
+	int64 Released = 0;
+};
@@ -0,0 +1,422 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPEventHub.h"
+#include "IUnrealMCP.h"
+#include "UnrealMCPSettings.h"
+#include "HttpServerResponse.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Reconnect delay suggested to EventSource clients after each response */
+	constexpr int32 SSERetryMs = 250;
+
+	/** Longest subscriber ID accepted */
+	constexpr int32 MaxSubscriberIdLength = 64;
+
+	uint32 GetTopicBit(EMCPEventTopic Topic)
+	{
+		return 1u << static_cast<uint32>(Topic);
+	}
+}
+
+FMCPEventHub::FMCPEventHub()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPEventHub::Tick));
+}
+
+FMCPEventHub::~FMCPEventHub()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	CloseAll();
+}
+
+bool FMCPEventHub::HasSubscribers(EMCPEventTopic Topic) const
+{
+	const uint32 TopicBit = GetTopicBit(Topic);
+	for (const TPair<FString, FMCPEventSubscriber>& Pair : Subscribers)
+	{
+		if (Pair.Value.TopicMask & TopicBit)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FMCPEventHub::Publish(EMCPEventTopic Topic, const TSharedRef<FJsonObject>& Data)
+{
+	if (!HasSubscribers(Topic))
+	{
+		return;
+	}
+
+	TSharedRef<FMCPEvent> Event = MakeShared<FMCPEvent>();
+	Event->Id = NextEventId++;
+	Event->Topic = Topic;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Event->Data);
+	FJsonSerializer::Serialize(Data, Writer);
+	++PublishedEvents;
+
+	const int32 BufferSize = GetDefault<UUnrealMCPSettings>()->EventBufferSize;
+	const uint32 TopicBit = GetTopicBit(Topic);
+	for (TPair<FString, FMCPEventSubscriber>& Pair : Subscribers)
+	{
+		FMCPEventSubscriber& Subscriber = Pair.Value;
+		if (!(Subscriber.TopicMask & TopicBit))
+		{
+			continue;
+		}
+
+		// A slow reader loses its oldest events rather than growing without bound
+		while (Subscriber.Buffer.Num() >= BufferSize)
+		{
+			Subscriber.Buffer.PopFront();
+			++Subscriber.Dropped;
+			++Subscriber.UnreportedDropped;
+			++DroppedEvents;
+		}
+		Subscriber.Buffer.Add(Event);
+	}
+}
+
+bool FMCPEventHub::Poll(const FString& SubscriberId, uint64 LastEventId, uint32 TopicMask, double TimeoutSeconds, EMCPEventFormat Format, const FHttpResultCallback& OnComplete)
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	FMCPEventSubscriber* Subscriber = FindOrAddSubscriber(SubscriberId, NowSeconds);
+	if (!Subscriber)
+	{
+		return false;
+	}
+
+	// A poll on an attached ID turns it back into a polling subscriber
+	Subscriber->Sink = nullptr;
+	Subscriber->TopicMask = TopicMask;
+	Subscriber->LastPollSeconds = NowSeconds;
+
+	// Drop acknowledged events; a lower Last-Event-ID than was sent makes the rest go out again
+	const uint64 AckThroughId = LastEventId > 0 ? LastEventId : Subscriber->DeliveredThroughId;
+	while (!Subscriber->Buffer.IsEmpty() && Subscriber->Buffer.First()->Id <= AckThroughId)
+	{
+		Subscriber->Buffer.PopFront();
+	}
+
+	if (Subscriber->PendingPoll)
+	{
+		FHttpResultCallback ReplacedPoll = MoveTemp(Subscriber->PendingPoll);
+		Subscriber->PendingPoll = nullptr;
+		Respond(SubscriberId, *Subscriber, ReplacedPoll, Subscriber->PendingFormat, false);
+	}
+
+	if (!Subscriber->Buffer.IsEmpty() || Subscriber->UnreportedDropped > 0 || TimeoutSeconds <= 0.0)
+	{
+		Respond(SubscriberId, *Subscriber, OnComplete, Format, true);
+		return true;
+	}
+
+	Subscriber->PendingPoll = OnComplete;
+	Subscriber->PendingFormat = Format;
+	Subscriber->PollDeadlineSeconds = NowSeconds + TimeoutSeconds;
+	return true;
+}
+
+bool FMCPEventHub::Attach(const FString& SubscriberId, uint32 TopicMask, FMCPEventSink Sink)
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	FMCPEventSubscriber* Subscriber = FindOrAddSubscriber(SubscriberId, NowSeconds);
+	if (!Subscriber)
+	{
+		return false;
+	}
+
+	if (Subscriber->PendingPoll)
+	{
+		FHttpResultCallback ReplacedPoll = MoveTemp(Subscriber->PendingPoll);
+		Subscriber->PendingPoll = nullptr;
+		Respond(SubscriberId, *Subscriber, ReplacedPoll, Subscriber->PendingFormat, false);
+	}
+
+	Subscriber->TopicMask = TopicMask;
+	Subscriber->LastPollSeconds = NowSeconds;
+	Subscriber->Sink = MoveTemp(Sink);
+	return true;
+}
+
+void FMCPEventHub::Detach(const FString& SubscriberId)
+{
+	if (Subscribers.Remove(SubscriberId) > 0)
+	{
+		UE_LOG(LogUnrealMCP, Log, TEXT("Event subscriber '%s' detached"), *SubscriberId);
+	}
+}
+
+FMCPEventSubscriber* FMCPEventHub::FindOrAddSubscriber(const FString& SubscriberId, double NowSeconds)
+{
+	if (FMCPEventSubscriber* Subscriber = Subscribers.Find(SubscriberId))
+	{
+		return Subscriber;
+	}
+
+	if (Subscribers.Num() >= GetDefault<UUnrealMCPSettings>()->MaxEventSubscribers)
+	{
+		// Make room by evicting the subscriber that has gone longest without polling
+		const FString* EvictId = nullptr;
+		double OldestPollSeconds = NowSeconds;
+		for (const TPair<FString, FMCPEventSubscriber>& Pair : Subscribers)
+		{
+			if (!Pair.Value.PendingPoll && !Pair.Value.Sink && Pair.Value.LastPollSeconds <= OldestPollSeconds)
+			{
+				EvictId = &Pair.Key;
+				OldestPollSeconds = Pair.Value.LastPollSeconds;
+			}
+		}
+		if (!EvictId)
+		{
+			return nullptr;
+		}
+
+		UE_LOG(LogUnrealMCP, Log, TEXT("Evicted event subscriber '%s' to make room for '%s'"), **EvictId, *SubscriberId);
+		Subscribers.Remove(FString(*EvictId));
+		++EvictedSubscribers;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Event subscriber '%s' connected"), *SubscriberId);
+	return &Subscribers.Add(SubscriberId);
+}
+
+void FMCPEventHub::CloseAll()
+{
+	// Detach first so a callback cannot see a half-cleared map
+	TMap<FString, FMCPEventSubscriber> ClosedSubscribers = MoveTemp(Subscribers);
+	Subscribers.Reset();
+
+	for (TPair<FString, FMCPEventSubscriber>& Pair : ClosedSubscribers)
+	{
+		if (Pair.Value.Sink)
+		{
+			Push(Pair.Value);
+		}
+		else if (Pair.Value.PendingPoll)
+		{
+			FHttpResultCallback PendingPoll = MoveTemp(Pair.Value.PendingPoll);
+			Respond(Pair.Key, Pair.Value, PendingPoll, Pair.Value.PendingFormat, true);
+		}
+	}
+}
+
+bool FMCPEventHub::Tick(float DeltaTime)
+{
+	if (Subscribers.Num() == 0)
+	{
+		return true;
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	const double IdleSeconds = GetDefault<UUnrealMCPSettings>()->EventSubscriberIdleSeconds;
+	for (auto It = Subscribers.CreateIterator(); It; ++It)
+	{
+		FMCPEventSubscriber& Subscriber = It.Value();
+		if (Subscriber.Sink)
+		{
+			Push(Subscriber);
+		}
+		else if (Subscriber.PendingPoll)
+		{
+			if (!Subscriber.Buffer.IsEmpty() || Subscriber.UnreportedDropped > 0 || NowSeconds >= Subscriber.PollDeadlineSeconds)
+			{
+				FHttpResultCallback PendingPoll = MoveTemp(Subscriber.PendingPoll);
+				Subscriber.PendingPoll = nullptr;
+				Respond(It.Key(), Subscriber, PendingPoll, Subscriber.PendingFormat, true);
+
+				// The idle clock restarts when the answer goes out, not when the poll arrived
+				Subscriber.LastPollSeconds = NowSeconds;
+			}
+		}
+		else if (NowSeconds - Subscriber.LastPollSeconds > IdleSeconds)
+		{
+			UE_LOG(LogUnrealMCP, Log, TEXT("Event subscriber '%s' expired after %.0f s without polling (%lld event(s) dropped)"),
+				*It.Key(), IdleSeconds, Subscriber.Dropped);
+			It.RemoveCurrent();
+			++ExpiredSubscribers;
+		}
+	}
+	return true;
+}
+
+void FMCPEventHub::Push(FMCPEventSubscriber& Subscriber)
+{
+	if (Subscriber.Buffer.IsEmpty() && Subscriber.UnreportedDropped == 0)
+	{
+		return;
+	}
+
+	const int32 EventCount = FMath::Min(Subscriber.Buffer.Num(), MaxEventsPerResponse);
+	TArray<TSharedPtr<const FMCPEvent>> Events;
+	Events.Reserve(EventCount);
+	for (int32 Index = 0; Index < EventCount; ++Index)
+	{
+		Events.Add(Subscriber.Buffer.PopFrontValue());
+	}
+	if (EventCount > 0)
+	{
+		Subscriber.DeliveredThroughId = Events.Last()->Id;
+		DeliveredEvents += EventCount;
+	}
+
+	const int64 ReportedDropped = Subscriber.UnreportedDropped;
+	Subscriber.UnreportedDropped = 0;
+	Subscriber.Sink(Events, ReportedDropped);
+}
+
+void FMCPEventHub::Respond(const FString& SubscriberId, FMCPEventSubscriber& Subscriber, const FHttpResultCallback& OnComplete, EMCPEventFormat Format, bool bIncludeEvents)
+{
+	const int32 EventCount = bIncludeEvents ? FMath::Min(Subscriber.Buffer.Num(), MaxEventsPerResponse) : 0;
+	const int64 ReportedDropped = bIncludeEvents ? Subscriber.UnreportedDropped : 0;
+	if (bIncludeEvents)
+	{
+		Subscriber.UnreportedDropped = 0;
+	}
+
+	FString Body;
+	if (Format == EMCPEventFormat::ServerSentEvents)
+	{
+		Body = FString::Printf(TEXT("retry: %d\n\n"), SSERetryMs);
+		if (ReportedDropped > 0)
+		{
+			// No id, so the client's Last-Event-ID still points at a real event
+			Body += FString::Printf(TEXT("event: dropped\ndata: {\"dropped\":%lld,\"dropped_total\":%lld}\n\n"), ReportedDropped, Subscriber.Dropped);
+		}
+		for (int32 Index = 0; Index < EventCount; ++Index)
+		{
+			const FMCPEvent& Event = *Subscriber.Buffer[Index];
+			Body += FString::Printf(TEXT("id: %llu\nevent: %s\ndata: "), Event.Id, GetTopicName(Event.Topic));
+			Body += Event.Data;
+			Body += TEXT("\n\n");
+		}
+		if (EventCount == 0 && ReportedDropped == 0)
+		{
+			Body += TEXT(": no events\n\n");
+		}
+	}
+	else
+	{
+		// Event data is already JSON text, so the envelope is written around it rather than re-parsed
+		Body = FString::Printf(TEXT("{\"subscriber\":\"%s\",\"dropped\":%lld,\"dropped_total\":%lld,\"events\":["),
+			*SubscriberId, ReportedDropped, Subscriber.Dropped);
+		for (int32 Index = 0; Index < EventCount; ++Index)
+		{
+			const FMCPEvent& Event = *Subscriber.Buffer[Index];
+			Body += FString::Printf(TEXT("%s{\"id\":%llu,\"type\":\"%s\",\"data\":"), Index > 0 ? TEXT(",") : TEXT(""), Event.Id, GetTopicName(Event.Topic));
+			Body += Event.Data;
+			Body += TEXT("}");
+		}
+		Body += FString::Printf(TEXT("],\"last_event_id\":%llu}"), EventCount > 0 ? Subscriber.Buffer[EventCount - 1]->Id : Subscriber.DeliveredThroughId);
+	}
+
+	if (EventCount > 0)
+	{
+		Subscriber.DeliveredThroughId = Subscriber.Buffer[EventCount - 1]->Id;
+		DeliveredEvents += EventCount;
+	}
+
+	const TCHAR* ContentType = Format == EMCPEventFormat::ServerSentEvents ? TEXT("text/event-stream; charset=utf-8") : TEXT("application/json");
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Body, ContentType);
+	Response->Code = EHttpServerResponseCodes::Ok;
+	Response->Headers.Add(TEXT("Cache-Control"), { TEXT("no-cache") });
+	OnComplete(MoveTemp(Response));
+}
+
+void FMCPEventHub::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	int32 PendingPolls = 0;
+	int32 AttachedSubscribers = 0;
+	int32 BufferedEvents = 0;
+	for (const TPair<FString, FMCPEventSubscriber>& Pair : Subscribers)
+	{
+		PendingPolls += Pair.Value.PendingPoll ? 1 : 0;
+		AttachedSubscribers += Pair.Value.Sink ? 1 : 0;
+		BufferedEvents += Pair.Value.Buffer.Num();
+	}
+
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutJson->SetNumberField(TEXT("subscribers"), Subscribers.Num());
+	OutJson->SetNumberField(TEXT("max_subscribers"), Settings->MaxEventSubscribers);
+	OutJson->SetNumberField(TEXT("pending_polls"), PendingPolls);
+	OutJson->SetNumberField(TEXT("attached"), AttachedSubscribers);
+	OutJson->SetNumberField(TEXT("buffered"), BufferedEvents);
+	OutJson->SetNumberField(TEXT("buffer_size"), Settings->EventBufferSize);
+	OutJson->SetNumberField(TEXT("published"), static_cast<double>(PublishedEvents));
+	OutJson->SetNumberField(TEXT("delivered"), static_cast<double>(DeliveredEvents));
+	OutJson->SetNumberField(TEXT("dropped"), static_cast<double>(DroppedEvents));
+	OutJson->SetNumberField(TEXT("expired_subscribers"), static_cast<double>(ExpiredSubscribers));
+	OutJson->SetNumberField(TEXT("evicted_subscribers"), static_cast<double>(EvictedSubscribers));
+	OutJson->SetNumberField(TEXT("last_event_id"), static_cast<double>(NextEventId - 1));
+}
+
+bool FMCPEventHub::IsValidSubscriberId(const FString& SubscriberId)
+{
+	if (SubscriberId.IsEmpty() || SubscriberId.Len() > MaxSubscriberIdLength)
+	{
+		return false;
+	}
+	for (const TCHAR Character : SubscriberId)
+	{
+		if (!FChar::IsAlnum(Character) && Character != TEXT('.') && Character != TEXT('_') && Character != TEXT('-'))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FMCPEventHub::ParseTopics(const FString& Topics, uint32& OutTopicMask)
+{
+	OutTopicMask = 0;
+
+	TArray<FString> TopicNames;
+	Topics.ParseIntoArray(TopicNames, TEXT(","));
+	for (FString& TopicName : TopicNames)
+	{
+		TopicName.TrimStartAndEndInline();
+		bool bFound = false;
+		for (int32 TopicIndex = 0; TopicIndex < static_cast<int32>(EMCPEventTopic::Count); ++TopicIndex)
+		{
+			const EMCPEventTopic Topic = static_cast<EMCPEventTopic>(TopicIndex);
+			if (TopicName.Equals(GetTopicName(Topic), ESearchCase::IgnoreCase))
+			{
+				OutTopicMask |= GetTopicBit(Topic);
+				bFound = true;
+			}
+		}
+		if (!bFound)
+		{
+			return false;
+		}
+	}
+
+	if (OutTopicMask == 0)
+	{
+		OutTopicMask = (1u << static_cast<uint32>(EMCPEventTopic::Count)) - 1;
+	}
+	return true;
+}
+
+const TCHAR* FMCPEventHub::GetTopicName(EMCPEventTopic Topic)
+{
+	switch (Topic)
+	{
+	case EMCPEventTopic::Job:
+		return TEXT("job");
+	case EMCPEventTopic::Compile:
+		return TEXT("compile");
+	case EMCPEventTopic::Log:
+		return TEXT("log");
+	default:
+		return TEXT("unknown");
+	}
+}
@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/RingBuffer.h"
+#include "Containers/Ticker.h"
+#include "HttpResultCallback.h"
+
+class FJsonObject;
+
+/** Event stream a subscriber can filter on */
+enum class EMCPEventTopic : uint8
+{
+	/** Job state changes: queued, running, completed, cancelled, expired, shutdown, rejected */
+	Job,
+	/** Compile results of /add_node and /stamp jobs */
+	Compile,
+	/** Request-log entries, one per answered request */
+	Log,
+	Count
+};
+
+/** Body format of an /events response */
+enum class EMCPEventFormat : uint8
+{
+	/** text/event-stream, readable by EventSource */
+	ServerSentEvents,
+	/** One JSON object with an "events" array */
+	Json
+};
+
+/**
+ * One published event, shared by every subscriber buffer it was added to
+ */
+struct FMCPEvent
+{
+	/** Unique, increasing ID; sent as the SSE "id" and acknowledged through Last-Event-ID */
+	uint64 Id = 0;
+
+	EMCPEventTopic Topic = EMCPEventTopic::Job;
+
+	/** Data serialized once as condensed JSON, so it fits on one SSE data line */
+	FString Data;
+};
+
+/**
+ * Receives events pushed to an attached subscriber, e.g. a WebSocket connection
+ * Events are oldest first and already acknowledged; Dropped counts events lost since the last call.
+ * Called from the hub's tick and must not call back into the hub.
+ */
+using FMCPEventSink = TFunction<void(const TArray<TSharedPtr<const FMCPEvent>>& Events, int64 Dropped)>;
+
+/**
+ * A client watching the event stream, identified by the ID it polls with
+ */
+struct FMCPEventSubscriber
+{
+	/** Events published since the subscriber was created and not yet acknowledged, oldest first */
+	TRingBuffer<TSharedPtr<const FMCPEvent>> Buffer;
+
+	/** Bit per EMCPEventTopic */
+	uint32 TopicMask = 0;
+
+	/** Highest event ID sent in a response */
+	uint64 DeliveredThroughId = 0;
+
+	/** Events dropped because the buffer was full; the unreported part is sent with the next response */
+	int64 Dropped = 0;
+	int64 UnreportedDropped = 0;
+
+	/** Poll waiting for an event, answered by Tick */
+	FHttpResultCallback PendingPoll;
+	EMCPEventFormat PendingFormat = EMCPEventFormat::ServerSentEvents;
+	double PollDeadlineSeconds = 0.0;
+
+	/** FPlatformTime::Seconds of the last poll, for idle expiry */
+	double LastPollSeconds = 0.0;
+
+	/** Set for attached subscribers, which are pushed to on every tick instead of polling and never expire */
+	FMCPEventSink Sink;
+};
+
+/**
+ * Publish/subscribe hub behind the /events route, configured in UUnrealMCPSettings.
+ * The HTTP server only sends complete responses, so streaming is done by long polling: a poll is
+ * held until an event arrives or its timeout passes, and the response is a text/event-stream body
+ * that EventSource clients read before reconnecting with Last-Event-ID. Each subscriber has its own
+ * bounded buffer; a reader that falls behind loses the oldest events and is told how many.
+ * Game thread only.
+ */
+class FMCPEventHub
+{
+public:
+	FMCPEventHub();
+	~FMCPEventHub();
+
+	/** Whether any subscriber listens to a topic; lets publishers skip building event data */
+	bool HasSubscribers(EMCPEventTopic Topic) const;
+
+	/**
+	 * Add an event to the buffer of every subscriber listening to its topic
+	 * Waiting polls are answered on the next tick, so events published in the same frame share one response
+	 */
+	void Publish(EMCPEventTopic Topic, const TSharedRef<FJsonObject>& Data);
+
+	/**
+	 * Handle one poll
+	 * Events up to LastEventId are acknowledged and removed from the buffer; with no LastEventId, everything sent
+	 * before is. Remaining events are answered at once, otherwise the poll waits up to TimeoutSeconds.
+	 * @param SubscriberId Client-chosen ID, see IsValidSubscriberId; unknown IDs create a subscriber
+	 * @param LastEventId Last event the client received, or 0 if it did not say
+	 * @param TopicMask Bit per EMCPEventTopic
+	 * @param TimeoutSeconds How long to hold the poll when there is nothing to send (0 = answer at once)
+	 * @param Format Response body format
+	 * @param OnComplete Callback to send response
+	 * @return False if the subscriber limit is reached and every subscriber has a poll waiting
+	 */
+	bool Poll(const FString& SubscriberId, uint64 LastEventId, uint32 TopicMask, double TimeoutSeconds, EMCPEventFormat Format, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Attach a push subscriber; its events are handed to Sink on the next tick and acknowledged at once
+	 * Attaching an existing ID replaces its topics and sink.
+	 * @return False if the subscriber limit is reached and no idle subscriber can be evicted
+	 */
+	bool Attach(const FString& SubscriberId, uint32 TopicMask, FMCPEventSink Sink);
+
+	/** Forget an attached subscriber without flushing its buffer */
+	void Detach(const FString& SubscriberId);
+
+	/** Answer every waiting poll, flush attached subscribers and forget all subscribers, e.g. when the server stops */
+	void CloseAll();
+
+	/** Write subscriber, event and drop counters */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+	/** Subscriber IDs are 1-64 characters of [A-Za-z0-9._-], so they can be echoed into responses unescaped */
+	static bool IsValidSubscriberId(const FString& SubscriberId);
+
+	/**
+	 * Parse a comma-separated topic list such as "job,compile"
+	 * @return False if a name is not a topic; an empty list selects every topic
+	 */
+	static bool ParseTopics(const FString& Topics, uint32& OutTopicMask);
+
+	/** Topic name used as the SSE event type and in JSON responses */
+	static const TCHAR* GetTopicName(EMCPEventTopic Topic);
+
+	/** Events sent in one response; the rest follow on the next poll */
+	static constexpr int32 MaxEventsPerResponse = 500;
+
+private:
+	/** Answer waiting polls that have events or have timed out, push to attached subscribers and expire idle subscribers */
+	bool Tick(float DeltaTime);
+
+	/**
+	 * Find a subscriber, creating it if needed
+	 * At the subscriber limit, the idle subscriber that has gone longest without polling is evicted first.
+	 * @return Null if the limit is reached and every subscriber has a poll waiting or is attached
+	 */
+	FMCPEventSubscriber* FindOrAddSubscriber(const FString& SubscriberId, double NowSeconds);
+
+	/** Hand buffered events of an attached subscriber to its sink, up to MaxEventsPerResponse */
+	void Push(FMCPEventSubscriber& Subscriber);
+
+	/**
+	 * Answer a poll
+	 * @param bIncludeEvents False to answer with an empty body, e.g. for a poll replaced by a newer one whose connection is likely gone
+	 */
+	void Respond(const FString& SubscriberId, FMCPEventSubscriber& Subscriber, const FHttpResultCallback& OnComplete, EMCPEventFormat Format, bool bIncludeEvents);
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	TMap<FString, FMCPEventSubscriber> Subscribers;
+	uint64 NextEventId = 1;
+
+	/** Counters */
+	int64 PublishedEvents = 0;
+	int64 DeliveredEvents = 0;
+	int64 DroppedEvents = 0;
+	int64 ExpiredSubscribers = 0;
+	int64 EvictedSubscribers = 0;
+};
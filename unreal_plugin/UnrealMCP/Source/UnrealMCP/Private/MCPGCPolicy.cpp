@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPGCPolicy.h"
+#include "IUnrealMCP.h"
+#include "UnrealMCPSettings.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreMisc.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/** Pauses longer than this are logged as warnings */
+	constexpr double SlowPauseSeconds = 0.1;
+}
+
+TSharedRef<FMCPGCPolicy> FMCPGCPolicy::GetShared()
+{
+	static TWeakPtr<FMCPGCPolicy> SharedPolicy;
+
+	TSharedPtr<FMCPGCPolicy> Policy = SharedPolicy.Pin();
+	if (!Policy.IsValid())
+	{
+		Policy = MakeShareable(new FMCPGCPolicy());
+		SharedPolicy = Policy;
+	}
+	return Policy.ToSharedRef();
+}
+
+FMCPGCPolicy::FMCPGCPolicy()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPGCPolicy::Tick));
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FMCPGCPolicy::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FMCPGCPolicy::OnPostGarbageCollect);
+	UsedPhysicalAtCollection = FPlatformMemory::GetStats().UsedPhysical;
+}
+
+FMCPGCPolicy::~FMCPGCPolicy()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+}
+
+void FMCPGCPolicy::BeginBatch()
+{
+	++BatchDepth;
+}
+
+void FMCPGCPolicy::EndBatch()
+{
+	BatchDepth = FMath::Max(BatchDepth - 1, 0);
+	if (BatchDepth == 0 && PendingCollectionReason)
+	{
+		ForceCollection();
+	}
+	LastBatchEndSeconds = FPlatformTime::Seconds();
+}
+
+bool FMCPGCPolicy::IsInBurst() const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	return BatchDepth > 0 || FPlatformTime::Seconds() - LastBatchEndSeconds < Settings->GCBurstGraceSeconds;
+}
+
+void FMCPGCPolicy::NotifyAssetCreated()
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	if (!Settings->bManageGarbageCollection)
+	{
+		return;
+	}
+
+	++AssetsSinceCollection;
+	if (PendingCollectionReason)
+	{
+		return;
+	}
+
+	// The collection itself waits for EndBatch or Tick: the batch may still hold what it created by raw pointer
+	if (Settings->GCCollectAfterOperations > 0 && AssetsSinceCollection >= Settings->GCCollectAfterOperations)
+	{
+		PendingCollectionReason = TEXT("operation count");
+		return;
+	}
+
+	if (Settings->GCCollectAfterGrowthMB > 0)
+	{
+		const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		const uint64 GrowthBytes = UsedPhysical > UsedPhysicalAtCollection ? UsedPhysical - UsedPhysicalAtCollection : 0;
+		if (GrowthBytes >= static_cast<uint64>(Settings->GCCollectAfterGrowthMB) * 1024 * 1024)
+		{
+			PendingCollectionReason = TEXT("memory growth");
+		}
+	}
+}
+
+void FMCPGCPolicy::ForceCollection()
+{
+	UE_LOG(LogUnrealMCP, Log, TEXT("Forcing garbage collection after %lld asset(s) (%s)"), AssetsSinceCollection, PendingCollectionReason);
+	PendingCollectionReason = nullptr;
+
+	// In the editor the purge is left to Tick so the pause covers reachability only;
+	// commandlets never tick, so they purge in place
+	const bool bFullPurge = IsRunningCommandlet();
+	if (TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, bFullPurge))
+	{
+		++ForcedCollectionCount;
+	}
+}
+
+bool FMCPGCPolicy::Tick(float DeltaTime)
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	if (!Settings->bManageGarbageCollection)
+	{
+		return true;
+	}
+
+	if (PendingCollectionReason && BatchDepth == 0)
+	{
+		ForceCollection();
+	}
+
+	if (IsInBurst() && GEngine)
+	{
+		// Resets the engine's periodic collection timer for this frame
+		GEngine->DelayGarbageCollection();
+		++DeferredFrameCount;
+	}
+
+	const double BudgetSeconds = Settings->GCFrameBudgetMs / 1000.0;
+	const double SliceStartTime = FPlatformTime::Seconds();
+	if (IsIncrementalReachabilityAnalysisPending())
+	{
+		PerformIncrementalReachabilityAnalysis(BudgetSeconds);
+	}
+	else if (IsIncrementalPurgePending())
+	{
+		IncrementalPurgeGarbage(true, BudgetSeconds);
+	}
+	else
+	{
+		return true;
+	}
+
+	const double SliceSeconds = FPlatformTime::Seconds() - SliceStartTime;
+	MaxSliceSeconds = FMath::Max(MaxSliceSeconds, SliceSeconds);
+	TotalSliceSeconds += SliceSeconds;
+	return true;
+}
+
+void FMCPGCPolicy::OnPreGarbageCollect()
+{
+	// With incremental reachability enabled the pause spans every frame the analysis ran in
+	PauseStartSeconds = FPlatformTime::Seconds();
+}
+
+void FMCPGCPolicy::OnPostGarbageCollect()
+{
+	if (PauseStartSeconds < 0.0)
+	{
+		return;
+	}
+
+	LastPauseSeconds = FPlatformTime::Seconds() - PauseStartSeconds;
+	MaxPauseSeconds = FMath::Max(MaxPauseSeconds, LastPauseSeconds);
+	TotalPauseSeconds += LastPauseSeconds;
+	++CollectionCount;
+	PauseStartSeconds = -1.0;
+
+	// Any collection, forced or not, restarts the thresholds and satisfies a pending request
+	AssetsSinceCollection = 0;
+	PendingCollectionReason = nullptr;
+	UsedPhysicalAtCollection = FPlatformMemory::GetStats().UsedPhysical;
+
+	if (LastPauseSeconds > SlowPauseSeconds)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Garbage collection paused the game thread for %.1f ms"), LastPauseSeconds * 1000.0);
+	}
+	else
+	{
+		UE_LOG(LogUnrealMCP, Verbose, TEXT("Garbage collection took %.1f ms"), LastPauseSeconds * 1000.0);
+	}
+}
+
+void FMCPGCPolicy::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutJson->SetBoolField(TEXT("managed"), Settings->bManageGarbageCollection);
+	OutJson->SetBoolField(TEXT("deferring"), Settings->bManageGarbageCollection && IsInBurst());
+	OutJson->SetNumberField(TEXT("collections"), CollectionCount);
+	OutJson->SetNumberField(TEXT("forced_collections"), ForcedCollectionCount);
+	OutJson->SetNumberField(TEXT("deferred_frames"), DeferredFrameCount);
+	OutJson->SetNumberField(TEXT("assets_since_collection"), static_cast<double>(AssetsSinceCollection));
+	OutJson->SetBoolField(TEXT("collection_pending"), PendingCollectionReason != nullptr);
+	OutJson->SetNumberField(TEXT("last_pause_ms"), LastPauseSeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("max_pause_ms"), MaxPauseSeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("mean_pause_ms"), CollectionCount > 0 ? TotalPauseSeconds * 1000.0 / CollectionCount : 0.0);
+	OutJson->SetNumberField(TEXT("max_incremental_slice_ms"), MaxSliceSeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("total_incremental_ms"), TotalSliceSeconds * 1000.0);
+}
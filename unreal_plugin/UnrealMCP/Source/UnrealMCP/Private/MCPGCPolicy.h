@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FJsonObject;
+
+/**
+ * Garbage collection policy for bursts of MCP operations, configured in UUnrealMCPSettings.
+ * While operations are arriving the engine's periodic collection is deferred; instead a collection
+ * is forced after a number of created assets or an amount of RSS growth, its reachability analysis
+ * and purge are advanced within a per-frame budget, and every GC pause is recorded for /status.
+ * A forced collection waits until no batch is open, so objects a batch holds by raw pointer stay valid.
+ * One instance is shared by every operation runner, since each registers a ticker and global GC delegates.
+ */
+class FMCPGCPolicy
+{
+public:
+	/** The shared policy, created on first use and destroyed with its last holder */
+	static TSharedRef<FMCPGCPolicy> GetShared();
+
+	~FMCPGCPolicy();
+
+	/** Mark the start of a batch of operations; batches may nest */
+	void BeginBatch();
+
+	/** Mark the end of a batch; runs a collection requested during it, then defers for the configured grace period */
+	void EndBatch();
+
+	/** Count a created asset and request a collection if a threshold has been reached */
+	void NotifyAssetCreated();
+
+	/** Write collection counts and pause times */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	FMCPGCPolicy();
+
+	/** Per-frame work: defer engine GC during bursts and advance pending incremental GC within the budget */
+	bool Tick(float DeltaTime);
+
+	/** Start the requested collection; commandlets purge fully since nothing ticks the incremental purge */
+	void ForceCollection();
+
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
+	/** Whether engine collections should currently be deferred */
+	bool IsInBurst() const;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+
+	/** Batch state */
+	int32 BatchDepth = 0;
+	double LastBatchEndSeconds = 0.0;
+
+	/** Progress towards the next forced collection */
+	int64 AssetsSinceCollection = 0;
+	uint64 UsedPhysicalAtCollection = 0;
+
+	/** Why a collection was requested, or null; it runs once no batch is open */
+	const TCHAR* PendingCollectionReason = nullptr;
+
+	/** Pause and work accounting */
+	double PauseStartSeconds = -1.0;
+	int32 CollectionCount = 0;
+	int32 ForcedCollectionCount = 0;
+	int32 DeferredFrameCount = 0;
+	double LastPauseSeconds = 0.0;
+	double MaxPauseSeconds = 0.0;
+	double TotalPauseSeconds = 0.0;
+	double MaxSliceSeconds = 0.0;
+	double TotalSliceSeconds = 0.0;
+};
+
+/**
+ * Holds an FMCPGCPolicy batch open for the lifetime of the scope
+ */
+class FMCPGCBatchScope
+{
+public:
+	explicit FMCPGCBatchScope(FMCPGCPolicy& InPolicy)
+		: Policy(InPolicy)
+	{
+		Policy.BeginBatch();
+	}
+
+	~FMCPGCBatchScope()
+	{
+		Policy.EndBatch();
+	}
+
+private:
+	FMCPGCPolicy& Policy;
+};
@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPGraphExporter.h"
+#include "IUnrealMCP.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+#if WITH_EDITOR
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#endif
+
+namespace
+{
+	/** Writer that emits UTF-8 straight into a byte archive */
+	typedef TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FMCPUtf8JsonWriter;
+	typedef TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>> FMCPUtf8JsonWriterFactory;
+
+#if WITH_EDITOR
+	const TCHAR* PinDirectionToString(EEdGraphPinDirection Direction)
+	{
+		return Direction == EGPD_Output ? TEXT("output") : TEXT("input");
+	}
+
+	void WritePin(FMCPUtf8JsonWriter& Writer, const UEdGraphPin* Pin)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("id"), Pin->PinId.ToString());
+		Writer.WriteValue(TEXT("name"), Pin->PinName.ToString());
+		Writer.WriteValue(TEXT("direction"), PinDirectionToString(Pin->Direction));
+		Writer.WriteValue(TEXT("category"), Pin->PinType.PinCategory.ToString());
+
+		if (!Pin->PinType.PinSubCategory.IsNone())
+		{
+			Writer.WriteValue(TEXT("sub_category"), Pin->PinType.PinSubCategory.ToString());
+		}
+		if (const UObject* SubCategoryObject = Pin->PinType.PinSubCategoryObject.Get())
+		{
+			Writer.WriteValue(TEXT("sub_category_object"), SubCategoryObject->GetPathName());
+		}
+		if (Pin->PinType.IsContainer())
+		{
+			Writer.WriteValue(TEXT("is_array"), Pin->PinType.IsArray());
+		}
+
+		// Default values are only written when set to keep the common case small
+		if (!Pin->DefaultValue.IsEmpty())
+		{
+			Writer.WriteValue(TEXT("default_value"), Pin->DefaultValue);
+		}
+		if (Pin->DefaultObject)
+		{
+			Writer.WriteValue(TEXT("default_object"), Pin->DefaultObject->GetPathName());
+		}
+		if (!Pin->DefaultTextValue.IsEmpty())
+		{
+			Writer.WriteValue(TEXT("default_text"), Pin->DefaultTextValue.ToString());
+		}
+		if (Pin->bHidden)
+		{
+			Writer.WriteValue(TEXT("hidden"), true);
+		}
+
+		Writer.WriteArrayStart(TEXT("links"));
+		for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+		{
+			if (!LinkedPin || !LinkedPin->GetOwningNodeUnchecked())
+			{
+				continue;
+			}
+
+			Writer.WriteObjectStart();
+			Writer.WriteValue(TEXT("node"), LinkedPin->GetOwningNode()->NodeGuid.ToString());
+			Writer.WriteValue(TEXT("pin"), LinkedPin->PinId.ToString());
+			Writer.WriteObjectEnd();
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteObjectEnd();
+	}
+
+	void WriteNode(FMCPUtf8JsonWriter& Writer, const UEdGraph* Graph, const UEdGraphNode* Node, int32 Index)
+	{
+		Writer.WriteObjectStart();
+		Writer.WriteValue(TEXT("index"), Index);
+		Writer.WriteValue(TEXT("guid"), Node->NodeGuid.ToString());
+		Writer.WriteValue(TEXT("class"), Node->GetClass()->GetName());
+		Writer.WriteValue(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+		Writer.WriteValue(TEXT("graph"), Graph->GetName());
+		Writer.WriteValue(TEXT("pos_x"), Node->NodePosX);
+		Writer.WriteValue(TEXT("pos_y"), Node->NodePosY);
+		if (!Node->NodeComment.IsEmpty())
+		{
+			Writer.WriteValue(TEXT("comment"), Node->NodeComment);
+		}
+
+		Writer.WriteArrayStart(TEXT("pins"));
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin)
+			{
+				WritePin(Writer, Pin);
+			}
+		}
+		Writer.WriteArrayEnd();
+
+		Writer.WriteObjectEnd();
+	}
+#endif
+
+	void WriteNewline(FArchive& Archive)
+	{
+		uint8 Newline = '\n';
+		Archive.Serialize(&Newline, 1);
+	}
+}
+
+bool FMCPGraphExporter::ParseFormat(const FString& FormatName, EMCPGraphExportFormat& OutFormat)
+{
+	if (FormatName.IsEmpty() || FormatName.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EMCPGraphExportFormat::Json;
+		return true;
+	}
+	if (FormatName.Equals(TEXT("ndjson"), ESearchCase::IgnoreCase))
+	{
+		OutFormat = EMCPGraphExportFormat::NDJson;
+		return true;
+	}
+	return false;
+}
+
+void FMCPGraphExporter::GatherGraphs(UBlueprint* Blueprint, const FString& GraphName, TArray<UEdGraph*>& OutGraphs)
+{
+#if WITH_EDITOR
+	TArray<UEdGraph*> AllGraphs;
+	AllGraphs.Append(Blueprint->UbergraphPages);
+	AllGraphs.Append(Blueprint->FunctionGraphs);
+	AllGraphs.Append(Blueprint->MacroGraphs);
+
+	for (UEdGraph* Graph : AllGraphs)
+	{
+		if (Graph && (GraphName.IsEmpty() || Graph->GetName() == GraphName))
+		{
+			OutGraphs.Add(Graph);
+		}
+	}
+#endif
+}
+
+bool FMCPGraphExporter::ExportWindow(UBlueprint* Blueprint, const FString& BlueprintPath, const FMCPGraphExportOptions& Options, FMCPGraphExportResult& OutResult)
+{
+#if WITH_EDITOR
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	TArray<UEdGraph*> Graphs;
+	GatherGraphs(Blueprint, Options.GraphName, Graphs);
+	if (Graphs.Num() == 0)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("No graph named '%s' in %s"), *Options.GraphName, *BlueprintPath);
+		return false;
+	}
+
+	OutResult = FMCPGraphExportResult();
+	for (const UEdGraph* Graph : Graphs)
+	{
+		OutResult.TotalNodes += Graph->Nodes.Num();
+	}
+
+	const int32 Cursor = FMath::Max(Options.Cursor, 0);
+	const int32 MaxNodes = FMath::Max(Options.MaxNodes, 1);
+	const bool bNDJson = Options.Format == EMCPGraphExportFormat::NDJson;
+
+	FMemoryWriter Archive(OutResult.Body);
+
+	// In JSON mode a single writer wraps the whole window; in NDJSON mode each node gets its own line
+	TSharedPtr<FMCPUtf8JsonWriter> Writer;
+	if (!bNDJson)
+	{
+		Writer = FMCPUtf8JsonWriterFactory::Create(&Archive);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("success"), true);
+		Writer->WriteValue(TEXT("blueprint_path"), BlueprintPath);
+		Writer->WriteValue(TEXT("total_nodes"), OutResult.TotalNodes);
+		Writer->WriteValue(TEXT("cursor"), Cursor);
+		Writer->WriteArrayStart(TEXT("nodes"));
+	}
+
+	int32 Index = 0;
+	bool bWindowFull = false;
+	for (const UEdGraph* Graph : Graphs)
+	{
+		// Skip whole graphs that lie before the cursor without touching their nodes
+		if (Index + Graph->Nodes.Num() <= Cursor)
+		{
+			Index += Graph->Nodes.Num();
+			continue;
+		}
+
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Index < Cursor)
+			{
+				++Index;
+				continue;
+			}
+
+			if (bWindowFull)
+			{
+				OutResult.NextCursor = Index;
+				break;
+			}
+
+			if (Node)
+			{
+				if (bNDJson)
+				{
+					TSharedRef<FMCPUtf8JsonWriter> LineWriter = FMCPUtf8JsonWriterFactory::Create(&Archive);
+					WriteNode(*LineWriter, Graph, Node, Index);
+					LineWriter->Close();
+					WriteNewline(Archive);
+				}
+				else
+				{
+					WriteNode(*Writer, Graph, Node, Index);
+				}
+				++OutResult.NodesWritten;
+			}
+			++Index;
+
+			bWindowFull = OutResult.NodesWritten >= MaxNodes || OutResult.Body.Num() >= Options.MaxBytes;
+		}
+
+		if (OutResult.NextCursor != INDEX_NONE)
+		{
+			break;
+		}
+	}
+
+	if (bNDJson)
+	{
+		// Trailer line carries the pagination state
+		TSharedRef<FMCPUtf8JsonWriter> TrailerWriter = FMCPUtf8JsonWriterFactory::Create(&Archive);
+		TrailerWriter->WriteObjectStart();
+		TrailerWriter->WriteValue(TEXT("blueprint_path"), BlueprintPath);
+		TrailerWriter->WriteValue(TEXT("total_nodes"), OutResult.TotalNodes);
+		TrailerWriter->WriteValue(TEXT("nodes_written"), OutResult.NodesWritten);
+		if (OutResult.NextCursor != INDEX_NONE)
+		{
+			TrailerWriter->WriteValue(TEXT("next_cursor"), OutResult.NextCursor);
+		}
+		else
+		{
+			TrailerWriter->WriteNull(TEXT("next_cursor"));
+		}
+		TrailerWriter->WriteObjectEnd();
+		TrailerWriter->Close();
+		WriteNewline(Archive);
+	}
+	else
+	{
+		Writer->WriteArrayEnd();
+		Writer->WriteValue(TEXT("nodes_written"), OutResult.NodesWritten);
+		if (OutResult.NextCursor != INDEX_NONE)
+		{
+			Writer->WriteValue(TEXT("next_cursor"), OutResult.NextCursor);
+		}
+		else
+		{
+			Writer->WriteNull(TEXT("next_cursor"));
+		}
+		Writer->WriteObjectEnd();
+		Writer->Close();
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
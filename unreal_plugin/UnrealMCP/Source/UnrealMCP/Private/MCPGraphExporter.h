@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphPin;
+
+/** Output format for graph exports */
+enum class EMCPGraphExportFormat : uint8
+{
+	/** Single JSON object with a "nodes" array */
+	Json,
+	/** Newline-delimited JSON, one node per line followed by a trailer line */
+	NDJson
+};
+
+/**
+ * Options for a single export window
+ */
+struct FMCPGraphExportOptions
+{
+	/** Only export the graph with this name (all graphs when empty) */
+	FString GraphName;
+
+	/** Index of the first node to export, across all exported graphs */
+	int32 Cursor = 0;
+
+	/** Maximum number of nodes written in one window */
+	int32 MaxNodes = 500;
+
+	/** Soft limit on the encoded body size; the window ends after the node that crosses it */
+	int32 MaxBytes = 1024 * 1024;
+
+	EMCPGraphExportFormat Format = EMCPGraphExportFormat::Json;
+};
+
+/**
+ * Result of an export window
+ */
+struct FMCPGraphExportResult
+{
+	/** UTF-8 encoded body, ready to hand to FHttpServerResponse */
+	TArray<uint8> Body;
+
+	/** Total number of nodes in the exported graphs */
+	int32 TotalNodes = 0;
+
+	/** Number of nodes written to this window */
+	int32 NodesWritten = 0;
+
+	/** Cursor for the next window, or INDEX_NONE when the export is complete */
+	int32 NextCursor = INDEX_NONE;
+};
+
+/**
+ * Walks Blueprint graphs and writes nodes, pins, links and default values straight to a
+ * UTF-8 buffer without building an intermediate FJsonObject DOM.
+ * Memory use is bounded by the window size rather than by the size of the graph.
+ */
+class FMCPGraphExporter
+{
+public:
+	/**
+	 * Export one window of nodes from a Blueprint
+	 * @param Blueprint The Blueprint to export
+	 * @param BlueprintPath The path the client asked for, echoed back in the output
+	 * @param Options Window and format options
+	 * @param OutResult Receives the encoded body and cursor information
+	 * @return True if the requested graph was found
+	 */
+	static bool ExportWindow(UBlueprint* Blueprint, const FString& BlueprintPath, const FMCPGraphExportOptions& Options, FMCPGraphExportResult& OutResult);
+
+	/**
+	 * Parse a format name ("json" or "ndjson")
+	 * @return True if the name was recognised
+	 */
+	static bool ParseFormat(const FString& FormatName, EMCPGraphExportFormat& OutFormat);
+
+private:
+	/** Collect the graphs to export, in a stable order */
+	static void GatherGraphs(UBlueprint* Blueprint, const FString& GraphName, TArray<UEdGraph*>& OutGraphs);
+};
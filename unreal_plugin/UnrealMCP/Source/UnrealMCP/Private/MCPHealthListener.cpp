@@ -0,0 +1,196 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPHealthListener.h"
+#include "IUnrealMCP.h"
+#include "MCPStatusSnapshot.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+
+namespace
+{
+	/** Largest request head accepted; health probes are a single short GET */
+	constexpr int32 MaxRequestBytes = 4096;
+
+	/** How long a client may take to send its request before the connection is dropped */
+	const FTimespan ReadTimeout = FTimespan::FromMilliseconds(200);
+
+	/** How often the listener thread checks for shutdown while idle */
+	const FTimespan AcceptPollInterval = FTimespan::FromMilliseconds(100);
+
+	void SendResponse(FSocket* Socket, int32 Code, const TCHAR* Reason, const FString& Body)
+	{
+		const FTCHARToUTF8 BodyUtf8(*Body);
+		const FString Head = FString::Printf(
+			TEXT("HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %d\r\nCache-Control: no-store\r\nConnection: close\r\n\r\n"),
+			Code, Reason, BodyUtf8.Length());
+		const FTCHARToUTF8 HeadUtf8(*Head);
+
+		TArray<uint8> Bytes;
+		Bytes.Append(reinterpret_cast<const uint8*>(HeadUtf8.Get()), HeadUtf8.Length());
+		Bytes.Append(reinterpret_cast<const uint8*>(BodyUtf8.Get()), BodyUtf8.Length());
+
+		int32 Offset = 0;
+		while (Offset < Bytes.Num())
+		{
+			int32 BytesSent = 0;
+			if (!Socket->Send(Bytes.GetData() + Offset, Bytes.Num() - Offset, BytesSent) || BytesSent <= 0)
+			{
+				return;
+			}
+			Offset += BytesSent;
+		}
+	}
+}
+
+FMCPHealthListener::FMCPHealthListener(FMCPStatusSnapshot& InSnapshot)
+	: Snapshot(InSnapshot)
+{
+}
+
+FMCPHealthListener::~FMCPHealthListener()
+{
+	Stop();
+}
+
+bool FMCPHealthListener::Start(uint32 InPort)
+{
+	Stop();
+
+	const FIPv4Endpoint Endpoint(FIPv4Address::InternalLoopback, static_cast<uint16>(InPort));
+	ListenSocket = FTcpSocketBuilder(TEXT("UnrealMCPHealth"))
+		.AsReusable()
+		.BoundToEndpoint(Endpoint)
+		.Listening(16);
+	if (!ListenSocket)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to bind health listener on port %d"), InPort);
+		return false;
+	}
+
+	// Everything Run reads is set before the thread starts
+	bStopping = false;
+	Port = InPort;
+	Thread.Reset(FRunnableThread::Create(this, TEXT("UnrealMCPHealthListener"), 0, TPri_BelowNormal));
+	if (!Thread.IsValid())
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to start health listener thread"));
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+		Port = 0;
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("MCP health listener started on port %d"), Port);
+	return true;
+}
+
+void FMCPHealthListener::Stop()
+{
+	if (!Thread.IsValid())
+	{
+		return;
+	}
+
+	// Run checks the flag between accept polls; once joined, no connection is being handled
+	bStopping = true;
+	TUniquePtr<FRunnableThread> StoppedThread = MoveTemp(Thread);
+	StoppedThread->WaitForCompletion();
+	StoppedThread.Reset();
+
+	ListenSocket->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+	ListenSocket = nullptr;
+	Port = 0;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("MCP health listener stopped"));
+}
+
+uint32 FMCPHealthListener::Run()
+{
+	while (!bStopping)
+	{
+		bool bPending = false;
+		if (!ListenSocket->WaitForPendingConnection(bPending, AcceptPollInterval))
+		{
+			FPlatformProcess::Sleep(AcceptPollInterval.GetTotalSeconds());
+			continue;
+		}
+
+		if (bPending)
+		{
+			if (FSocket* ConnectionSocket = ListenSocket->Accept(TEXT("UnrealMCPHealthConnection")))
+			{
+				HandleConnection(ConnectionSocket);
+			}
+		}
+	}
+	return 0;
+}
+
+void FMCPHealthListener::HandleConnection(FSocket* Socket)
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// Read up to the end of the request head; the body, if any, is ignored
+	TArray<uint8> RequestBytes;
+	RequestBytes.Reserve(512);
+	bool bHeadComplete = false;
+	while (!bHeadComplete && RequestBytes.Num() < MaxRequestBytes && Socket->Wait(ESocketWaitConditions::WaitForRead, ReadTimeout))
+	{
+		uint8 Buffer[1024];
+		int32 BytesRead = 0;
+		if (!Socket->Recv(Buffer, sizeof(Buffer), BytesRead) || BytesRead <= 0)
+		{
+			break;
+		}
+		RequestBytes.Append(Buffer, BytesRead);
+
+		for (int32 Index = FMath::Max(0, RequestBytes.Num() - BytesRead - 3); Index + 3 < RequestBytes.Num(); ++Index)
+		{
+			if (RequestBytes[Index] == '\r' && RequestBytes[Index + 1] == '\n' && RequestBytes[Index + 2] == '\r' && RequestBytes[Index + 3] == '\n')
+			{
+				bHeadComplete = true;
+				break;
+			}
+		}
+	}
+
+	if (bHeadComplete)
+	{
+		RequestBytes.Add(0);
+		const FString RequestHead = FString(FUTF8ToTCHAR(reinterpret_cast<const char*>(RequestBytes.GetData())));
+
+		// "GET /status?x=y HTTP/1.1"
+		FString RequestLine;
+		RequestHead.Split(TEXT("\r\n"), &RequestLine, nullptr);
+		TArray<FString> Parts;
+		RequestLine.ParseIntoArray(Parts, TEXT(" "));
+
+		FString Path = Parts.Num() >= 2 ? Parts[1] : FString();
+		Path.Split(TEXT("?"), &Path, nullptr);
+
+		FString Body;
+		if (Parts.Num() < 2 || Parts[0] != TEXT("GET") || (Path != TEXT("/status") && Path != TEXT("/health")))
+		{
+			SendResponse(Socket, 404, TEXT("Not Found"), TEXT("{\"success\":false,\"message\":\"The health port only serves GET /status and GET /health\"}"));
+		}
+		else if (!Snapshot.Serialize(Body))
+		{
+			SendResponse(Socket, 503, TEXT("Service Unavailable"), TEXT("{\"server_running\":true,\"ready\":false,\"state\":\"starting\",\"source\":\"snapshot\"}"));
+		}
+		else
+		{
+			SendResponse(Socket, 200, TEXT("OK"), Body);
+		}
+
+		Snapshot.RecordLatency(EMCPRequestClass::Health, FPlatformTime::Seconds() - StartSeconds);
+	}
+
+	Socket->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+}
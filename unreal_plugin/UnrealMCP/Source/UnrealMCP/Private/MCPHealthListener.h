@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FMCPStatusSnapshot;
+class FRunnableThread;
+class FSocket;
+
+/**
+ * Minimal HTTP/1.1 listener for health checks, running on its own thread
+ * The HTTPServer module dispatches every route on the game thread, so /status on the main port waits
+ * behind whatever mutation is running. This listener answers GET /status and GET /health from
+ * FMCPStatusSnapshot without touching the game thread. One request per connection.
+ * Bound to loopback only, like the probes it serves.
+ */
+class FMCPHealthListener : public FRunnable
+{
+public:
+	explicit FMCPHealthListener(FMCPStatusSnapshot& InSnapshot);
+	~FMCPHealthListener();
+
+	/**
+	 * Start listening
+	 * @param Port The port to listen on
+	 * @return True if the listener is accepting connections
+	 */
+	bool Start(uint32 Port);
+
+	/** Stop listening and join the listener thread; also the FRunnable stop request, so it is idempotent */
+	virtual void Stop() override;
+
+	/** Port being listened on, or 0 if stopped */
+	uint32 GetPort() const { return Port; }
+
+	/** FRunnable implementation: accept and answer connections until stopped (listener thread) */
+	virtual uint32 Run() override;
+
+private:
+	/** Read one request, write the response and close the connection (listener thread) */
+	void HandleConnection(FSocket* Socket);
+
+	/** Snapshot being served; owned by the HTTP server */
+	FMCPStatusSnapshot& Snapshot;
+
+	/** Listening socket, owned here and destroyed by Stop after the thread has exited */
+	FSocket* ListenSocket = nullptr;
+	TUniquePtr<FRunnableThread> Thread;
+	std::atomic<bool> bStopping { false };
+	uint32 Port = 0;
+};
@@ -8,26 +8,40 @@
 #include "HttpServerResponse.h"
 #include "HttpPath.h"
 #include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Engine/Engine.h"
+#include "MCPGraphExporter.h"
+#include "MCPAssetQuery.h"
+#include "MCPMsgPack.h"
+
+#include "MCPOperationRunner.h"
+#include "UnrealMCPSettings.h"
+#include "HAL/PlatformTime.h"
+#include "Async/Async.h"
+#include "IPAddress.h"
 
 #if WITH_EDITOR
-#include "Kismet2/KismetEditorUtilities.h"
-#include "Kismet2/BlueprintEditorUtils.h"
-#include "K2Node_CallFunction.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "EdGraphSchema_K2.h"
 #include "Engine/Blueprint.h"
-#include "BlueprintEditorModule.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "UObject/Package.h"
-#include "UObject/SavePackage.h"
-#include "FileHelpers.h"
 #endif
 
+namespace
+{
+	/** How often the game thread refreshes the snapshot served by the health listener */
+	constexpr float StatusSnapshotIntervalSeconds = 0.1f;
+
+	/** How long an /events poll is held when there is nothing to send, by default and at most */
+	constexpr double DefaultEventPollSeconds = 25.0;
+	constexpr double MaxEventPollSeconds = 60.0;
+}
+
 FMCPHttpServer::FMCPHttpServer()
-	: ServerPort(0)
+	: OperationRunner(MakeUnique<FMCPOperationRunner>())
+	, HealthListener(StatusSnapshot)
+	, WebSocketServer(*this)
+	, CompressionStats(MakeShared<FMCPCompressionStats>())
+	, ServerPort(0)
 	, bIsServerRunning(false)
 {
 }
@@ -45,6 +59,53 @@ bool FMCPHttpServer::StartServer(uint32 Port)
 		return false;
 	}
 
+	const double BindStartTime = FPlatformTime::Seconds();
+	if (!StartListener(Port))
+	{
+		return false;
+	}
+	RouterBindSeconds = FPlatformTime::Seconds() - BindStartTime;
+
+	ServerPort = Port;
+	bIsServerRunning = true;
+
+	// Warm up one stage per tick; /status reports "starting" until all stages have run.
+	// Warm state is kept across stop/start, so only an interrupted warm-up resumes here.
+	const UUnrealMCPSettings* Settings = UUnrealMCPSettings::Get();
+	if (!Settings || Settings->bWarmUpOnStart)
+	{
+		if (!WarmUp.HasStarted())
+		{
+			WarmUp.Begin(&OperationRunner->GetTemplateCache());
+		}
+		if (!WarmUp.IsComplete())
+		{
+			WarmUpTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPHttpServer::TickWarmUp));
+		}
+	}
+
+	// Health checks get their own port and thread so they are answered while a mutation holds the game thread
+	StatusSnapshot.Publish(BuildStatusJson());
+	SnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPHttpServer::TickStatusSnapshot), StatusSnapshotIntervalSeconds);
+	const int32 HealthPort = Settings ? Settings->HealthPort : 0;
+	if (HealthPort > 0 && static_cast<uint32>(HealthPort) != Port)
+	{
+		HealthListener.Start(HealthPort);
+	}
+
+	// Persistent connection for clients that send many small requests or want pushed events
+	const int32 WebSocketPort = Settings ? Settings->WebSocketPort : 0;
+	if (WebSocketPort > 0 && static_cast<uint32>(WebSocketPort) != Port && WebSocketPort != HealthPort)
+	{
+		WebSocketServer.Start(WebSocketPort);
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("MCP HTTP Server started on port %d"), Port);
+	return true;
+}
+
+bool FMCPHttpServer::StartListener(uint32 Port)
+{
 	// Get the HTTP Server module
 	FHttpServerModule& HttpServerModule = FHttpServerModule::Get();
 
@@ -60,19 +121,61 @@ bool FMCPHttpServer::StartServer(uint32 Port)
 	if (!BindRoutes())
 	{
 		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to bind HTTP routes"));
+		HttpRouter.Reset();
 		return false;
 	}
 
-	// Start all listeners
+	// Only starts listeners that are not already listening; listeners owned by other plugins are left alone
 	HttpServerModule.StartAllListeners();
+	return true;
+}
 
-	ServerPort = Port;
-	bIsServerRunning = true;
+void FMCPHttpServer::StopListener()
+{
+	// Unbind routes
+	UnbindRoutes();
 
-	UE_LOG(LogUnrealMCP, Log, TEXT("MCP HTTP Server started on port %d"), Port);
+	// Dropping the router does not close its listener, and FHttpServerModule has no per-port stop,
+	// so the port is released through StopAllListeners. Other plugins' listeners pause until the
+	// next StartAllListeners; a route rebind on the same port (RestartServer) avoids this.
+	HttpRouter.Reset();
+	FHttpServerModule::Get().StopAllListeners();
+}
+
+bool FMCPHttpServer::TickStatusSnapshot(float DeltaTime)
+{
+	StatusSnapshot.Publish(BuildStatusJson());
 	return true;
 }
 
+bool FMCPHttpServer::TickWarmUp(float DeltaTime)
+{
+	if (WarmUp.RunNextStage())
+	{
+		return true;
+	}
+
+	WarmUpTickerHandle.Reset();
+	return false;
+}
+
+void FMCPHttpServer::EnsureWarmedUp()
+{
+	if (!WarmUp.HasStarted() || WarmUp.IsComplete())
+	{
+		return;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Request arrived during warm-up, finishing remaining stages first"));
+	WarmUp.Finish();
+
+	if (WarmUpTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(WarmUpTickerHandle);
+		WarmUpTickerHandle.Reset();
+	}
+}
+
 void FMCPHttpServer::StopServer()
 {
 	if (!bIsServerRunning)
@@ -80,20 +183,90 @@ void FMCPHttpServer::StopServer()
 		return;
 	}
 
-	// Unbind routes
-	UnbindRoutes();
+	if (WarmUpTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(WarmUpTickerHandle);
+		WarmUpTickerHandle.Reset();
+	}
 
-	// Stop HTTP Server module listeners
-	FHttpServerModule& HttpServerModule = FHttpServerModule::Get();
-	HttpServerModule.StopAllListeners();
+	if (SnapshotTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SnapshotTickerHandle);
+		SnapshotTickerHandle.Reset();
+	}
+	HealthListener.Stop();
 
-	HttpRouter.Reset();
+	// Answer anything still queued before the routes go away
+	JobQueue.CancelAll(TEXT("Server stopped before the request ran"));
+
+	// Then hand the resulting job events to waiting /events polls and WebSocket subscribers
+	EventHub.CloseAll();
+	WebSocketServer.Stop();
+
+	StopListener();
 	bIsServerRunning = false;
 	ServerPort = 0;
 
 	UE_LOG(LogUnrealMCP, Log, TEXT("MCP HTTP Server stopped"));
 }
 
+bool FMCPHttpServer::RestartServer(uint32 Port)
+{
+	if (!bIsServerRunning)
+	{
+		return StartServer(Port);
+	}
+
+	const double RestartStartTime = FPlatformTime::Seconds();
+	const uint32 PreviousPort = ServerPort;
+
+	if (Port != ServerPort || !HttpRouter.IsValid())
+	{
+		if (Port == HealthListener.GetPort() || Port == WebSocketServer.GetPort())
+		{
+			UE_LOG(LogUnrealMCP, Error, TEXT("Cannot move the MCP HTTP Server to port %d: the health or WebSocket endpoint is using it"), Port);
+			return false;
+		}
+
+		// Only the HTTP listener moves: queued and running jobs, /events polls, WebSocket connections
+		// and the health listener are left alone, so work accepted before the move still completes
+		StopListener();
+		if (!StartListener(Port))
+		{
+			// Go back to the old port rather than leave the server without a listener
+			if (PreviousPort != 0 && StartListener(PreviousPort))
+			{
+				UE_LOG(LogUnrealMCP, Warning, TEXT("MCP HTTP Server stays on port %d"), PreviousPort);
+			}
+			else
+			{
+				ServerPort = 0;
+			}
+			return false;
+		}
+		ServerPort = Port;
+
+		LastRestartSeconds = FPlatformTime::Seconds() - RestartStartTime;
+		++RestartCount;
+		UE_LOG(LogUnrealMCP, Log, TEXT("MCP HTTP Server moved from port %d to %d in %.3f ms"), PreviousPort, ServerPort, LastRestartSeconds * 1000.0);
+		return true;
+	}
+
+	// Same port: server-side state (warm-up, template prototypes, pending work) is kept; only the routes are rebound
+	UnbindRoutes();
+	if (!BindRoutes())
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to rebind HTTP routes on port %d"), ServerPort);
+		return false;
+	}
+
+	LastRestartSeconds = FPlatformTime::Seconds() - RestartStartTime;
+	++RestartCount;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("MCP HTTP Server routes rebound on port %d (was %d) in %.3f ms"), ServerPort, PreviousPort, LastRestartSeconds * 1000.0);
+	return true;
+}
+
 bool FMCPHttpServer::IsServerRunning() const
 {
 	return bIsServerRunning;
@@ -104,6 +277,11 @@ uint32 FMCPHttpServer::GetServerPort() const
 	return ServerPort;
 }
 
+bool FMCPHttpServer::IsServerReady() const
+{
+	return bIsServerRunning && (!WarmUp.HasStarted() || WarmUp.IsComplete());
+}
+
 bool FMCPHttpServer::BindRoutes()
 {
 	if (!HttpRouter.IsValid())
@@ -111,12 +289,21 @@ bool FMCPHttpServer::BindRoutes()
 		return false;
 	}
 
+	// Dispatch classes, highest priority first:
+	// - Health: /status, also served off the game thread by HealthListener
+	// - Read: /export_graph, /memory, /assets/query, /events; answered as soon as the router ticks, never queued behind mutations
+	// - Mutation: /add_node, /stamp, /commit; admitted to JobQueue and run within its frame budget
+	// /jobs and /jobs/:id/cancel are Reads that inspect or edit the queue
+	// Every route but /events is logged; /events is not, since each answered poll would publish another event
+	// /status and /jobs/:id/cancel answer small bodies and are not compressed
+	// The WebSocket transport reaches the same handlers through DispatchRequest; keep its table in step
+
 	// Bind /add_node endpoint for POST requests
 	FHttpPath AddNodePath(TEXT("/add_node"));
 	AddNodeRouteHandle = HttpRouter->BindRoute(
 		AddNodePath,
 		EHttpServerRequestVerbs::VERB_POST,
-		FHttpRequestHandler::CreateRaw(this, &FMCPHttpServer::HandleAddNode)
+		MakeRouteHandler(&FMCPHttpServer::HandleAddNode, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
 	);
 
 	// Bind /status endpoint for GET requests
@@ -124,7 +311,71 @@ bool FMCPHttpServer::BindRoutes()
 	StatusRouteHandle = HttpRouter->BindRoute(
 		StatusPath,
 		EHttpServerRequestVerbs::VERB_GET,
-		FHttpRequestHandler::CreateRaw(this, &FMCPHttpServer::HandleStatus)
+		MakeRouteHandler(&FMCPHttpServer::HandleStatus, EMCPRouteFlags::Log)
+	);
+
+	// Bind /export_graph endpoint for GET requests
+	FHttpPath ExportGraphPath(TEXT("/export_graph"));
+	ExportGraphRouteHandle = HttpRouter->BindRoute(
+		ExportGraphPath,
+		EHttpServerRequestVerbs::VERB_GET,
+		MakeRouteHandler(&FMCPHttpServer::HandleExportGraph, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
+	);
+
+	// Bind /stamp endpoint for POST requests
+	FHttpPath StampPath(TEXT("/stamp"));
+	StampRouteHandle = HttpRouter->BindRoute(
+		StampPath,
+		EHttpServerRequestVerbs::VERB_POST,
+		MakeRouteHandler(&FMCPHttpServer::HandleStamp, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
+	);
+
+	// Bind /commit endpoint for POST requests
+	FHttpPath CommitPath(TEXT("/commit"));
+	CommitRouteHandle = HttpRouter->BindRoute(
+		CommitPath,
+		EHttpServerRequestVerbs::VERB_POST,
+		MakeRouteHandler(&FMCPHttpServer::HandleCommit, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
+	);
+
+	// Bind /memory endpoint for GET requests
+	FHttpPath MemoryPath(TEXT("/memory"));
+	MemoryRouteHandle = HttpRouter->BindRoute(
+		MemoryPath,
+		EHttpServerRequestVerbs::VERB_GET,
+		MakeRouteHandler(&FMCPHttpServer::HandleMemory, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
+	);
+
+	// Bind /jobs endpoint for GET requests
+	FHttpPath ListJobsPath(TEXT("/jobs"));
+	ListJobsRouteHandle = HttpRouter->BindRoute(
+		ListJobsPath,
+		EHttpServerRequestVerbs::VERB_GET,
+		MakeRouteHandler(&FMCPHttpServer::HandleListJobs, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
+	);
+
+	// Bind /jobs/:id/cancel endpoint for POST requests
+	FHttpPath CancelJobPath(TEXT("/jobs/:id/cancel"));
+	CancelJobRouteHandle = HttpRouter->BindRoute(
+		CancelJobPath,
+		EHttpServerRequestVerbs::VERB_POST,
+		MakeRouteHandler(&FMCPHttpServer::HandleCancelJob, EMCPRouteFlags::Log)
+	);
+
+	// Bind /assets/query endpoint for POST requests
+	FHttpPath QueryAssetsPath(TEXT("/assets/query"));
+	QueryAssetsRouteHandle = HttpRouter->BindRoute(
+		QueryAssetsPath,
+		EHttpServerRequestVerbs::VERB_POST,
+		MakeRouteHandler(&FMCPHttpServer::HandleQueryAssets, EMCPRouteFlags::Compress | EMCPRouteFlags::Log)
+	);
+
+	// Bind /events endpoint for GET requests
+	FHttpPath EventsPath(TEXT("/events"));
+	EventsRouteHandle = HttpRouter->BindRoute(
+		EventsPath,
+		EHttpServerRequestVerbs::VERB_GET,
+		MakeRouteHandler(&FMCPHttpServer::HandleEvents, EMCPRouteFlags::Compress)
 	);
 
 	UE_LOG(LogUnrealMCP, Log, TEXT("HTTP routes bound successfully"));
@@ -150,224 +401,995 @@ void FMCPHttpServer::UnbindRoutes()
 		StatusRouteHandle.Reset();
 	}
 
+	if (ExportGraphRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(ExportGraphRouteHandle);
+		ExportGraphRouteHandle.Reset();
+	}
+
+	if (StampRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(StampRouteHandle);
+		StampRouteHandle.Reset();
+	}
+
+	if (CommitRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(CommitRouteHandle);
+		CommitRouteHandle.Reset();
+	}
+
+	if (MemoryRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(MemoryRouteHandle);
+		MemoryRouteHandle.Reset();
+	}
+
+	if (ListJobsRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(ListJobsRouteHandle);
+		ListJobsRouteHandle.Reset();
+	}
+
+	if (CancelJobRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(CancelJobRouteHandle);
+		CancelJobRouteHandle.Reset();
+	}
+
+	if (QueryAssetsRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(QueryAssetsRouteHandle);
+		QueryAssetsRouteHandle.Reset();
+	}
+
+	if (EventsRouteHandle.IsValid())
+	{
+		HttpRouter->UnbindRoute(EventsRouteHandle);
+		EventsRouteHandle.Reset();
+	}
+
 	UE_LOG(LogUnrealMCP, Log, TEXT("HTTP routes unbound"));
 }
 
-bool FMCPHttpServer::HandleAddNode(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+FHttpRequestHandler FMCPHttpServer::MakeRouteHandler(FRouteHandler Handler, EMCPRouteFlags Flags)
 {
-	UE_LOG(LogUnrealMCP, Log, TEXT("Received /add_node request"));
+	return FHttpRequestHandler::CreateLambda([this, Handler, Flags](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		// Logging wraps compression so it sees the response on the game thread, before any worker hand-off
+		FHttpResultCallback Respond = EnumHasAnyFlags(Flags, EMCPRouteFlags::Compress) ? WithResponseCompression(Request, OnComplete) : OnComplete;
+		if (EnumHasAnyFlags(Flags, EMCPRouteFlags::Log))
+		{
+			Respond = WithRequestLog(Request, Respond);
+		}
+		return (this->*Handler)(Request, Respond);
+	});
+}
+
+bool FMCPHttpServer::DispatchRequest(FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	struct FDispatchRoute
+	{
+		const TCHAR* Path;
+		EHttpServerRequestVerbs Verb;
+		FRouteHandler Handler;
+	};
 
-	// Parse JSON request body
-	FString RequestBody;
-	if (Request.Body.Num() > 0)
+	// Mirrors BindRoutes; /events is left out, since long polls are what a persistent connection replaces
+	static const FDispatchRoute DispatchRoutes[] =
 	{
-		// Create a null-terminated string from the byte array
-		TArray<uint8> NullTerminatedBody = Request.Body;
-		NullTerminatedBody.Add(0); // Ensure null termination
-		RequestBody = FString(FUTF8ToTCHAR(reinterpret_cast<const char*>(NullTerminatedBody.GetData())));
+		{ TEXT("/add_node"), EHttpServerRequestVerbs::VERB_POST, &FMCPHttpServer::HandleAddNode },
+		{ TEXT("/status"), EHttpServerRequestVerbs::VERB_GET, &FMCPHttpServer::HandleStatus },
+		{ TEXT("/export_graph"), EHttpServerRequestVerbs::VERB_GET, &FMCPHttpServer::HandleExportGraph },
+		{ TEXT("/stamp"), EHttpServerRequestVerbs::VERB_POST, &FMCPHttpServer::HandleStamp },
+		{ TEXT("/commit"), EHttpServerRequestVerbs::VERB_POST, &FMCPHttpServer::HandleCommit },
+		{ TEXT("/memory"), EHttpServerRequestVerbs::VERB_GET, &FMCPHttpServer::HandleMemory },
+		{ TEXT("/jobs"), EHttpServerRequestVerbs::VERB_GET, &FMCPHttpServer::HandleListJobs },
+		{ TEXT("/assets/query"), EHttpServerRequestVerbs::VERB_POST, &FMCPHttpServer::HandleQueryAssets },
+	};
+
+	const FString Path = Request.RelativePath.GetPath();
+	FRouteHandler Handler = nullptr;
+	for (const FDispatchRoute& Route : DispatchRoutes)
+	{
+		if (Path == Route.Path)
+		{
+			Request.Verb = Route.Verb;
+			Handler = Route.Handler;
+			break;
+		}
 	}
 
-	UE_LOG(LogUnrealMCP, Log, TEXT("Received request body: %s"), *RequestBody);
-	UE_LOG(LogUnrealMCP, Log, TEXT("Request body length: %d"), RequestBody.Len());
+	const FString JobsPrefix = TEXT("/jobs/");
+	const FString CancelSuffix = TEXT("/cancel");
+	if (!Handler && Path.StartsWith(JobsPrefix) && Path.EndsWith(CancelSuffix) && Path.Len() > JobsPrefix.Len() + CancelSuffix.Len())
+	{
+		Request.PathParams.Add(TEXT("id"), Path.Mid(JobsPrefix.Len(), Path.Len() - JobsPrefix.Len() - CancelSuffix.Len()));
+		Request.Verb = EHttpServerRequestVerbs::VERB_POST;
+		Handler = &FMCPHttpServer::HandleCancelJob;
+	}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RequestBody);
-	bool bJsonParseResult = FJsonSerializer::Deserialize(Reader, JsonObject);
+	if (!Handler)
+	{
+		return false;
+	}
 
-	TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+	(this->*Handler)(Request, WithRequestLog(Request, OnComplete));
+	return true;
+}
 
-	if (!bJsonParseResult || !JsonObject.IsValid())
+FHttpResultCallback FMCPHttpServer::WithRequestLog(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	FString Method;
+	switch (Request.Verb)
 	{
-		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to parse JSON request body"));
-		ResponseJson->SetBoolField(TEXT("success"), false);
-		ResponseJson->SetStringField(TEXT("message"), TEXT("Invalid JSON in request body"));
+	case EHttpServerRequestVerbs::VERB_GET:
+		Method = TEXT("GET");
+		break;
+	case EHttpServerRequestVerbs::VERB_POST:
+		Method = TEXT("POST");
+		break;
+	case EHttpServerRequestVerbs::VERB_PUT:
+		Method = TEXT("PUT");
+		break;
+	case EHttpServerRequestVerbs::VERB_DELETE:
+		Method = TEXT("DELETE");
+		break;
+	default:
+		Method = TEXT("OTHER");
+		break;
 	}
-	else
+	const FString Path = Request.RelativePath.GetPath();
+	const FString ClientIP = Request.PeerAddress.IsValid() ? Request.PeerAddress->ToString(false) : FString();
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// Completions of queued jobs run while the server, which owns the job queue, is alive
+	return [this, OnComplete, Method, Path, ClientIP, StartSeconds](TUniquePtr<FHttpServerResponse>&& Response)
 	{
-		// Extract blueprint_path and node_type from request
-		FString BlueprintPath = JsonObject->GetStringField(TEXT("blueprint_path"));
-		FString NodeType = JsonObject->GetStringField(TEXT("node_type"));
+		const int32 StatusCode = Response.IsValid() ? static_cast<int32>(Response->Code) : 0;
+
+		OnRequestLoggedDelegate.ExecuteIfBound(Method, Path, StatusCode, ClientIP);
+
+		if (EventHub.HasSubscribers(EMCPEventTopic::Log))
+		{
+			TSharedRef<FJsonObject> EventJson = MakeShared<FJsonObject>();
+			EventJson->SetStringField(TEXT("method"), Method);
+			EventJson->SetStringField(TEXT("path"), Path);
+			EventJson->SetNumberField(TEXT("status"), StatusCode);
+			EventJson->SetStringField(TEXT("client_ip"), ClientIP);
+			EventJson->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+			EventJson->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+			EventHub.Publish(EMCPEventTopic::Log, EventJson);
+		}
+
+		OnComplete(MoveTemp(Response));
+	};
+}
 
-		UE_LOG(LogUnrealMCP, Log, TEXT("Add node request - Blueprint: %s, NodeType: %s"), *BlueprintPath, *NodeType);
+FHttpResultCallback FMCPHttpServer::WithResponseCompression(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	const TArray<FString>* AcceptEncodingValues = Request.Headers.Find(TEXT("Accept-Encoding"));
+	if (!Settings->bCompressResponses || !AcceptEncodingValues)
+	{
+		return OnComplete;
+	}
 
-		// Call the actual blueprint creation function
-		bool bSuccess = CreateBlueprintWithPrintString(BlueprintPath, NodeType);
+	const EMCPContentCoding Coding = FMCPCompression::NegotiateAcceptEncoding(*AcceptEncodingValues);
+	if (Coding == EMCPContentCoding::Identity)
+	{
+		return OnComplete;
+	}
 
-		ResponseJson->SetBoolField(TEXT("success"), bSuccess);
-		if (bSuccess)
+	// Settings are read here, on the game thread, and copied into the callback
+	const int32 Threshold = Settings->CompressionThresholdBytes;
+	const int32 Level = Settings->CompressionLevel;
+	return [OnComplete, Coding, Threshold, Level, Stats = CompressionStats](TUniquePtr<FHttpServerResponse>&& Response)
+	{
+		if (!Response.IsValid() || Response->Body.Num() < Threshold || Response->Headers.Contains(TEXT("Content-Encoding")))
 		{
-			ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Blueprint created with %s node at '%s'"), *NodeType, *BlueprintPath));
+			if (Response.IsValid() && Response->Body.Num() < Threshold)
+			{
+				Stats->RecordSkippedResponse();
+			}
+			OnComplete(MoveTemp(Response));
+			return;
 		}
-		else
+
+		// The HTTP server is ticked on the game thread, so the finished response is handed back there
+		Async(EAsyncExecution::ThreadPool, [OnComplete, Coding, Level, Stats, Response = MoveTemp(Response)]() mutable
+		{
+			const double StartSeconds = FPlatformTime::Seconds();
+			TArray<uint8> Compressed;
+			if (FMCPCompression::Compress(Coding, Response->Body, Level, Compressed) && Compressed.Num() < Response->Body.Num())
+			{
+				Stats->RecordResponse(Response->Body.Num(), Compressed.Num(), FPlatformTime::Seconds() - StartSeconds);
+				Response->Body = MoveTemp(Compressed);
+				Response->Headers.Add(TEXT("Content-Encoding"), { FMCPCompression::GetCodingName(Coding) });
+				Response->Headers.Add(TEXT("Content-Length"), { FString::FromInt(Response->Body.Num()) });
+			}
+			Response->Headers.Add(TEXT("Vary"), { TEXT("Accept-Encoding") });
+
+			AsyncTask(ENamedThreads::GameThread, [OnComplete, Response = MoveTemp(Response)]() mutable
+			{
+				OnComplete(MoveTemp(Response));
+			});
+		});
+	};
+}
+
+const TArray<uint8>* FMCPHttpServer::DecodeRequestBody(const FHttpServerRequest& Request, TArray<uint8>& Storage) const
+{
+	const FString* ContentEncodingHeader = FindHeader(Request, TEXT("Content-Encoding"));
+	if (!ContentEncodingHeader)
+	{
+		return &Request.Body;
+	}
+
+	EMCPContentCoding Coding = EMCPContentCoding::Identity;
+	if (!FMCPCompression::ParseContentEncoding(*ContentEncodingHeader, Coding))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Unsupported Content-Encoding '%s'"), **ContentEncodingHeader);
+		CompressionStats->RecordRejectedRequest();
+		return nullptr;
+	}
+	if (Coding == EMCPContentCoding::Identity)
+	{
+		return &Request.Body;
+	}
+
+	const int64 MaxBytes = static_cast<int64>(GetDefault<UUnrealMCPSettings>()->MaxInflatedRequestMB) * 1024 * 1024;
+	if (!FMCPCompression::Decompress(Request.Body, MaxBytes, Storage))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to inflate %d-byte %s request body (corrupt, or larger than %lld bytes)"),
+			Request.Body.Num(), FMCPCompression::GetCodingName(Coding), MaxBytes);
+		CompressionStats->RecordRejectedRequest();
+		return nullptr;
+	}
+
+	CompressionStats->RecordRequest(Request.Body.Num(), Storage.Num());
+	return &Storage;
+}
+
+bool FMCPHttpServer::HandleAddNode(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	UE_LOG(LogUnrealMCP, Log, TEXT("Received /add_node request"));
+
+	TSharedPtr<FJsonObject> JsonObject;
+	bool bJsonParseResult = false;
+	TArray<uint8> InflatedBody;
+	const TArray<uint8>* Body = DecodeRequestBody(Request, InflatedBody);
+	if (!Body)
+	{
+		// Unsupported or corrupt Content-Encoding, logged by DecodeRequestBody
+	}
+	else if (HasMsgPackBody(Request))
+	{
+		UE_LOG(LogUnrealMCP, Log, TEXT("Request body length: %d (msgpack)"), Body->Num());
+		bJsonParseResult = FMCPMsgPack::Decode(*Body, JsonObject);
+	}
+	else
+	{
+		// Parse JSON request body
+		FString RequestBody;
+		if (Body->Num() > 0)
 		{
-			ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Failed to create Blueprint with %s node at '%s'"), *NodeType, *BlueprintPath));
+			// Create a null-terminated string from the byte array
+			TArray<uint8> NullTerminatedBody = *Body;
+			NullTerminatedBody.Add(0); // Ensure null termination
+			RequestBody = FString(FUTF8ToTCHAR(reinterpret_cast<const char*>(NullTerminatedBody.GetData())));
 		}
-		ResponseJson->SetStringField(TEXT("blueprint_path"), BlueprintPath);
-		ResponseJson->SetStringField(TEXT("node_type"), NodeType);
+
+		UE_LOG(LogUnrealMCP, Log, TEXT("Received request body: %s"), *RequestBody);
+		UE_LOG(LogUnrealMCP, Log, TEXT("Request body length: %d"), RequestBody.Len());
+
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RequestBody);
+		bJsonParseResult = FJsonSerializer::Deserialize(Reader, JsonObject);
 	}
 
-	// Serialize response to JSON string
-	FString ResponseString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
-	FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
+	TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
 
-	// Create HTTP response
-	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ResponseString, TEXT("application/json"));
-	Response->Code = EHttpServerResponseCodes::Ok;
+	if (!bJsonParseResult || !JsonObject.IsValid())
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to parse JSON request body"));
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), TEXT("Invalid JSON in request body"));
+	}
+	else
+	{
+		// Answered when the job runs
+		EnqueueOperation(TEXT("/add_node"), JsonObject, Request, OnComplete);
+		return true;
+	}
 
-	// Send response
-	OnComplete(MoveTemp(Response));
+	SendJsonResponse(ResponseJson, EHttpServerResponseCodes::Ok, OnComplete, GetResponseEncoding(Request));
 	return true;
 }
 
 bool FMCPHttpServer::HandleStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
 	UE_LOG(LogUnrealMCP, Log, TEXT("Received /status request"));
+	FMCPLatencyScope LatencyScope(StatusSnapshot, EMCPRequestClass::Health);
+
+	TSharedRef<FJsonObject> ResponseJson = BuildStatusJson();
+	ResponseJson->SetStringField(TEXT("source"), TEXT("live"));
+
+	SendJsonResponse(ResponseJson, EHttpServerResponseCodes::Ok, OnComplete);
+	return true;
+}
 
+TSharedRef<FJsonObject> FMCPHttpServer::BuildStatusJson() const
+{
 	// Create status response
-	TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	const bool bReady = IsServerReady();
 	ResponseJson->SetBoolField(TEXT("server_running"), true);
+	ResponseJson->SetBoolField(TEXT("ready"), bReady);
+	ResponseJson->SetStringField(TEXT("state"), bReady ? TEXT("running") : TEXT("starting"));
 	ResponseJson->SetNumberField(TEXT("port"), ServerPort);
-	ResponseJson->SetStringField(TEXT("status"), TEXT("UnrealMCP server is running"));
+	ResponseJson->SetNumberField(TEXT("health_port"), HealthListener.GetPort());
+	ResponseJson->SetNumberField(TEXT("websocket_port"), WebSocketServer.GetPort());
+	ResponseJson->SetStringField(TEXT("status"), bReady ? TEXT("UnrealMCP server is running") : TEXT("UnrealMCP server is warming up"));
 	ResponseJson->SetStringField(TEXT("version"), TEXT("1.0"));
 
-	// Serialize response to JSON string
-	FString ResponseString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
-	FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
+	TSharedRef<FJsonObject> WarmUpJson = MakeShared<FJsonObject>();
+	WarmUp.WriteTimings(WarmUpJson);
+	ResponseJson->SetObjectField(TEXT("warmup"), WarmUpJson);
 
-	// Create HTTP response
-	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ResponseString, TEXT("application/json"));
-	Response->Code = EHttpServerResponseCodes::Ok;
+	TSharedRef<FJsonObject> LatencyJson = MakeShared<FJsonObject>();
+	LatencyJson->SetNumberField(TEXT("add_node_count"), AddNodeCount);
+	if (AddNodeCount > 0)
+	{
+		LatencyJson->SetNumberField(TEXT("first_add_node_ms"), FirstAddNodeSeconds * 1000.0);
+		LatencyJson->SetNumberField(TEXT("last_add_node_ms"), LastAddNodeSeconds * 1000.0);
+	}
+	else
+	{
+		// Null rather than a sentinel, so dashboards do not plot a negative latency before the first request
+		LatencyJson->SetField(TEXT("first_add_node_ms"), MakeShared<FJsonValueNull>());
+		LatencyJson->SetField(TEXT("last_add_node_ms"), MakeShared<FJsonValueNull>());
+	}
+	ResponseJson->SetObjectField(TEXT("latency"), LatencyJson);
 
-	// Send response
+	TSharedRef<FJsonObject> StartupJson = MakeShared<FJsonObject>();
+	StartupJson->SetNumberField(TEXT("router_bind_ms"), RouterBindSeconds * 1000.0);
+	StartupJson->SetNumberField(TEXT("restart_count"), RestartCount);
+	StartupJson->SetNumberField(TEXT("last_restart_ms"), LastRestartSeconds * 1000.0);
+	OnWriteStartupStatsDelegate.ExecuteIfBound(StartupJson);
+	ResponseJson->SetObjectField(TEXT("startup"), StartupJson);
+
+	TSharedRef<FJsonObject> QueueJson = MakeShared<FJsonObject>();
+	JobQueue.WriteStats(QueueJson);
+	QueueJson->SetNumberField(TEXT("expired_stages"), static_cast<double>(OperationRunner->GetExpiredStageCount()));
+
+	TSharedRef<FJsonObject> IdempotencyJson = MakeShared<FJsonObject>();
+	IdempotencyCache.WriteStats(IdempotencyJson);
+	QueueJson->SetObjectField(TEXT("idempotency"), IdempotencyJson);
+	ResponseJson->SetObjectField(TEXT("queue"), QueueJson);
+
+	TSharedRef<FJsonObject> GCJson = MakeShared<FJsonObject>();
+	OperationRunner->GetGCPolicy().WriteStats(GCJson);
+	ResponseJson->SetObjectField(TEXT("gc"), GCJson);
+
+	TSharedRef<FJsonObject> UndoJson = MakeShared<FJsonObject>();
+	OperationRunner->WriteUndoStats(UndoJson);
+	ResponseJson->SetObjectField(TEXT("undo"), UndoJson);
+
+	TSharedRef<FJsonObject> RegistryJson = MakeShared<FJsonObject>();
+	OperationRunner->GetAssetNotifier().WriteStats(RegistryJson);
+	ResponseJson->SetObjectField(TEXT("asset_registry"), RegistryJson);
+
+	TSharedRef<FJsonObject> DryRunJson = MakeShared<FJsonObject>();
+	OperationRunner->GetDryRunStore().WriteStats(DryRunJson);
+	ResponseJson->SetObjectField(TEXT("dry_run"), DryRunJson);
+
+	TSharedRef<FJsonObject> CompressionJson = MakeShared<FJsonObject>();
+	CompressionStats->WriteStats(CompressionJson);
+	ResponseJson->SetObjectField(TEXT("compression"), CompressionJson);
+
+	TSharedRef<FJsonObject> EventsJson = MakeShared<FJsonObject>();
+	EventHub.WriteStats(EventsJson);
+	ResponseJson->SetObjectField(TEXT("events"), EventsJson);
+
+	TSharedRef<FJsonObject> WebSocketJson = MakeShared<FJsonObject>();
+	WebSocketServer.WriteStats(WebSocketJson);
+	ResponseJson->SetObjectField(TEXT("websocket"), WebSocketJson);
+
+	TSharedRef<FJsonObject> DispatchJson = MakeShared<FJsonObject>();
+	StatusSnapshot.WriteLatency(DispatchJson);
+	ResponseJson->SetObjectField(TEXT("dispatch"), DispatchJson);
+
+	return ResponseJson;
+}
+
+bool FMCPHttpServer::HandleExportGraph(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	UE_LOG(LogUnrealMCP, Log, TEXT("Received /export_graph request"));
+	FMCPLatencyScope LatencyScope(StatusSnapshot, EMCPRequestClass::Read);
+
+	TSharedPtr<FJsonObject> ErrorJson = MakeShareable(new FJsonObject);
+	ErrorJson->SetBoolField(TEXT("success"), false);
+
+	const FString* BlueprintPathParam = Request.QueryParams.Find(TEXT("blueprint_path"));
+	if (!BlueprintPathParam || BlueprintPathParam->IsEmpty())
+	{
+		ErrorJson->SetStringField(TEXT("message"), TEXT("Missing 'blueprint_path' query parameter"));
+		SendJsonResponse(ErrorJson, EHttpServerResponseCodes::BadRequest, OnComplete);
+		return true;
+	}
+	const FString BlueprintPath = *BlueprintPathParam;
+
+	FMCPGraphExportOptions Options;
+	if (const FString* GraphParam = Request.QueryParams.Find(TEXT("graph")))
+	{
+		Options.GraphName = *GraphParam;
+	}
+	if (const FString* CursorParam = Request.QueryParams.Find(TEXT("cursor")))
+	{
+		Options.Cursor = FCString::Atoi(**CursorParam);
+	}
+	if (const FString* LimitParam = Request.QueryParams.Find(TEXT("limit")))
+	{
+		Options.MaxNodes = FMath::Clamp(FCString::Atoi(**LimitParam), 1, 10000);
+	}
+	if (const FString* MaxBytesParam = Request.QueryParams.Find(TEXT("max_bytes")))
+	{
+		Options.MaxBytes = FMath::Clamp(FCString::Atoi(**MaxBytesParam), 4 * 1024, 16 * 1024 * 1024);
+	}
+
+	const FString* FormatParam = Request.QueryParams.Find(TEXT("format"));
+	if (!FMCPGraphExporter::ParseFormat(FormatParam ? *FormatParam : FString(), Options.Format))
+	{
+		ErrorJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Unsupported format '%s'. Use 'json' or 'ndjson'."), **FormatParam));
+		SendJsonResponse(ErrorJson, EHttpServerResponseCodes::BadRequest, OnComplete);
+		return true;
+	}
+
+#if WITH_EDITOR
+	// "/Game/MyBlueprint" -> "/Game/MyBlueprint.MyBlueprint"
+	const FString ObjectPath = FString::Printf(TEXT("%s.%s"), *BlueprintPath, *FPackageName::GetShortName(BlueprintPath));
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath);
+	if (!Blueprint)
+	{
+		ErrorJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Blueprint not found at '%s'"), *BlueprintPath));
+		SendJsonResponse(ErrorJson, EHttpServerResponseCodes::NotFound, OnComplete);
+		return true;
+	}
+
+	FMCPGraphExportResult ExportResult;
+	if (!FMCPGraphExporter::ExportWindow(Blueprint, BlueprintPath, Options, ExportResult))
+	{
+		ErrorJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Graph '%s' not found in '%s'"), *Options.GraphName, *BlueprintPath));
+		SendJsonResponse(ErrorJson, EHttpServerResponseCodes::NotFound, OnComplete);
+		return true;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Exported %d/%d nodes from %s (%d bytes, next cursor %d)"),
+		ExportResult.NodesWritten, ExportResult.TotalNodes, *BlueprintPath, ExportResult.Body.Num(), ExportResult.NextCursor);
+
+	const TCHAR* ContentType = Options.Format == EMCPGraphExportFormat::NDJson ? TEXT("application/x-ndjson") : TEXT("application/json");
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(ExportResult.Body), ContentType);
+	Response->Code = EHttpServerResponseCodes::Ok;
 	OnComplete(MoveTemp(Response));
+#else
+	ErrorJson->SetStringField(TEXT("message"), TEXT("Graph export is only supported in editor builds"));
+	SendJsonResponse(ErrorJson, EHttpServerResponseCodes::ServerError, OnComplete);
+#endif
 	return true;
 }
 
-bool FMCPHttpServer::CreateBlueprintWithPrintString(const FString& BlueprintPath, const FString& NodeType)
+bool FMCPHttpServer::HandleStamp(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
-#if WITH_EDITOR
-	// ✅ 확인됨: UE5.6 소스코드에서 검증된 블루프린트 생성 방법
-	UE_LOG(LogUnrealMCP, Log, TEXT("Creating Blueprint at path: %s with node type: %s"), *BlueprintPath, *NodeType);
+	UE_LOG(LogUnrealMCP, Log, TEXT("Received /stamp request"));
 
-	// Only support PrintString for now
-	if (NodeType != TEXT("PrintString"))
+	TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!ParseJsonBody(Request, JsonObject))
 	{
-		UE_LOG(LogUnrealMCP, Warning, TEXT("Unsupported node type: %s. Only 'PrintString' is currently supported."), *NodeType);
-		return false;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), TEXT("Invalid JSON in request body"));
+		SendJsonResponse(ResponseJson, EHttpServerResponseCodes::BadRequest, OnComplete, GetResponseEncoding(Request));
+		return true;
 	}
 
-	// Parse the asset path to extract package and asset names
-	FString PackageName, AssetName;
-	if (!BlueprintPath.Split(TEXT("/"), &PackageName, &AssetName, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+	EnqueueOperation(TEXT("/stamp"), JsonObject, Request, OnComplete);
+	return true;
+}
+
+bool FMCPHttpServer::HandleCommit(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	UE_LOG(LogUnrealMCP, Log, TEXT("Received /commit request"));
+
+	TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!ParseJsonBody(Request, JsonObject))
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Invalid blueprint path format: %s"), *BlueprintPath);
-		return false;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), TEXT("Invalid JSON in request body"));
+		SendJsonResponse(ResponseJson, EHttpServerResponseCodes::BadRequest, OnComplete, GetResponseEncoding(Request));
+		return true;
 	}
 
-	// The full package name is the blueprint path itself
-	FString FullPackageName = BlueprintPath;
-	if (AssetName.IsEmpty())
+	EnqueueOperation(TEXT("/commit"), JsonObject, Request, OnComplete);
+	return true;
+}
+
+void FMCPHttpServer::EnqueueOperation(const FString& Route, const TSharedPtr<FJsonObject>& Body, const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const EMCPBodyEncoding Encoding = GetResponseEncoding(Request);
+
+	FMCPJob Job;
+	Job.Route = Route;
+	Job.Cost = FMCPOperationRunner::EstimateCost(Route, Body);
+
+	// The deadline is relative so client and editor clocks need not agree
+	if (const FString* DeadlineHeader = FindHeader(Request, TEXT("X-MCP-Deadline-Ms")))
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Asset name cannot be empty"));
-		return false;
+		const double RemainingMs = FCString::Atod(**DeadlineHeader);
+		if (RemainingMs > 0.0)
+		{
+			Job.DeadlineSeconds = FPlatformTime::Seconds() + RemainingMs / 1000.0;
+		}
+	}
+	if (const FString* RequestIdHeader = FindHeader(Request, TEXT("X-MCP-Request-Id")))
+	{
+		Job.ClientRequestId = *RequestIdHeader;
 	}
 
-	// ✅ 확인됨: FKismetEditorUtilities::CreateBlueprint 함수 시그니처 검증
-	// D:\_Source\UnrealEngine\Engine\Source\Editor\UnrealEd\Public\Kismet2\KismetEditorUtilities.h:102
-	UPackage* Package = CreatePackage(*FullPackageName);
-	if (!Package)
+	// Retries with the same Idempotency-Key replay the cached result or wait for the request already in flight
+	// The parsed body is hashed rather than the wire bytes, so a retry matches whatever transport,
+	// encoding, key order or compression carried it
+	FString IdempotencyKey;
+	TSharedPtr<FMCPIdempotencyEntry> IdempotencyEntry;
+	if (const FString* KeyHeader = FindHeader(Request, TEXT("Idempotency-Key")))
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to create package: %s"), *FullPackageName);
-		return false;
+		IdempotencyKey = Route + TEXT(" ") + *KeyHeader;
+		EMCPIdempotencyLookup Lookup = EMCPIdempotencyLookup::Miss;
+		IdempotencyEntry = IdempotencyCache.Begin(IdempotencyKey, FMCPIdempotencyCache::HashBody(Body), Lookup);
+		switch (Lookup)
+		{
+		case EMCPIdempotencyLookup::Completed:
+			SendReplayResponse(IdempotencyEntry->Result, OnComplete, Encoding);
+			return;
+
+		case EMCPIdempotencyLookup::InFlight:
+			IdempotencyEntry->Waiters.Add([OnComplete, Encoding](const FMCPOperationResult& Result)
+			{
+				SendReplayResponse(Result, OnComplete, Encoding);
+			});
+			return;
+
+		case EMCPIdempotencyLookup::Mismatch:
+		{
+			TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+			ResponseJson->SetBoolField(TEXT("success"), false);
+			ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Idempotency-Key '%s' was already used with a different request body"), **KeyHeader));
+			SendJsonResponse(ResponseJson, EHttpServerResponseCodes::BadRequest, OnComplete, Encoding);
+			return;
+		}
+
+		default:
+			break;
+		}
 	}
 
-	// Create the Blueprint
-	UBlueprint* NewBlueprint = FKismetEditorUtilities::CreateBlueprint(
-		AActor::StaticClass(),  // Parent class
-		Package,                // Outer package
-		FName(*AssetName),      // Blueprint name
-		BPTYPE_Normal,          // Blueprint type
-		NAME_None               // Calling context
-	);
+	Job.Run = [this, Body, OnComplete, Encoding, IdempotencyKey, IdempotencyEntry](const FMCPJob& QueuedJob)
+	{
+		EnsureWarmedUp();
+
+		PublishJobEvent(QueuedJob.Id, QueuedJob.Route, QueuedJob.ClientRequestId, TEXT("running"));
+		StatusSnapshot.BeginJob(QueuedJob.Route, QueuedJob.Id);
+		const double StartTime = FPlatformTime::Seconds();
+		const FMCPOperationResult Result = OperationRunner->Execute(QueuedJob.Route, Body, QueuedJob.DeadlineSeconds);
+		StatusSnapshot.EndJob();
+		StatusSnapshot.RecordLatency(EMCPRequestClass::Mutation, FPlatformTime::Seconds() - QueuedJob.EnqueuedSeconds);
+
+		if (QueuedJob.Route == TEXT("/add_node"))
+		{
+			LastAddNodeSeconds = FPlatformTime::Seconds() - StartTime;
+			if (AddNodeCount++ == 0)
+			{
+				FirstAddNodeSeconds = LastAddNodeSeconds;
+			}
+		}
+
+		Result.Json->SetNumberField(TEXT("job_id"), static_cast<double>(QueuedJob.Id));
+		Result.Json->SetNumberField(TEXT("queue_wait_ms"), (StartTime - QueuedJob.EnqueuedSeconds) * 1000.0);
 
-	if (!NewBlueprint)
+		const TSharedPtr<FJsonObject>* CompileJson = nullptr;
+		if (EventHub.HasSubscribers(EMCPEventTopic::Compile) && Result.Json->TryGetObjectField(TEXT("compile"), CompileJson))
+		{
+			TSharedRef<FJsonObject> EventJson = MakeShared<FJsonObject>();
+			EventJson->SetNumberField(TEXT("job_id"), static_cast<double>(QueuedJob.Id));
+			EventJson->SetStringField(TEXT("route"), QueuedJob.Route);
+			for (const TCHAR* FieldName : { TEXT("blueprint_path"), TEXT("template") })
+			{
+				FString FieldValue;
+				if (Result.Json->TryGetStringField(FieldName, FieldValue))
+				{
+					EventJson->SetStringField(FieldName, FieldValue);
+				}
+			}
+			EventJson->SetObjectField(TEXT("compile"), *CompileJson);
+			EventHub.Publish(EMCPEventTopic::Compile, EventJson);
+		}
+		PublishJobEvent(QueuedJob.Id, QueuedJob.Route, QueuedJob.ClientRequestId, TEXT("completed"), &Result);
+
+		SendJsonResponse(Result.Json, Result.Code, OnComplete, Encoding);
+
+		// Work cut short by the deadline may be retried, so only complete results are replayed
+		const bool bCacheable = static_cast<int32>(Result.Code) < 500;
+		IdempotencyCache.Complete(IdempotencyKey, IdempotencyEntry, Result, bCacheable);
+	};
+	Job.Cancel = [this, OnComplete, Encoding, IdempotencyKey, IdempotencyEntry](const FMCPJob& QueuedJob, EMCPJobCancelReason CancelReason, const FString& Message)
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to create Blueprint"));
-		return false;
+		FMCPOperationResult Result;
+		Result.Code = EHttpServerResponseCodes::ServiceUnavail;
+		Result.Json = MakeShareable(new FJsonObject);
+		Result.Json->SetBoolField(TEXT("success"), false);
+		Result.Json->SetStringField(TEXT("message"), Message);
+		Result.Json->SetNumberField(TEXT("job_id"), static_cast<double>(QueuedJob.Id));
+
+		if (CancelReason == EMCPJobCancelReason::Expired)
+		{
+			Result.Json->SetBoolField(TEXT("deadline_exceeded"), true);
+			Result.Code = EHttpServerResponseCodes::GatewayTimeout;
+		}
+		else if (CancelReason == EMCPJobCancelReason::Requested)
+		{
+			Result.Json->SetBoolField(TEXT("cancelled"), true);
+			Result.Code = EHttpServerResponseCodes::Conflict;
+		}
+		const TCHAR* State = CancelReason == EMCPJobCancelReason::Expired ? TEXT("expired")
+			: CancelReason == EMCPJobCancelReason::Requested ? TEXT("cancelled")
+			: TEXT("shutdown");
+		PublishJobEvent(QueuedJob.Id, QueuedJob.Route, QueuedJob.ClientRequestId, State, &Result);
+		SendJsonResponse(Result.Json, Result.Code, OnComplete, Encoding);
+		IdempotencyCache.Complete(IdempotencyKey, IdempotencyEntry, Result, false);
+	};
+
+	const FString ClientRequestId = Job.ClientRequestId;
+	int32 RetryAfterSeconds = 0;
+	if (const uint64 JobId = JobQueue.Enqueue(MoveTemp(Job), RetryAfterSeconds))
+	{
+		PublishJobEvent(JobId, Route, ClientRequestId, TEXT("queued"));
+		return;
 	}
 
-	// ✅ 확인됨: FBlueprintEditorUtils::FindEventGraph 함수 검증
-	// D:\_Source\UnrealEngine\Engine\Source\Editor\UnrealEd\Public\Kismet2\BlueprintEditorUtils.h:1095
-	UEdGraph* EventGraph = FBlueprintEditorUtils::FindEventGraph(NewBlueprint);
-	if (!EventGraph)
+	FMCPOperationResult Rejected;
+	Rejected.Code = EHttpServerResponseCodes::TooManyRequests;
+	Rejected.Json = MakeShareable(new FJsonObject);
+	Rejected.Json->SetBoolField(TEXT("success"), false);
+	Rejected.Json->SetStringField(TEXT("message"), FString::Printf(TEXT("Server is busy (%d queued request(s)); retry after %d s"), JobQueue.GetDepth(), RetryAfterSeconds));
+	Rejected.Json->SetNumberField(TEXT("retry_after"), RetryAfterSeconds);
+	IdempotencyCache.Complete(IdempotencyKey, IdempotencyEntry, Rejected, false);
+	PublishJobEvent(0, Route, ClientRequestId, TEXT("rejected"), &Rejected);
+
+	TUniquePtr<FHttpServerResponse> Response = MakeJsonResponse(Rejected.Json, Rejected.Code, Encoding);
+	Response->Headers.Add(TEXT("Retry-After"), { FString::FromInt(RetryAfterSeconds) });
+	OnComplete(MoveTemp(Response));
+}
+
+void FMCPHttpServer::PublishJobEvent(uint64 JobId, const FString& Route, const FString& ClientRequestId, const TCHAR* State, const FMCPOperationResult* Result)
+{
+	if (!EventHub.HasSubscribers(EMCPEventTopic::Job))
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find Event Graph in Blueprint"));
-		return false;
+		return;
 	}
 
-	// ✅ 확인됨: UKismetSystemLibrary::PrintString UFUNCTION 검증
-	// D:\_Source\UnrealEngine\Engine\Source\Runtime\Engine\Classes\Kismet\KismetSystemLibrary.h:374
-	UFunction* PrintStringFunction = FindFieldChecked<UFunction>(UKismetSystemLibrary::StaticClass(), TEXT("PrintString"));
-	if (!PrintStringFunction)
+	TSharedRef<FJsonObject> EventJson = MakeShared<FJsonObject>();
+	EventJson->SetNumberField(TEXT("job_id"), static_cast<double>(JobId));
+	EventJson->SetStringField(TEXT("route"), Route);
+	EventJson->SetStringField(TEXT("state"), State);
+	if (!ClientRequestId.IsEmpty())
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to find PrintString function"));
-		return false;
+		EventJson->SetStringField(TEXT("request_id"), ClientRequestId);
 	}
+	if (Result)
+	{
+		bool bSuccess = false;
+		Result->Json->TryGetBoolField(TEXT("success"), bSuccess);
+		EventJson->SetNumberField(TEXT("code"), static_cast<int32>(Result->Code));
+		EventJson->SetBoolField(TEXT("success"), bSuccess);
 
-	// ✅ 확인됨: UK2Node_CallFunction 노드 생성 패턴 검증
-	// D:\_Source\UnrealEngine\Engine\Source\Editor\Kismet\Private\BlueprintEditor.cpp:5279
-	UK2Node_CallFunction* NewFunctionNode = NewObject<UK2Node_CallFunction>(EventGraph);
-	NewFunctionNode->SetFromFunction(PrintStringFunction);
+		FString Message;
+		if (Result->Json->TryGetStringField(TEXT("message"), Message))
+		{
+			EventJson->SetStringField(TEXT("message"), Message);
+		}
+	}
+	EventHub.Publish(EMCPEventTopic::Job, EventJson);
+}
+
+bool FMCPHttpServer::HandleEvents(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	UE_LOG(LogUnrealMCP, Verbose, TEXT("Received /events request"));
+	FMCPLatencyScope LatencyScope(StatusSnapshot, EMCPRequestClass::Read);
+
+	TSharedPtr<FJsonObject> ErrorJson = MakeShareable(new FJsonObject);
+	ErrorJson->SetBoolField(TEXT("success"), false);
+
+	const FString* SubscriberParam = Request.QueryParams.Find(TEXT("subscriber"));
+	if (!SubscriberParam || !FMCPEventHub::IsValidSubscriberId(*SubscriberParam))
+	{
+		ErrorJson->SetStringField(TEXT("message"), TEXT("Missing or invalid 'subscriber' query parameter (1-64 characters of A-Z, a-z, 0-9, '.', '_', '-')"));
+		SendJsonResponse(ErrorJson, EHttpServerResponseCodes::BadRequest, OnComplete);
+		return true;
+	}
+
+	uint32 TopicMask = 0;
+	const FString* TopicsParam = Request.QueryParams.Find(TEXT("topics"));
+	if (!FMCPEventHub::ParseTopics(TopicsParam ? *TopicsParam : FString(), TopicMask))
+	{
+		ErrorJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Unknown topic in '%s'. Use 'job', 'compile' and/or 'log'."), **TopicsParam));
+		SendJsonResponse(ErrorJson, EHttpServerResponseCodes::BadRequest, OnComplete);
+		return true;
+	}
+
+	EMCPEventFormat Format = EMCPEventFormat::ServerSentEvents;
+	if (const FString* FormatParam = Request.QueryParams.Find(TEXT("format")))
+	{
+		if (FormatParam->Equals(TEXT("json"), ESearchCase::IgnoreCase))
+		{
+			Format = EMCPEventFormat::Json;
+		}
+		else if (!FormatParam->Equals(TEXT("sse"), ESearchCase::IgnoreCase))
+		{
+			ErrorJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Unsupported format '%s'. Use 'sse' or 'json'."), **FormatParam));
+			SendJsonResponse(ErrorJson, EHttpServerResponseCodes::BadRequest, OnComplete);
+			return true;
+		}
+	}
+
+	double TimeoutSeconds = DefaultEventPollSeconds;
+	if (const FString* TimeoutParam = Request.QueryParams.Find(TEXT("timeout")))
+	{
+		TimeoutSeconds = FMath::Clamp(FCString::Atod(**TimeoutParam), 0.0, MaxEventPollSeconds);
+	}
+
+	// EventSource sends Last-Event-ID when it reconnects; clients that cannot set headers use the query parameter
+	uint64 LastEventId = 0;
+	if (const FString* LastEventIdHeader = FindHeader(Request, TEXT("Last-Event-ID")))
+	{
+		LastEventId = FCString::Strtoui64(**LastEventIdHeader, nullptr, 10);
+	}
+	else if (const FString* LastEventIdParam = Request.QueryParams.Find(TEXT("last_event_id")))
+	{
+		LastEventId = FCString::Strtoui64(**LastEventIdParam, nullptr, 10);
+	}
+
+	if (!EventHub.Poll(*SubscriberParam, LastEventId, TopicMask, TimeoutSeconds, Format, OnComplete))
+	{
+		ErrorJson->SetStringField(TEXT("message"), TEXT("Too many event subscribers are polling; retry later"));
+		TUniquePtr<FHttpServerResponse> Response = MakeJsonResponse(ErrorJson, EHttpServerResponseCodes::ServiceUnavail);
+		Response->Headers.Add(TEXT("Retry-After"), { TEXT("1") });
+		OnComplete(MoveTemp(Response));
+	}
+	return true;
+}
 
-	// Add the node to the graph
-	EventGraph->AddNode(NewFunctionNode, true, true);
+void FMCPHttpServer::SendReplayResponse(const FMCPOperationResult& Result, const FHttpResultCallback& OnComplete, EMCPBodyEncoding Encoding)
+{
+	// The cached object is shared by every replay, so mark a copy
+	TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+	ResponseJson->Values = Result.Json->Values;
+	ResponseJson->SetBoolField(TEXT("idempotent_replay"), true);
 
-	// Position the node
-	NewFunctionNode->NodePosX = 200;
-	NewFunctionNode->NodePosY = 200;
+	TUniquePtr<FHttpServerResponse> Response = MakeJsonResponse(ResponseJson, Result.Code, Encoding);
+	Response->Headers.Add(TEXT("Idempotent-Replayed"), { TEXT("true") });
+	OnComplete(MoveTemp(Response));
+}
 
-	// Allocate default pins for the node
-	NewFunctionNode->AllocateDefaultPins();
+bool FMCPHttpServer::HandleListJobs(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	FMCPLatencyScope LatencyScope(StatusSnapshot, EMCPRequestClass::Read);
 
-	// Reconstruct the node to ensure proper setup
-	NewFunctionNode->ReconstructNode();
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	JobQueue.WriteJobs(ResponseJson);
 
-	// Mark the Blueprint as modified
-	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(NewBlueprint);
+	SendJsonResponse(ResponseJson, EHttpServerResponseCodes::Ok, OnComplete);
+	return true;
+}
 
-	// Mark the package as dirty and save immediately to disk
-	Package->MarkAsFullyLoaded();
-	Package->SetDirtyFlag(true);
+bool FMCPHttpServer::HandleCancelJob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const FString* IdParam = Request.PathParams.Find(TEXT("id"));
+	const FString JobId = IdParam ? *IdParam : FString();
+	UE_LOG(LogUnrealMCP, Log, TEXT("Received /jobs/%s/cancel request"), *JobId);
+
+	// Routes share the game thread with running jobs, so only queued jobs can still be cancelled
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	const bool bCancelled = !JobId.IsEmpty() && JobQueue.Cancel(JobId);
+	ResponseJson->SetBoolField(TEXT("success"), bCancelled);
+	ResponseJson->SetStringField(TEXT("job_id"), JobId);
+	ResponseJson->SetStringField(TEXT("message"), bCancelled
+		? FString::Printf(TEXT("Job '%s' cancelled"), *JobId)
+		: FString::Printf(TEXT("No queued job '%s'; it may have already run"), *JobId));
+
+	SendJsonResponse(ResponseJson, bCancelled ? EHttpServerResponseCodes::Ok : EHttpServerResponseCodes::NotFound, OnComplete);
+	return true;
+}
+
+bool FMCPHttpServer::HandleQueryAssets(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	FMCPLatencyScope LatencyScope(StatusSnapshot, EMCPRequestClass::Read);
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	const EMCPBodyEncoding Encoding = GetResponseEncoding(Request);
+
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!ParseJsonBody(Request, JsonObject))
+	{
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), TEXT("Invalid JSON in request body"));
+		SendJsonResponse(ResponseJson, EHttpServerResponseCodes::BadRequest, OnComplete, Encoding);
+		return true;
+	}
 
-	// Save the package to disk immediately
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(FullPackageName, FPackageName::GetAssetPackageExtension());
-	UE_LOG(LogUnrealMCP, Warning, TEXT("Package path conversion: '%s' -> '%s'"), *FullPackageName, *PackageFileName);
+	FMCPAssetQueryOptions Options;
+	JsonObject->TryGetStringField(TEXT("path_prefix"), Options.PathPrefix);
+	JsonObject->TryGetBoolField(TEXT("recursive"), Options.bRecursive);
+	int32 Limit = Options.Limit;
+	if (JsonObject->TryGetNumberField(TEXT("limit"), Limit))
+	{
+		Options.Limit = FMath::Clamp(Limit, 1, FMCPAssetQuery::MaxPaths);
+	}
 
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-	SaveArgs.Error = GError;
-	SaveArgs.bForceByteSwapping = true;
-	SaveArgs.bWarnOfLongFilename = true;
-	SaveArgs.SaveFlags = SAVE_NoError;
+	const TArray<TSharedPtr<FJsonValue>>* PathsArray = nullptr;
+	if (Options.PathPrefix.IsEmpty() && JsonObject->TryGetArrayField(TEXT("paths"), PathsArray))
+	{
+		if (PathsArray->Num() > FMCPAssetQuery::MaxPaths)
+		{
+			ResponseJson->SetBoolField(TEXT("success"), false);
+			ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("At most %d paths per query"), FMCPAssetQuery::MaxPaths));
+			SendJsonResponse(ResponseJson, EHttpServerResponseCodes::BadRequest, OnComplete, Encoding);
+			return true;
+		}
 
-	bool bSaved = UPackage::SavePackage(Package, NewBlueprint, *PackageFileName, SaveArgs);
+		Options.Paths.Reserve(PathsArray->Num());
+		for (const TSharedPtr<FJsonValue>& PathValue : *PathsArray)
+		{
+			Options.Paths.Add(PathValue->AsString());
+		}
+	}
 
-	if (!bSaved)
+	if (Options.PathPrefix.IsEmpty() ? Options.Paths.Num() == 0 : !Options.PathPrefix.StartsWith(TEXT("/")))
 	{
-		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to save Blueprint package to disk"));
-		return false;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), TEXT("Provide a non-empty 'paths' array or a 'path_prefix' starting with '/'"));
+		SendJsonResponse(ResponseJson, EHttpServerResponseCodes::BadRequest, OnComplete, Encoding);
+		return true;
+	}
+
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	FMCPAssetQuery::Run(Options, ResponseJson);
+
+	UE_LOG(LogUnrealMCP, Verbose, TEXT("Answered /assets/query for %d asset(s) in %.2f ms"),
+		static_cast<int32>(ResponseJson->GetNumberField(TEXT("count"))), ResponseJson->GetNumberField(TEXT("elapsed_ms")));
+
+	SendJsonResponse(ResponseJson, EHttpServerResponseCodes::Ok, OnComplete, Encoding);
+	return true;
+}
+
+bool FMCPHttpServer::HandleMemory(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	UE_LOG(LogUnrealMCP, Log, TEXT("Received /memory request"));
+	FMCPLatencyScope LatencyScope(StatusSnapshot, EMCPRequestClass::Read);
+
+	const FString* GCParam = Request.QueryParams.Find(TEXT("gc"));
+	const bool bCollectGarbage = GCParam && GCParam->ToBool();
+
+	const FString* ResetParam = Request.QueryParams.Find(TEXT("reset"));
+	if (ResetParam && ResetParam->ToBool())
+	{
+		MemoryTracker.Reset();
 	}
 
-	// Register with asset registry
-	FAssetRegistryModule::AssetCreated(NewBlueprint);
+	int32 TopClassCount = 20;
+	if (const FString* TopParam = Request.QueryParams.Find(TEXT("top")))
+	{
+		TopClassCount = FMath::Clamp(FCString::Atoi(**TopParam), 1, 500);
+	}
 
-	UE_LOG(LogUnrealMCP, Log, TEXT("Successfully created Blueprint with PrintString node at: %s"), *BlueprintPath);
+	MemoryTracker.Sample(OperationRunner->GetCreatedAssetCount(), bCollectGarbage);
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	MemoryTracker.WriteJson(ResponseJson, TopClassCount);
+
+	SendJsonResponse(ResponseJson, EHttpServerResponseCodes::Ok, OnComplete);
 	return true;
+}
 
-#else
-	UE_LOG(LogUnrealMCP, Error, TEXT("Blueprint creation is only supported in editor builds"));
-	return false;
-#endif
-}
\ No newline at end of file
+const FString* FMCPHttpServer::FindHeader(const FHttpServerRequest& Request, const TCHAR* Name)
+{
+	// FString keys compare case-insensitively, as header names should
+	const TArray<FString>* Values = Request.Headers.Find(Name);
+	return Values && Values->Num() > 0 ? &(*Values)[0] : nullptr;
+}
+
+bool FMCPHttpServer::HasMsgPackBody(const FHttpServerRequest& Request)
+{
+	const FString* ContentTypeHeader = FindHeader(Request, TEXT("Content-Type"));
+	return ContentTypeHeader && ContentTypeHeader->StartsWith(FMCPMsgPack::ContentType, ESearchCase::IgnoreCase);
+}
+
+EMCPBodyEncoding FMCPHttpServer::GetResponseEncoding(const FHttpServerRequest& Request)
+{
+	// Accept may arrive as one comma-separated value or split into several
+	if (const TArray<FString>* AcceptValues = Request.Headers.Find(TEXT("Accept")))
+	{
+		for (const FString& AcceptValue : *AcceptValues)
+		{
+			TArray<FString> Entries;
+			AcceptValue.ParseIntoArray(Entries, TEXT(","));
+			for (const FString& Entry : Entries)
+			{
+				// "application/msgpack;q=0" refuses MessagePack like "gzip;q=0" refuses gzip
+				FString MediaType = Entry;
+				FString Parameters;
+				Entry.Split(TEXT(";"), &MediaType, &Parameters);
+				if (MediaType.TrimStartAndEnd().Equals(FMCPMsgPack::ContentType, ESearchCase::IgnoreCase) && !FMCPCompression::HasZeroQuality(Parameters))
+				{
+					return EMCPBodyEncoding::MsgPack;
+				}
+			}
+		}
+	}
+	return EMCPBodyEncoding::Json;
+}
+
+bool FMCPHttpServer::ParseJsonBody(const FHttpServerRequest& Request, TSharedPtr<FJsonObject>& OutJsonObject) const
+{
+	TArray<uint8> InflatedBody;
+	const TArray<uint8>* Body = DecodeRequestBody(Request, InflatedBody);
+	if (!Body || Body->Num() == 0)
+	{
+		return false;
+	}
+
+	if (HasMsgPackBody(Request))
+	{
+		return FMCPMsgPack::Decode(*Body, OutJsonObject);
+	}
+
+	// Create a null-terminated string from the byte array
+	TArray<uint8> NullTerminatedBody = *Body;
+	NullTerminatedBody.Add(0);
+	const FString RequestBody = FString(FUTF8ToTCHAR(reinterpret_cast<const char*>(NullTerminatedBody.GetData())));
+
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RequestBody);
+	return FJsonSerializer::Deserialize(Reader, OutJsonObject) && OutJsonObject.IsValid();
+}
+
+void FMCPHttpServer::SendJsonResponse(const TSharedPtr<FJsonObject>& ResponseJson, EHttpServerResponseCodes Code, const FHttpResultCallback& OnComplete, EMCPBodyEncoding Encoding)
+{
+	// Send response
+	OnComplete(MakeJsonResponse(ResponseJson, Code, Encoding));
+}
+
+TUniquePtr<FHttpServerResponse> FMCPHttpServer::MakeJsonResponse(const TSharedPtr<FJsonObject>& ResponseJson, EHttpServerResponseCodes Code, EMCPBodyEncoding Encoding)
+{
+	if (Encoding == EMCPBodyEncoding::MsgPack)
+	{
+		TArray<uint8> ResponseBytes;
+		FMCPMsgPack::Encode(ResponseJson.ToSharedRef(), ResponseBytes);
+
+		TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(MoveTemp(ResponseBytes), FMCPMsgPack::ContentType);
+		Response->Code = Code;
+		return Response;
+	}
+
+	// Serialize response to JSON string
+	FString ResponseString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
+	FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
+
+	// Create HTTP response
+	TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ResponseString, TEXT("application/json"));
+	Response->Code = Code;
+	return Response;
+}
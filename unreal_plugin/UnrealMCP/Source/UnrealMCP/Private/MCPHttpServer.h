@@ -6,10 +6,48 @@
 #include "HttpRequestHandler.h"
 #include "HttpResultCallback.h"
 #include "HttpRouteHandle.h"
+#include "HttpServerResponse.h"
+#include "Containers/Ticker.h"
+#include "MCPServerWarmUp.h"
+#include "MCPMemoryTracker.h"
+#include "MCPJobQueue.h"
+#include "MCPIdempotencyCache.h"
+#include "MCPStatusSnapshot.h"
+#include "MCPHealthListener.h"
+#include "MCPCompression.h"
+#include "MCPEventHub.h"
+#include "MCPWebSocketServer.h"
 
+class FJsonObject;
+class FMCPOperationRunner;
 class IHttpRouter;
 struct FHttpServerRequest;
 
+/** Encoding of a response body, negotiated through the request's Accept header */
+enum class EMCPBodyEncoding : uint8
+{
+	Json,
+	/** application/msgpack, see FMCPMsgPack */
+	MsgPack
+};
+
+/** Behaviour MakeRouteHandler adds around a route handler */
+enum class EMCPRouteFlags : uint8
+{
+	None = 0,
+	/** Compress large responses per the request's Accept-Encoding */
+	Compress = 1 << 0,
+	/** Add the answered request to the editor request log and publish it on the "log" event topic */
+	Log = 1 << 1
+};
+ENUM_CLASS_FLAGS(EMCPRouteFlags);
+
+/** Called for every answered request that is logged; the editor subsystem binds it to fill its request log */
+DECLARE_DELEGATE_FourParams(FMCPOnRequestLogged, const FString& /*Method*/, const FString& /*Path*/, int32 /*StatusCode*/, const FString& /*ClientIP*/);
+
+/** Called while /status is built, so the server's owner can add its own timings to the "startup" object */
+DECLARE_DELEGATE_OneParam(FMCPOnWriteStartupStats, const TSharedRef<FJsonObject>& /*StartupJson*/);
+
 /**
  * HTTP Server for handling MCP (Model Context Protocol) requests
  * Listens on a specified port and processes Blueprint node creation requests
@@ -32,6 +70,16 @@ public:
 	 */
 	void StopServer();
 
+	/**
+	 * Rebind this server's routes; on the same port other HTTP listeners are not touched
+	 * Warm-up state, cached templates, queued jobs, event subscribers, WebSocket connections and the health
+	 * listener survive the restart. A different port moves only the HTTP listener, which releases the old
+	 * port with StopAllListeners; if the new port cannot be bound the server goes back to the old one.
+	 * @param Port The port to listen on
+	 * @return True if routes are bound on the requested port
+	 */
+	bool RestartServer(uint32 Port);
+
 	/**
 	 * Check if the server is currently running
 	 * @return True if server is running
@@ -44,6 +92,42 @@ public:
 	 */
 	uint32 GetServerPort() const;
 
+	/**
+	 * Check if the server has finished warming up and is ready for requests
+	 * @return True if server is running and warm-up has completed
+	 */
+	bool IsServerReady() const;
+
+	/**
+	 * Time spent creating the router and binding routes during the last start
+	 * @return Seconds, or 0 if the server has not been started
+	 */
+	double GetRouterBindSeconds() const { return RouterBindSeconds; }
+
+	/**
+	 * Time spent in the last RestartServer call
+	 * @return Seconds, or 0 if the server has not been restarted
+	 */
+	double GetLastRestartSeconds() const { return LastRestartSeconds; }
+
+	/**
+	 * Run a request on the route its path names, as if it had arrived over HTTP
+	 * Used by transports other than the HTTP router; the request is logged like a routed one but not compressed.
+	 * The verb is set from the route, and /jobs/<id>/cancel fills PathParams.
+	 * @param Request The request; RelativePath selects the route
+	 * @param OnComplete Callback to send response
+	 * @return False if no route matches the path
+	 */
+	bool DispatchRequest(FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/** Request-log sink; the server itself knows nothing about the editor */
+	FMCPOnRequestLogged& OnRequestLogged() { return OnRequestLoggedDelegate; }
+
+	/** Extra "startup" fields for /status */
+	FMCPOnWriteStartupStats& OnWriteStartupStats() { return OnWriteStartupStatsDelegate; }
+
+	/** Event hub behind /events, shared with the WebSocket transport */
+	FMCPEventHub& GetEventHub() { return EventHub; }
 
 private:
 	/**
@@ -57,6 +141,74 @@ private:
 	 */
 	void UnbindRoutes();
 
+	/**
+	 * Create the router for a port, bind routes and start listening
+	 * @return True if routes are bound on the port
+	 */
+	bool StartListener(uint32 Port);
+
+	/** Unbind routes, drop the router and release its port; jobs, events and other endpoints are untouched */
+	void StopListener();
+
+	/** A route handler member, e.g. &FMCPHttpServer::HandleAddNode */
+	using FRouteHandler = bool (FMCPHttpServer::*)(const FHttpServerRequest&, const FHttpResultCallback&);
+
+	/**
+	 * Wrap a route handler with response compression and request logging
+	 * @param Handler The route handler
+	 * @param Flags Behaviour to add
+	 * @return Delegate for IHttpRouter::BindRoute
+	 */
+	FHttpRequestHandler MakeRouteHandler(FRouteHandler Handler, EMCPRouteFlags Flags);
+
+	/**
+	 * Wrap a completion callback so that the answered request is logged and published as a "log" event
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return Callback that logs, then calls OnComplete
+	 */
+	FHttpResultCallback WithRequestLog(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Wrap a completion callback so that responses at or above the configured threshold are compressed
+	 * Compression runs on a worker thread; the wrapped callback is then called back on the game thread
+	 * @param Request The HTTP request, for its Accept-Encoding header
+	 * @param OnComplete Callback to send response
+	 * @return OnComplete itself if the client does not accept gzip or deflate
+	 */
+	FHttpResultCallback WithResponseCompression(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) const;
+
+	/**
+	 * Undo the request's Content-Encoding
+	 * @param Request The HTTP request
+	 * @param Storage Receives the inflated bytes of a gzip or deflate body
+	 * @return The body to parse (Request.Body or Storage), or null if the coding is unsupported, corrupt or inflates past the limit
+	 */
+	const TArray<uint8>* DecodeRequestBody(const FHttpServerRequest& Request, TArray<uint8>& Storage) const;
+
+	/**
+	 * Run one warm-up stage per tick until warm-up completes
+	 * @return True to keep ticking
+	 */
+	bool TickWarmUp(float DeltaTime);
+
+	/**
+	 * Publish a fresh status snapshot for the health listener
+	 * @return True to keep ticking
+	 */
+	bool TickStatusSnapshot(float DeltaTime);
+
+	/**
+	 * Build the /status response from current server state (game thread)
+	 * @return A new object, safe to publish as a snapshot
+	 */
+	TSharedRef<FJsonObject> BuildStatusJson() const;
+
+	/**
+	 * Finish any pending warm-up stages before handling a request that needs them
+	 */
+	void EnsureWarmedUp();
+
 	/**
 	 * Handle POST /add_node requests
 	 * @param Request The HTTP request
@@ -74,20 +226,210 @@ private:
 	bool HandleStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 
 	/**
-	 * Create a new Blueprint and add a PrintString node to it
-	 * @param BlueprintPath The asset path for the new Blueprint (e.g., "/Game/MyBlueprint")
-	 * @param NodeType The type of node to add (currently only "PrintString" supported)
-	 * @return True if Blueprint was created and node added successfully
+	 * Handle GET /export_graph requests
+	 * Query parameters: blueprint_path, graph, cursor, limit, max_bytes, format (json|ndjson)
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleExportGraph(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle POST /stamp requests
+	 * Stamps one or more assets from a named Blueprint template
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleStamp(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle POST /commit requests
+	 * Saves a Blueprint kept by an /add_node dry run at the path it was built for
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleCommit(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle GET /memory requests
+	 * Samples UObject counts by class, package count and RSS and reports growth since the first sample
+	 * Query parameters: gc (default false, a full collection stalls the game thread), top, reset
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleMemory(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle GET /jobs requests
+	 * Lists queued jobs in run order
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleListJobs(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle POST /assets/query requests
+	 * Answers existence, class and saved state for many paths or a path prefix from the asset registry
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleQueryAssets(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle POST /jobs/:id/cancel requests
+	 * The ID is a job ID or the X-MCP-Request-Id the job was submitted with
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleCancelJob(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Handle GET /events requests
+	 * Long poll for job, compile and request-log events as server-sent events, see FMCPEventHub
+	 * Query parameters: subscriber (required), topics, timeout, last_event_id, format (sse|json)
+	 * @param Request The HTTP request
+	 * @param OnComplete Callback to send response
+	 * @return True if request was handled
+	 */
+	bool HandleEvents(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Publish a job state change on the "job" event topic
+	 * @param JobId The job ID, or 0 for a rejected request that never became a job
+	 * @param Route Route that produced the job
+	 * @param ClientRequestId X-MCP-Request-Id the job was submitted with, if any
+	 * @param State queued, running, completed, cancelled, expired, shutdown or rejected
+	 * @param Result Final result, for the response code and success flag
+	 */
+	void PublishJobEvent(uint64 JobId, const FString& Route, const FString& ClientRequestId, const TCHAR* State, const FMCPOperationResult* Result = nullptr);
+
+	/**
+	 * Queue a mutation for the game-thread job queue, or answer 429 with Retry-After when it is full
+	 * OnComplete is called when the job runs, is cancelled or expires
+	 * Reads the X-MCP-Deadline-Ms (remaining client timeout), X-MCP-Request-Id and Idempotency-Key headers
+	 * @param Route Route path passed to FMCPOperationRunner::Execute
+	 * @param Body Parsed request body
+	 * @param Request The HTTP request, for its headers
+	 * @param OnComplete Callback to send response
+	 */
+	void EnqueueOperation(const FString& Route, const TSharedPtr<FJsonObject>& Body, const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	/**
+	 * Send a cached result with Idempotent-Replayed: true
+	 * @param Result The result recorded for the Idempotency-Key
+	 * @param OnComplete Callback to send response
+	 * @param Encoding Response encoding
+	 */
+	static void SendReplayResponse(const FMCPOperationResult& Result, const FHttpResultCallback& OnComplete, EMCPBodyEncoding Encoding);
+
+	/**
+	 * Get the first value of a request header
+	 * @return The value, or nullptr if the header is missing
+	 */
+	static const FString* FindHeader(const FHttpServerRequest& Request, const TCHAR* Name);
+
+	/** Whether the request body is MessagePack (Content-Type: application/msgpack) rather than JSON text */
+	static bool HasMsgPackBody(const FHttpServerRequest& Request);
+
+	/** Response encoding for a request: MessagePack if its Accept header lists application/msgpack without q=0 */
+	static EMCPBodyEncoding GetResponseEncoding(const FHttpServerRequest& Request);
+
+	/**
+	 * Parse the request body as a JSON object
+	 * MessagePack bodies are decoded straight into the object, without going through JSON text
+	 * @param Request The HTTP request
+	 * @param OutJsonObject Receives the parsed object
+	 * @return True if the body is a valid JSON object
+	 */
+	bool ParseJsonBody(const FHttpServerRequest& Request, TSharedPtr<FJsonObject>& OutJsonObject) const;
+
+	/**
+	 * Serialize a JSON object and send it as the response
+	 * @param ResponseJson The response body
+	 * @param Code The HTTP status code
+	 * @param OnComplete Callback to send response
+	 * @param Encoding Response encoding
 	 */
-	bool CreateBlueprintWithPrintString(const FString& BlueprintPath, const FString& NodeType);
+	void SendJsonResponse(const TSharedPtr<FJsonObject>& ResponseJson, EHttpServerResponseCodes Code, const FHttpResultCallback& OnComplete, EMCPBodyEncoding Encoding = EMCPBodyEncoding::Json);
+
+	/**
+	 * Serialize a JSON object into a response without sending it
+	 * @param ResponseJson The response body
+	 * @param Code The HTTP status code
+	 * @param Encoding Response encoding
+	 * @return The response, ready for extra headers
+	 */
+	static TUniquePtr<FHttpServerResponse> MakeJsonResponse(const TSharedPtr<FJsonObject>& ResponseJson, EHttpServerResponseCodes Code, EMCPBodyEncoding Encoding = EMCPBodyEncoding::Json);
 
 private:
+	/** Executes /add_node and /stamp bodies; shared with the UnrealMCP commandlet */
+	TUniquePtr<FMCPOperationRunner> OperationRunner;
+
+	/** Final responses by Idempotency-Key, and duplicates waiting on in-flight requests; declared before JobQueue, whose cancellations complete entries */
+	FMCPIdempotencyCache IdempotencyCache;
+
+	/** Job, compile and request-log events for /events; declared before JobQueue, whose cancellations publish job events */
+	FMCPEventHub EventHub;
+
+	/** Mutations waiting for game-thread time; bounded by count and estimated cost */
+	FMCPJobQueue JobQueue;
+
+	/** Status published for the health listener, and per-class request latencies */
+	FMCPStatusSnapshot StatusSnapshot;
+
+	/** Answers /status from StatusSnapshot on its own thread; declared after the snapshot it serves */
+	FMCPHealthListener HealthListener;
+	FTSTicker::FDelegateHandle SnapshotTickerHandle;
+
+	/** Persistent WebSocket transport for the same routes; declared after the hub and queue it dispatches into */
+	FMCPWebSocketServer WebSocketServer;
+
+	/** Compression counters; shared with in-flight worker tasks, which may finish after the server stops */
+	TSharedRef<FMCPCompressionStats> CompressionStats;
+
+	/** Bound by the owner; see OnRequestLogged and OnWriteStartupStats */
+	FMCPOnRequestLogged OnRequestLoggedDelegate;
+	FMCPOnWriteStartupStats OnWriteStartupStatsDelegate;
+
+	/** Memory samples taken by /memory, kept across requests so growth can be tracked live */
+	FMCPMemoryTracker MemoryTracker;
+
 	/** HTTP Router instance */
 	TSharedPtr<IHttpRouter> HttpRouter;
 
 	/** Route handles */
 	FHttpRouteHandle AddNodeRouteHandle;
 	FHttpRouteHandle StatusRouteHandle;
+	FHttpRouteHandle ExportGraphRouteHandle;
+	FHttpRouteHandle StampRouteHandle;
+	FHttpRouteHandle CommitRouteHandle;
+	FHttpRouteHandle MemoryRouteHandle;
+	FHttpRouteHandle ListJobsRouteHandle;
+	FHttpRouteHandle CancelJobRouteHandle;
+	FHttpRouteHandle QueryAssetsRouteHandle;
+	FHttpRouteHandle EventsRouteHandle;
+
+	/** Warm-up stages run while the server reports "starting" */
+	FMCPServerWarmUp WarmUp;
+	FTSTicker::FDelegateHandle WarmUpTickerHandle;
+
+	/** /add_node latency, used to compare the first (cold) request with later (warm) ones */
+	double FirstAddNodeSeconds = -1.0;
+	double LastAddNodeSeconds = -1.0;
+	int32 AddNodeCount = 0;
+
+	/** Router creation and route binding time during the last start */
+	double RouterBindSeconds = 0.0;
+
+	/** Route rebind time during the last restart */
+	double LastRestartSeconds = 0.0;
+	int32 RestartCount = 0;
 
 	/** Server state */
 	uint32 ServerPort;
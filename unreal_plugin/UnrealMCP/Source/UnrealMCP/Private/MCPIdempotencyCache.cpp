@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPIdempotencyCache.h"
+#include "IUnrealMCP.h"
+#include "UnrealMCPSettings.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+	void AppendCanonical(const FJsonObject& Object, FString& Out);
+
+	/** Type-tagged and length-prefixed, so no two different values share a form */
+	void AppendCanonical(const TSharedPtr<FJsonValue>& Value, FString& Out)
+	{
+		if (!Value.IsValid())
+		{
+			Out += TEXT("n");
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+			Out += Value->AsBool() ? TEXT("t") : TEXT("f");
+			break;
+		case EJson::Number:
+			Out += FString::Printf(TEXT("d%.17g;"), Value->AsNumber());
+			break;
+		case EJson::String:
+		{
+			const FString String = Value->AsString();
+			Out += FString::Printf(TEXT("s%d:"), String.Len());
+			Out += String;
+			break;
+		}
+		case EJson::Array:
+			Out += TEXT("[");
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				AppendCanonical(Element, Out);
+			}
+			Out += TEXT("]");
+			break;
+		case EJson::Object:
+			AppendCanonical(*Value->AsObject(), Out);
+			break;
+		default:
+			Out += TEXT("n");
+			break;
+		}
+	}
+
+	void AppendCanonical(const FJsonObject& Object, FString& Out)
+	{
+		TArray<FString> Keys;
+		Object.Values.GenerateKeyArray(Keys);
+		Keys.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+
+		Out += TEXT("{");
+		for (const FString& Key : Keys)
+		{
+			Out += FString::Printf(TEXT("k%d:"), Key.Len());
+			Out += Key;
+			AppendCanonical(Object.Values.FindChecked(Key), Out);
+		}
+		Out += TEXT("}");
+	}
+}
+
+FMCPIdempotencyCache::FMCPIdempotencyCache()
+	: Entries(1) // Sized from the settings on first use
+{
+}
+
+uint32 FMCPIdempotencyCache::HashBody(const TSharedPtr<FJsonObject>& Body)
+{
+	if (!Body.IsValid())
+	{
+		return 0;
+	}
+
+	FString Canonical;
+	AppendCanonical(*Body, Canonical);
+	return FCrc::MemCrc32(*Canonical, Canonical.Len() * sizeof(TCHAR));
+}
+
+TSharedPtr<FMCPIdempotencyEntry> FMCPIdempotencyCache::Begin(const FString& Key, uint32 BodyHash, EMCPIdempotencyLookup& OutLookup)
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutLookup = EMCPIdempotencyLookup::Miss;
+	if (Settings->IdempotencyCacheSize <= 0)
+	{
+		return nullptr;
+	}
+
+	// A resized cache starts empty; requests already in flight still complete through their entries
+	if (Entries.Max() != Settings->IdempotencyCacheSize)
+	{
+		Entries.Empty(Settings->IdempotencyCacheSize);
+	}
+
+	if (const TSharedPtr<FMCPIdempotencyEntry>* Found = Entries.FindAndTouch(Key))
+	{
+		const TSharedPtr<FMCPIdempotencyEntry> Entry = *Found;
+		const bool bStale = Entry->bCompleted && FPlatformTime::Seconds() - Entry->CompletedSeconds > Settings->IdempotencyTTLSeconds;
+		if (!bStale)
+		{
+			if (Entry->BodyHash != BodyHash)
+			{
+				++Mismatches;
+				OutLookup = EMCPIdempotencyLookup::Mismatch;
+				return nullptr;
+			}
+
+			if (Entry->bCompleted)
+			{
+				++Replays;
+				OutLookup = EMCPIdempotencyLookup::Completed;
+			}
+			else
+			{
+				++Joins;
+				OutLookup = EMCPIdempotencyLookup::InFlight;
+			}
+			return Entry;
+		}
+
+		Entries.Remove(Key);
+	}
+
+	if (Entries.Num() >= Entries.Max())
+	{
+		++Evictions;
+	}
+
+	++Misses;
+	TSharedPtr<FMCPIdempotencyEntry> Entry = MakeShared<FMCPIdempotencyEntry>();
+	Entry->BodyHash = BodyHash;
+	Entries.Add(Key, Entry);
+	return Entry;
+}
+
+void FMCPIdempotencyCache::Complete(const FString& Key, const TSharedPtr<FMCPIdempotencyEntry>& Entry, const FMCPOperationResult& Result, bool bCacheable)
+{
+	if (!Entry.IsValid())
+	{
+		return;
+	}
+
+	Entry->bCompleted = true;
+	Entry->Result = Result;
+	Entry->CompletedSeconds = FPlatformTime::Seconds();
+
+	if (!bCacheable)
+	{
+		// Only forget the key if it still refers to this request
+		const TSharedPtr<FMCPIdempotencyEntry>* Found = Entries.Find(Key);
+		if (Found && *Found == Entry)
+		{
+			Entries.Remove(Key);
+		}
+	}
+
+	// Duplicates share the outcome of the request they joined, cacheable or not
+	TArray<TFunction<void(const FMCPOperationResult&)>> Waiters = MoveTemp(Entry->Waiters);
+	Entry->Waiters.Reset();
+	if (Waiters.Num() > 0)
+	{
+		UE_LOG(LogUnrealMCP, Log, TEXT("Answering %d duplicate request(s) for Idempotency-Key '%s'"), Waiters.Num(), *Key);
+	}
+	for (const TFunction<void(const FMCPOperationResult&)>& Waiter : Waiters)
+	{
+		Waiter(Result);
+	}
+}
+
+void FMCPIdempotencyCache::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutJson->SetNumberField(TEXT("entries"), Entries.Num());
+	OutJson->SetNumberField(TEXT("capacity"), Settings->IdempotencyCacheSize);
+	OutJson->SetNumberField(TEXT("ttl_seconds"), Settings->IdempotencyTTLSeconds);
+	OutJson->SetNumberField(TEXT("misses"), static_cast<double>(Misses));
+	OutJson->SetNumberField(TEXT("replays"), static_cast<double>(Replays));
+	OutJson->SetNumberField(TEXT("joined_in_flight"), static_cast<double>(Joins));
+	OutJson->SetNumberField(TEXT("mismatches"), static_cast<double>(Mismatches));
+	OutJson->SetNumberField(TEXT("evictions"), static_cast<double>(Evictions));
+}
@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "MCPOperationRunner.h"
+
+class FJsonObject;
+
+/**
+ * Outcome of looking up an Idempotency-Key
+ */
+enum class EMCPIdempotencyLookup : uint8
+{
+	/** First use of the key; the caller runs the operation and completes the entry */
+	Miss,
+	/** The same request is queued or running; wait for its result */
+	InFlight,
+	/** The request already completed; replay its result */
+	Completed,
+	/** The key was used with a different request body */
+	Mismatch
+};
+
+/**
+ * One Idempotency-Key and the request it belongs to
+ */
+struct FMCPIdempotencyEntry
+{
+	/** HashBody of the request body, to reject a key reused for a different request */
+	uint32 BodyHash = 0;
+
+	/** Set once the result is known */
+	bool bCompleted = false;
+	FMCPOperationResult Result;
+	double CompletedSeconds = 0.0;
+
+	/** Duplicate requests waiting for the in-flight one */
+	TArray<TFunction<void(const FMCPOperationResult& Result)>> Waiters;
+};
+
+/**
+ * Bounded LRU cache from Idempotency-Key to final response, with a TTL, configured in UUnrealMCPSettings.
+ * Retries of a completed request are answered from the cache, and duplicates that arrive while the
+ * original is queued or running wait for it instead of creating the same assets again.
+ */
+class FMCPIdempotencyCache
+{
+public:
+	FMCPIdempotencyCache();
+
+	/**
+	 * Hash a parsed request body in a canonical form: object keys sorted, numbers as doubles
+	 * Equal for the same request sent as JSON text or MessagePack, over HTTP or WebSocket, compressed or not
+	 * @return CRC of the canonical form; 0 for a null body
+	 */
+	static uint32 HashBody(const TSharedPtr<FJsonObject>& Body);
+
+	/**
+	 * Look up a key, registering a new in-flight entry on a miss
+	 * @param Key The key, scoped by the caller (e.g., route + header value)
+	 * @param BodyHash HashBody of the request body
+	 * @param OutLookup What the caller should do next
+	 * @return The entry for Miss, InFlight and Completed; null for Mismatch or when the cache is disabled
+	 */
+	TSharedPtr<FMCPIdempotencyEntry> Begin(const FString& Key, uint32 BodyHash, EMCPIdempotencyLookup& OutLookup);
+
+	/**
+	 * Record the result of the request that owns an entry and answer its waiters
+	 * @param Key The key passed to Begin
+	 * @param Entry The entry returned by Begin
+	 * @param Result The final result
+	 * @param bCacheable False if the operation did not run to completion (rejected, cancelled, expired); the key is then forgotten so a retry runs again
+	 */
+	void Complete(const FString& Key, const TSharedPtr<FMCPIdempotencyEntry>& Entry, const FMCPOperationResult& Result, bool bCacheable);
+
+	/** Write entry count and hit counters */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	TLruCache<FString, TSharedPtr<FMCPIdempotencyEntry>> Entries;
+
+	/** Counters */
+	int64 Misses = 0;
+	int64 Replays = 0;
+	int64 Joins = 0;
+	int64 Mismatches = 0;
+	int64 Evictions = 0;
+};
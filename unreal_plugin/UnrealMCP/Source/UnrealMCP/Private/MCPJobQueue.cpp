@@ -0,0 +1,212 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPJobQueue.h"
+#include "IUnrealMCP.h"
+#include "UnrealMCPSettings.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Algo/AllOf.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Weight of the newest sample in the smoothed cost estimate */
+	constexpr double CostSmoothing = 0.2;
+
+	/** Retry-After bounds in seconds */
+	constexpr int32 MinRetryAfterSeconds = 1;
+	constexpr int32 MaxRetryAfterSeconds = 60;
+}
+
+FMCPJobQueue::FMCPJobQueue()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPJobQueue::Tick));
+}
+
+FMCPJobQueue::~FMCPJobQueue()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	CancelAll(TEXT("Server shutting down"));
+}
+
+uint64 FMCPJobQueue::Enqueue(FMCPJob&& Job, int32& OutRetryAfterSeconds)
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+
+	Job.Cost = FMath::Max(Job.Cost, 1);
+	const bool bDepthExceeded = Jobs.Num() >= Settings->MaxQueuedJobs;
+	const bool bCostExceeded = Jobs.Num() > 0 && QueuedCost + Job.Cost > Settings->MaxQueuedCost;
+	if (bDepthExceeded || bCostExceeded)
+	{
+		++RejectedJobs;
+		RejectedCost += Job.Cost;
+		OutRetryAfterSeconds = EstimateRetryAfterSeconds();
+
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Rejected %s (cost %d): queue holds %d job(s), cost %lld; retry after %d s"),
+			*Job.Route, Job.Cost, Jobs.Num(), QueuedCost, OutRetryAfterSeconds);
+		return 0;
+	}
+
+	Job.Id = NextJobId++;
+	Job.EnqueuedSeconds = FPlatformTime::Seconds();
+	QueuedCost += Job.Cost;
+
+	const uint64 JobId = Job.Id;
+	Jobs.Add(MoveTemp(Job));
+	MaxDepthSeen = FMath::Max(MaxDepthSeen, Jobs.Num());
+	OutRetryAfterSeconds = 0;
+	return JobId;
+}
+
+void FMCPJobQueue::CancelAll(const FString& Message)
+{
+	// Detach first so a Cancel callback cannot re-enter a queue that is being cleared
+	TArray<FMCPJob> CancelledJobList = MoveTemp(Jobs);
+	Jobs.Reset();
+	QueuedCost = 0;
+
+	for (const FMCPJob& Job : CancelledJobList)
+	{
+		++CancelledJobs;
+		if (Job.Cancel)
+		{
+			Job.Cancel(Job, EMCPJobCancelReason::Shutdown, Message);
+		}
+	}
+}
+
+bool FMCPJobQueue::Cancel(const FString& IdOrClientRequestId)
+{
+	if (IdOrClientRequestId.IsEmpty())
+	{
+		return false;
+	}
+
+	// A client request ID wins, so a numeric one (e.g. a WebSocket message id) never cancels the job with that number
+	int32 Index = Jobs.IndexOfByPredicate([&IdOrClientRequestId](const FMCPJob& Job)
+	{
+		return Job.ClientRequestId == IdOrClientRequestId;
+	});
+
+	// Otherwise only an all-digit value is a job ID; a uuid such as "4f3a..." must not parse as job 4
+	const bool bAllDigits = Algo::AllOf(IdOrClientRequestId, [](TCHAR Char) { return FChar::IsDigit(Char); });
+	if (Index == INDEX_NONE && bAllDigits)
+	{
+		const uint64 JobId = FCString::Strtoui64(*IdOrClientRequestId, nullptr, 10);
+		Index = Jobs.IndexOfByPredicate([JobId](const FMCPJob& Job)
+		{
+			return Job.Id == JobId;
+		});
+	}
+
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FMCPJob Job = MoveTemp(Jobs[Index]);
+	Jobs.RemoveAt(Index);
+	QueuedCost -= Job.Cost;
+	++CancelledJobs;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Cancelled queued job %llu (%s)"), Job.Id, *Job.Route);
+	if (Job.Cancel)
+	{
+		Job.Cancel(Job, EMCPJobCancelReason::Requested, TEXT("Cancelled by client before it ran"));
+	}
+	return true;
+}
+
+void FMCPJobQueue::WriteJobs(const TSharedRef<FJsonObject>& OutJson) const
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	TArray<TSharedPtr<FJsonValue>> JobValues;
+	for (const FMCPJob& Job : Jobs)
+	{
+		TSharedRef<FJsonObject> JobJson = MakeShared<FJsonObject>();
+		JobJson->SetNumberField(TEXT("job_id"), static_cast<double>(Job.Id));
+		if (!Job.ClientRequestId.IsEmpty())
+		{
+			JobJson->SetStringField(TEXT("request_id"), Job.ClientRequestId);
+		}
+		JobJson->SetStringField(TEXT("route"), Job.Route);
+		JobJson->SetNumberField(TEXT("cost"), Job.Cost);
+		JobJson->SetNumberField(TEXT("wait_ms"), (NowSeconds - Job.EnqueuedSeconds) * 1000.0);
+		if (Job.DeadlineSeconds > 0.0)
+		{
+			JobJson->SetNumberField(TEXT("deadline_in_ms"), (Job.DeadlineSeconds - NowSeconds) * 1000.0);
+		}
+		JobValues.Add(MakeShared<FJsonValueObject>(JobJson));
+	}
+	OutJson->SetArrayField(TEXT("jobs"), JobValues);
+}
+
+bool FMCPJobQueue::Tick(float DeltaTime)
+{
+	if (Jobs.Num() == 0)
+	{
+		return true;
+	}
+
+	const double BudgetSeconds = GetDefault<UUnrealMCPSettings>()->QueueFrameBudgetMs / 1000.0;
+	const double FrameStartTime = FPlatformTime::Seconds();
+
+	do
+	{
+		FMCPJob Job = MoveTemp(Jobs[0]);
+		Jobs.RemoveAt(0, 1, EAllowShrinking::No);
+		QueuedCost -= Job.Cost;
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (Job.HasExpired(StartTime))
+		{
+			// The client has given up; answer without spending game-thread time on it
+			++ExpiredJobs;
+			UE_LOG(LogUnrealMCP, Log, TEXT("Dropped job %llu (%s): deadline passed %.1f ms ago while queued"),
+				Job.Id, *Job.Route, (StartTime - Job.DeadlineSeconds) * 1000.0);
+			if (Job.Cancel)
+			{
+				Job.Cancel(Job, EMCPJobCancelReason::Expired, TEXT("Deadline exceeded while queued"));
+			}
+			continue;
+		}
+
+		const double WaitSeconds = StartTime - Job.EnqueuedSeconds;
+		TotalWaitSeconds += WaitSeconds;
+		MaxWaitSeconds = FMath::Max(MaxWaitSeconds, WaitSeconds);
+
+		Job.Run(Job);
+
+		const double RunSeconds = FPlatformTime::Seconds() - StartTime;
+		SecondsPerCost += CostSmoothing * (RunSeconds / Job.Cost - SecondsPerCost);
+		++CompletedJobs;
+	}
+	while (Jobs.Num() > 0 && FPlatformTime::Seconds() - FrameStartTime < BudgetSeconds);
+
+	return true;
+}
+
+int32 FMCPJobQueue::EstimateRetryAfterSeconds() const
+{
+	const double DrainSeconds = QueuedCost * SecondsPerCost;
+	return FMath::Clamp(FMath::CeilToInt(DrainSeconds), MinRetryAfterSeconds, MaxRetryAfterSeconds);
+}
+
+void FMCPJobQueue::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+	OutJson->SetNumberField(TEXT("depth"), Jobs.Num());
+	OutJson->SetNumberField(TEXT("max_depth"), Settings->MaxQueuedJobs);
+	OutJson->SetNumberField(TEXT("queued_cost"), static_cast<double>(QueuedCost));
+	OutJson->SetNumberField(TEXT("max_cost"), Settings->MaxQueuedCost);
+	OutJson->SetNumberField(TEXT("max_depth_seen"), MaxDepthSeen);
+	OutJson->SetNumberField(TEXT("completed"), static_cast<double>(CompletedJobs));
+	OutJson->SetNumberField(TEXT("rejected"), static_cast<double>(RejectedJobs));
+	OutJson->SetNumberField(TEXT("rejected_cost"), static_cast<double>(RejectedCost));
+	OutJson->SetNumberField(TEXT("cancelled"), static_cast<double>(CancelledJobs));
+	OutJson->SetNumberField(TEXT("expired"), static_cast<double>(ExpiredJobs));
+	OutJson->SetNumberField(TEXT("mean_wait_ms"), CompletedJobs > 0 ? TotalWaitSeconds * 1000.0 / CompletedJobs : 0.0);
+	OutJson->SetNumberField(TEXT("max_wait_ms"), MaxWaitSeconds * 1000.0);
+	OutJson->SetNumberField(TEXT("ms_per_cost"), SecondsPerCost * 1000.0);
+}
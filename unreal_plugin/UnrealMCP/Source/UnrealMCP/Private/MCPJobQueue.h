@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FJsonObject;
+
+/**
+ * Why a job was completed without running
+ */
+enum class EMCPJobCancelReason : uint8
+{
+	/** The queue was cleared, e.g. because the server stopped */
+	Shutdown,
+	/** The job's deadline passed while it was queued */
+	Expired,
+	/** A client asked for the job to be cancelled */
+	Requested
+};
+
+/**
+ * A unit of deferred game-thread work admitted by FMCPJobQueue
+ */
+struct FMCPJob
+{
+	/** Unique, increasing job ID */
+	uint64 Id = 0;
+
+	/** Route that produced the job, for stats and logs */
+	FString Route;
+
+	/** Estimated cost in assets created */
+	int32 Cost = 1;
+
+	/** Optional client-chosen ID that can be used instead of Id to cancel the job */
+	FString ClientRequestId;
+
+	/** FPlatformTime::Seconds when the job was admitted */
+	double EnqueuedSeconds = 0.0;
+
+	/** FPlatformTime::Seconds after which nobody wants the result, or 0 for no deadline */
+	double DeadlineSeconds = 0.0;
+
+	/** Run the job and complete its request */
+	TFunction<void(const FMCPJob& Job)> Run;
+
+	/** Complete the job's request without running it */
+	TFunction<void(const FMCPJob& Job, EMCPJobCancelReason CancelReason, const FString& Message)> Cancel;
+
+	/** Whether the deadline has passed */
+	bool HasExpired(double NowSeconds) const { return DeadlineSeconds > 0.0 && NowSeconds >= DeadlineSeconds; }
+};
+
+/**
+ * Bounded queue of mutation jobs, drained on the game thread within a per-frame time budget.
+ * Admission is limited by both job count and total estimated cost so a few very large requests
+ * cannot hold the editor any longer than many small ones.
+ */
+class FMCPJobQueue
+{
+public:
+	FMCPJobQueue();
+	~FMCPJobQueue();
+
+	/**
+	 * Admit a job if there is room
+	 * A job larger than the cost limit is still admitted when the queue is empty
+	 * @param Job The job; its ID and enqueue time are assigned here
+	 * @param OutRetryAfterSeconds Suggested client back-off when the job is rejected
+	 * @return The job ID, or 0 if the queue is full
+	 */
+	uint64 Enqueue(FMCPJob&& Job, int32& OutRetryAfterSeconds);
+
+	/** Cancel every queued job, e.g. when the server stops */
+	void CancelAll(const FString& Message);
+
+	/**
+	 * Cancel one queued job; a job that is already running cannot be cancelled
+	 * @param IdOrClientRequestId The client request ID the job was submitted with, or its job ID;
+	 *        a client request ID match wins, and only an all-digit value is read as a job ID
+	 * @return True if a queued job was found and cancelled
+	 */
+	bool Cancel(const FString& IdOrClientRequestId);
+
+	/** Write the queued jobs in run order */
+	void WriteJobs(const TSharedRef<FJsonObject>& OutJson) const;
+
+	/** Number of queued jobs */
+	int32 GetDepth() const { return Jobs.Num(); }
+
+	/** Write queue depth, cost and rejection counters */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	/** Run queued jobs until the frame budget is spent; at least one job runs per frame */
+	bool Tick(float DeltaTime);
+
+	/** Seconds a client should wait before the current backlog has likely drained */
+	int32 EstimateRetryAfterSeconds() const;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Queued jobs in arrival order */
+	TArray<FMCPJob> Jobs;
+	int64 QueuedCost = 0;
+	uint64 NextJobId = 1;
+
+	/** Smoothed execution time per unit of cost, used for Retry-After */
+	double SecondsPerCost = 0.05;
+
+	/** Counters */
+	int64 CompletedJobs = 0;
+	int64 RejectedJobs = 0;
+	int64 RejectedCost = 0;
+	int64 CancelledJobs = 0;
+	int64 ExpiredJobs = 0;
+	int32 MaxDepthSeen = 0;
+	double TotalWaitSeconds = 0.0;
+	double MaxWaitSeconds = 0.0;
+};
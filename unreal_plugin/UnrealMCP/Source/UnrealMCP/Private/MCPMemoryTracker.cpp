@@ -0,0 +1,234 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPMemoryTracker.h"
+#include "IUnrealMCP.h"
+#include "MCPTransactionScope.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	/** Growth per operation above which a metric counts as still growing */
+	constexpr double ObjectSlopeThreshold = 0.05;
+	constexpr double PackageSlopeThreshold = 0.01;
+	constexpr double ClassSlopeThreshold = 0.01;
+	constexpr double RssSlopeThreshold = 4.0 * 1024.0;
+	constexpr double UndoSlopeThreshold = 1024.0;
+
+	/** A metric has levelled off once its late slope falls below this fraction of its early slope */
+	constexpr double LevelOffRatio = 0.5;
+
+	/**
+	 * Least-squares slope of a metric against the operation count over Samples[Begin, End)
+	 * @return Slope per operation, or 0 if the operation count did not change
+	 */
+	template <typename ValueFunctorType>
+	double SlopePerOperation(const TArray<FMCPMemorySample>& Samples, int32 Begin, int32 End, ValueFunctorType&& GetValue)
+	{
+		const int32 Count = End - Begin;
+		if (Count < 2)
+		{
+			return 0.0;
+		}
+
+		double MeanX = 0.0;
+		double MeanY = 0.0;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			MeanX += static_cast<double>(Samples[Index].Operations);
+			MeanY += GetValue(Samples[Index]);
+		}
+		MeanX /= Count;
+		MeanY /= Count;
+
+		double Covariance = 0.0;
+		double Variance = 0.0;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const double DeltaX = static_cast<double>(Samples[Index].Operations) - MeanX;
+			Covariance += DeltaX * (GetValue(Samples[Index]) - MeanY);
+			Variance += DeltaX * DeltaX;
+		}
+		return Variance > 0.0 ? Covariance / Variance : 0.0;
+	}
+}
+
+const FMCPMemorySample& FMCPMemoryTracker::Sample(int64 Operations, bool bCollectGarbage)
+{
+	FMCPMemorySample NewSample;
+
+	if (bCollectGarbage)
+	{
+		const double GCStartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		NewSample.GCSeconds = FPlatformTime::Seconds() - GCStartTime;
+	}
+
+	NewSample.TimeSeconds = FPlatformTime::Seconds();
+	NewSample.Operations = Operations;
+
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		const UObject* Object = *It;
+		++NewSample.ObjectCount;
+		++NewSample.ClassCounts.FindOrAdd(Object->GetClass()->GetFName());
+		if (Object->IsA<UPackage>())
+		{
+			++NewSample.PackageCount;
+		}
+	}
+
+	NewSample.UsedPhysicalBytes = FPlatformMemory::GetStats().UsedPhysical;
+	NewSample.UndoBufferBytes = FMCPTransactionScope::GetUndoBufferBytes();
+
+	// Thin out every other sample after the first so the history keeps its full span
+	if (Samples.Num() >= MaxSamples)
+	{
+		for (int32 Index = Samples.Num() - 1; Index > 0; --Index)
+		{
+			if (Index % 2 == 1)
+			{
+				Samples.RemoveAt(Index, 1, EAllowShrinking::No);
+			}
+		}
+	}
+
+	UE_LOG(LogUnrealMCP, Verbose, TEXT("Memory sample at %lld ops: %d objects, %d packages, %.1f MB RSS"),
+		NewSample.Operations, NewSample.ObjectCount, NewSample.PackageCount, NewSample.UsedPhysicalBytes / (1024.0 * 1024.0));
+
+	return Samples.Add_GetRef(MoveTemp(NewSample));
+}
+
+TArray<FMCPMemoryTrend> FMCPMemoryTracker::FindUnboundedGrowth() const
+{
+	TArray<FMCPMemoryTrend> Trends;
+	if (Samples.Num() < MinTrendSamples || Samples.Last().Operations <= Samples[0].Operations)
+	{
+		return Trends;
+	}
+
+	// Compare the earlier and later halves: one-time growth (warm-up, caches) shows up only in the first
+	const int32 Middle = Samples.Num() / 2;
+
+	auto CheckMetric = [this, Middle, &Trends](const FString& Metric, double Threshold, auto&& GetValue)
+	{
+		const double LateSlope = SlopePerOperation(Samples, Middle, Samples.Num(), GetValue);
+		if (LateSlope <= Threshold)
+		{
+			return;
+		}
+
+		const double EarlySlope = SlopePerOperation(Samples, 0, Middle + 1, GetValue);
+		if (EarlySlope > 0.0 && LateSlope < EarlySlope * LevelOffRatio)
+		{
+			return;
+		}
+
+		FMCPMemoryTrend& Trend = Trends.AddDefaulted_GetRef();
+		Trend.Metric = Metric;
+		Trend.SlopePerOp = LateSlope;
+		Trend.EarlySlopePerOp = EarlySlope;
+		Trend.Growth = GetValue(Samples.Last()) - GetValue(Samples[0]);
+	};
+
+	CheckMetric(TEXT("objects"), ObjectSlopeThreshold, [](const FMCPMemorySample& Sample) { return static_cast<double>(Sample.ObjectCount); });
+	CheckMetric(TEXT("packages"), PackageSlopeThreshold, [](const FMCPMemorySample& Sample) { return static_cast<double>(Sample.PackageCount); });
+	CheckMetric(TEXT("rss_bytes"), RssSlopeThreshold, [](const FMCPMemorySample& Sample) { return static_cast<double>(Sample.UsedPhysicalBytes); });
+	CheckMetric(TEXT("undo_bytes"), UndoSlopeThreshold, [](const FMCPMemorySample& Sample) { return static_cast<double>(Sample.UndoBufferBytes); });
+
+	for (const TPair<FName, int32>& Pair : Samples.Last().ClassCounts)
+	{
+		const FName ClassName = Pair.Key;
+		CheckMetric(FString::Printf(TEXT("class:%s"), *ClassName.ToString()), ClassSlopeThreshold, [ClassName](const FMCPMemorySample& Sample)
+		{
+			const int32* Count = Sample.ClassCounts.Find(ClassName);
+			return Count ? static_cast<double>(*Count) : 0.0;
+		});
+	}
+
+	Trends.Sort([](const FMCPMemoryTrend& A, const FMCPMemoryTrend& B) { return A.SlopePerOp > B.SlopePerOp; });
+	return Trends;
+}
+
+void FMCPMemoryTracker::WriteJson(const TSharedRef<FJsonObject>& OutJson, int32 TopClassCount) const
+{
+	OutJson->SetNumberField(TEXT("samples"), Samples.Num());
+	if (Samples.Num() == 0)
+	{
+		return;
+	}
+
+	const FMCPMemorySample& First = Samples[0];
+	const FMCPMemorySample& Latest = Samples.Last();
+
+	auto WriteSample = [](const FMCPMemorySample& Sample)
+	{
+		TSharedPtr<FJsonObject> SampleJson = MakeShareable(new FJsonObject);
+		SampleJson->SetNumberField(TEXT("operations"), static_cast<double>(Sample.Operations));
+		SampleJson->SetNumberField(TEXT("objects"), Sample.ObjectCount);
+		SampleJson->SetNumberField(TEXT("packages"), Sample.PackageCount);
+		SampleJson->SetNumberField(TEXT("rss_mb"), Sample.UsedPhysicalBytes / (1024.0 * 1024.0));
+		SampleJson->SetNumberField(TEXT("undo_mb"), Sample.UndoBufferBytes / (1024.0 * 1024.0));
+		SampleJson->SetNumberField(TEXT("gc_ms"), Sample.GCSeconds * 1000.0);
+		return SampleJson;
+	};
+	OutJson->SetObjectField(TEXT("current"), WriteSample(Latest));
+	OutJson->SetObjectField(TEXT("baseline"), WriteSample(First));
+
+	TSharedPtr<FJsonObject> DeltaJson = MakeShareable(new FJsonObject);
+	DeltaJson->SetNumberField(TEXT("operations"), static_cast<double>(Latest.Operations - First.Operations));
+	DeltaJson->SetNumberField(TEXT("objects"), Latest.ObjectCount - First.ObjectCount);
+	DeltaJson->SetNumberField(TEXT("packages"), Latest.PackageCount - First.PackageCount);
+	DeltaJson->SetNumberField(TEXT("rss_mb"), (static_cast<double>(Latest.UsedPhysicalBytes) - static_cast<double>(First.UsedPhysicalBytes)) / (1024.0 * 1024.0));
+	DeltaJson->SetNumberField(TEXT("undo_mb"), (static_cast<double>(Latest.UndoBufferBytes) - static_cast<double>(First.UndoBufferBytes)) / (1024.0 * 1024.0));
+	OutJson->SetObjectField(TEXT("delta"), DeltaJson);
+
+	// Largest classes now, and classes that grew the most since the baseline
+	TArray<TPair<FName, int32>> ByCount = Latest.ClassCounts.Array();
+	ByCount.Sort([](const TPair<FName, int32>& A, const TPair<FName, int32>& B) { return A.Value > B.Value; });
+
+	TArray<TPair<FName, int32>> ByGrowth;
+	for (const TPair<FName, int32>& Pair : Latest.ClassCounts)
+	{
+		const int32* BaselineCount = First.ClassCounts.Find(Pair.Key);
+		const int32 Growth = Pair.Value - (BaselineCount ? *BaselineCount : 0);
+		if (Growth > 0)
+		{
+			ByGrowth.Emplace(Pair.Key, Growth);
+		}
+	}
+	ByGrowth.Sort([](const TPair<FName, int32>& A, const TPair<FName, int32>& B) { return A.Value > B.Value; });
+
+	auto WriteClassList = [TopClassCount](const TArray<TPair<FName, int32>>& Classes, const TCHAR* ValueField)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (int32 Index = 0; Index < FMath::Min(TopClassCount, Classes.Num()); ++Index)
+		{
+			TSharedPtr<FJsonObject> ClassJson = MakeShareable(new FJsonObject);
+			ClassJson->SetStringField(TEXT("class"), Classes[Index].Key.ToString());
+			ClassJson->SetNumberField(ValueField, Classes[Index].Value);
+			Values.Add(MakeShareable(new FJsonValueObject(ClassJson)));
+		}
+		return Values;
+	};
+	OutJson->SetArrayField(TEXT("top_classes"), WriteClassList(ByCount, TEXT("count")));
+	OutJson->SetArrayField(TEXT("growing_classes"), WriteClassList(ByGrowth, TEXT("growth")));
+
+	const TArray<FMCPMemoryTrend> Trends = FindUnboundedGrowth();
+	TArray<TSharedPtr<FJsonValue>> TrendValues;
+	for (const FMCPMemoryTrend& Trend : Trends)
+	{
+		TSharedPtr<FJsonObject> TrendJson = MakeShareable(new FJsonObject);
+		TrendJson->SetStringField(TEXT("metric"), Trend.Metric);
+		TrendJson->SetNumberField(TEXT("per_1000_ops"), Trend.SlopePerOp * 1000.0);
+		TrendJson->SetNumberField(TEXT("early_per_1000_ops"), Trend.EarlySlopePerOp * 1000.0);
+		TrendJson->SetNumberField(TEXT("growth"), Trend.Growth);
+		TrendValues.Add(MakeShareable(new FJsonValueObject(TrendJson)));
+	}
+	OutJson->SetArrayField(TEXT("suspected_leaks"), TrendValues);
+	OutJson->SetBoolField(TEXT("trend_available"), Samples.Num() >= MinTrendSamples && Latest.Operations > First.Operations);
+}
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Object and memory counts at one point in time
+ */
+struct FMCPMemorySample
+{
+	/** FPlatformTime::Seconds when the sample was taken */
+	double TimeSeconds = 0.0;
+
+	/** Assets created by the MCP operations so far */
+	int64 Operations = 0;
+
+	/** Live UObjects, of which packages */
+	int32 ObjectCount = 0;
+	int32 PackageCount = 0;
+
+	/** Resident set size of the process */
+	uint64 UsedPhysicalBytes = 0;
+
+	/** Size of the editor's undo buffer */
+	uint64 UndoBufferBytes = 0;
+
+	/** Time spent in the collection forced before sampling, if any */
+	double GCSeconds = 0.0;
+
+	/** Live UObjects by class name */
+	TMap<FName, int32> ClassCounts;
+};
+
+/**
+ * A metric that keeps growing with the operation count instead of levelling off
+ */
+struct FMCPMemoryTrend
+{
+	/** "objects", "packages", "rss_bytes", "undo_bytes" or "class:<ClassName>" */
+	FString Metric;
+
+	/** Growth per operation over the later half of the history */
+	double SlopePerOp = 0.0;
+
+	/** Growth per operation over the earlier half of the history */
+	double EarlySlopePerOp = 0.0;
+
+	/** Change between the first and last samples */
+	double Growth = 0.0;
+};
+
+/**
+ * Samples UObject counts by class, loaded package count and RSS against the number of
+ * operations run, and flags metrics whose growth does not level off.
+ * Used by the soak commandlet and the /memory route.
+ */
+class FMCPMemoryTracker
+{
+public:
+	/**
+	 * Take a sample
+	 * @param Operations Operations run so far
+	 * @param bCollectGarbage Run a full purge first, so only reachable objects are counted
+	 * @return The new sample
+	 */
+	const FMCPMemorySample& Sample(int64 Operations, bool bCollectGarbage);
+
+	/**
+	 * Find metrics that grow with the operation count and are not slowing down
+	 * Needs enough samples across a range of operations; returns nothing until then
+	 */
+	TArray<FMCPMemoryTrend> FindUnboundedGrowth() const;
+
+	/**
+	 * Write the latest sample, the change since the first sample, the largest and fastest
+	 * growing classes and any suspected leaks
+	 * @param OutJson Object to fill
+	 * @param TopClassCount Number of classes listed in each ranking
+	 */
+	void WriteJson(const TSharedRef<FJsonObject>& OutJson, int32 TopClassCount = 20) const;
+
+	/** Number of samples in the history */
+	int32 GetSampleCount() const { return Samples.Num(); }
+
+	/** Drop the history */
+	void Reset() { Samples.Reset(); }
+
+private:
+	/** Samples kept; older ones are thinned out rather than dropped so the first sample stays the baseline */
+	static constexpr int32 MaxSamples = 256;
+
+	/** Samples needed before trends are reported */
+	static constexpr int32 MinTrendSamples = 6;
+
+	TArray<FMCPMemorySample> Samples;
+};
@@ -0,0 +1,384 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPMsgPack.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+const TCHAR* FMCPMsgPack::ContentType = TEXT("application/msgpack");
+
+namespace
+{
+	void WriteBigEndian(TArray<uint8>& Out, uint64 Value, int32 Bytes)
+	{
+		for (int32 Shift = (Bytes - 1) * 8; Shift >= 0; Shift -= 8)
+		{
+			Out.Add(static_cast<uint8>(Value >> Shift));
+		}
+	}
+
+	/** Write a header whose length fits the fix form (up to FixMax), or the 8/16/32-bit form starting at Tag8 */
+	void WriteLengthHeader(TArray<uint8>& Out, uint32 Length, uint8 FixTag, uint32 FixMax, int32 Tag8, uint8 Tag16, uint8 Tag32)
+	{
+		if (Length <= FixMax)
+		{
+			Out.Add(static_cast<uint8>(FixTag | Length));
+		}
+		else if (Tag8 >= 0 && Length <= MAX_uint8)
+		{
+			Out.Add(static_cast<uint8>(Tag8));
+			WriteBigEndian(Out, Length, 1);
+		}
+		else if (Length <= MAX_uint16)
+		{
+			Out.Add(Tag16);
+			WriteBigEndian(Out, Length, 2);
+		}
+		else
+		{
+			Out.Add(Tag32);
+			WriteBigEndian(Out, Length, 4);
+		}
+	}
+
+	void WriteString(TArray<uint8>& Out, const FString& Value)
+	{
+		FTCHARToUTF8 Utf8(*Value, Value.Len());
+		WriteLengthHeader(Out, Utf8.Length(), 0xa0, 31, 0xd9, 0xda, 0xdb);
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	void WriteNumber(TArray<uint8>& Out, double Value)
+	{
+		// JSON numbers are doubles; whole ones go out as the smallest integer form, like JSON text would print them
+		const bool bWhole = FMath::IsFinite(Value) && Value == FMath::FloorToDouble(Value)
+			&& Value >= -9223372036854775808.0 && Value < 9223372036854775808.0;
+		if (!bWhole)
+		{
+			uint64 Bits = 0;
+			FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+			Out.Add(0xcb);
+			WriteBigEndian(Out, Bits, 8);
+			return;
+		}
+
+		const int64 Integer = static_cast<int64>(Value);
+		if (Integer >= 0)
+		{
+			const uint64 Unsigned = static_cast<uint64>(Integer);
+			if (Unsigned <= 0x7f)
+			{
+				Out.Add(static_cast<uint8>(Unsigned));
+			}
+			else if (Unsigned <= MAX_uint8)
+			{
+				Out.Add(0xcc);
+				WriteBigEndian(Out, Unsigned, 1);
+			}
+			else if (Unsigned <= MAX_uint16)
+			{
+				Out.Add(0xcd);
+				WriteBigEndian(Out, Unsigned, 2);
+			}
+			else if (Unsigned <= MAX_uint32)
+			{
+				Out.Add(0xce);
+				WriteBigEndian(Out, Unsigned, 4);
+			}
+			else
+			{
+				Out.Add(0xcf);
+				WriteBigEndian(Out, Unsigned, 8);
+			}
+		}
+		else if (Integer >= -32)
+		{
+			Out.Add(static_cast<uint8>(static_cast<int8>(Integer)));
+		}
+		else if (Integer >= MIN_int8)
+		{
+			Out.Add(0xd0);
+			WriteBigEndian(Out, static_cast<uint64>(Integer), 1);
+		}
+		else if (Integer >= MIN_int16)
+		{
+			Out.Add(0xd1);
+			WriteBigEndian(Out, static_cast<uint64>(Integer), 2);
+		}
+		else if (Integer >= MIN_int32)
+		{
+			Out.Add(0xd2);
+			WriteBigEndian(Out, static_cast<uint64>(Integer), 4);
+		}
+		else
+		{
+			Out.Add(0xd3);
+			WriteBigEndian(Out, static_cast<uint64>(Integer), 8);
+		}
+	}
+
+	void WriteObject(TArray<uint8>& Out, const FJsonObject& Object);
+
+	void WriteValue(TArray<uint8>& Out, const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			Out.Add(0xc0);
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+			WriteString(Out, Value->AsString());
+			break;
+		case EJson::Number:
+			WriteNumber(Out, Value->AsNumber());
+			break;
+		case EJson::Boolean:
+			Out.Add(static_cast<uint8>(Value->AsBool() ? 0xc3 : 0xc2));
+			break;
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+			WriteLengthHeader(Out, Items.Num(), 0x90, 15, INDEX_NONE, 0xdc, 0xdd);
+			for (const TSharedPtr<FJsonValue>& Item : Items)
+			{
+				WriteValue(Out, Item);
+			}
+			break;
+		}
+		case EJson::Object:
+			WriteObject(Out, *Value->AsObject());
+			break;
+		default:
+			Out.Add(0xc0);
+			break;
+		}
+	}
+
+	void WriteObject(TArray<uint8>& Out, const FJsonObject& Object)
+	{
+		WriteLengthHeader(Out, Object.Values.Num(), 0x80, 15, INDEX_NONE, 0xde, 0xdf);
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object.Values)
+		{
+			WriteString(Out, Pair.Key);
+			WriteValue(Out, Pair.Value);
+		}
+	}
+
+	/** Bounds-checked cursor over the body */
+	struct FReader
+	{
+		const uint8* Data = nullptr;
+		int32 Num = 0;
+		int32 Pos = 0;
+
+		int32 Remaining() const { return Num - Pos; }
+
+		bool ReadBigEndian(int32 Bytes, uint64& OutValue)
+		{
+			if (Remaining() < Bytes)
+			{
+				return false;
+			}
+			OutValue = 0;
+			for (int32 Index = 0; Index < Bytes; ++Index)
+			{
+				OutValue = (OutValue << 8) | Data[Pos++];
+			}
+			return true;
+		}
+	};
+
+	TSharedPtr<FJsonValue> ReadValue(FReader& Reader, int32 Depth);
+
+	TSharedPtr<FJsonValue> MakeNumber(double Value)
+	{
+		return MakeShared<FJsonValueNumber>(Value);
+	}
+
+	TSharedPtr<FJsonValue> ReadString(FReader& Reader, uint64 Length)
+	{
+		if (Length > static_cast<uint64>(Reader.Remaining()))
+		{
+			return nullptr;
+		}
+
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Reader.Data + Reader.Pos), static_cast<int32>(Length));
+		Reader.Pos += static_cast<int32>(Length);
+		return MakeShared<FJsonValueString>(FString(Converted.Length(), Converted.Get()));
+	}
+
+	TSharedPtr<FJsonValue> ReadArray(FReader& Reader, uint64 Count, int32 Depth)
+	{
+		// Every item takes at least one byte, which also rejects absurd counts before allocating
+		if (Depth >= FMCPMsgPack::MaxDepth || Count > static_cast<uint64>(Reader.Remaining()))
+		{
+			return nullptr;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Items;
+		Items.Reserve(static_cast<int32>(Count));
+		for (uint64 Index = 0; Index < Count; ++Index)
+		{
+			TSharedPtr<FJsonValue> Item = ReadValue(Reader, Depth + 1);
+			if (!Item.IsValid())
+			{
+				return nullptr;
+			}
+			Items.Add(MoveTemp(Item));
+		}
+		return MakeShared<FJsonValueArray>(Items);
+	}
+
+	TSharedPtr<FJsonValue> ReadMap(FReader& Reader, uint64 Count, int32 Depth)
+	{
+		if (Depth >= FMCPMsgPack::MaxDepth || Count * 2 > static_cast<uint64>(Reader.Remaining()))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Object = MakeShareable(new FJsonObject);
+		for (uint64 Index = 0; Index < Count; ++Index)
+		{
+			const TSharedPtr<FJsonValue> Key = ReadValue(Reader, Depth + 1);
+			TSharedPtr<FJsonValue> Value = Key.IsValid() && Key->Type == EJson::String ? ReadValue(Reader, Depth + 1) : nullptr;
+			if (!Value.IsValid())
+			{
+				return nullptr;
+			}
+			Object->SetField(Key->AsString(), Value);
+		}
+		return MakeShared<FJsonValueObject>(Object);
+	}
+
+	TSharedPtr<FJsonValue> ReadValue(FReader& Reader, int32 Depth)
+	{
+		uint64 Tag = 0;
+		if (!Reader.ReadBigEndian(1, Tag))
+		{
+			return nullptr;
+		}
+
+		if (Tag <= 0x7f)
+		{
+			return MakeShared<FJsonValueNumber>(static_cast<double>(Tag));
+		}
+		if (Tag >= 0xe0)
+		{
+			return MakeShared<FJsonValueNumber>(static_cast<double>(static_cast<int8>(Tag)));
+		}
+		if ((Tag & 0xf0) == 0x80)
+		{
+			return ReadMap(Reader, Tag & 0x0f, Depth);
+		}
+		if ((Tag & 0xf0) == 0x90)
+		{
+			return ReadArray(Reader, Tag & 0x0f, Depth);
+		}
+		if ((Tag & 0xe0) == 0xa0)
+		{
+			return ReadString(Reader, Tag & 0x1f);
+		}
+
+		uint64 Payload = 0;
+		switch (Tag)
+		{
+		case 0xc0:
+			return MakeShared<FJsonValueNull>();
+		case 0xc2:
+			return MakeShared<FJsonValueBoolean>(false);
+		case 0xc3:
+			return MakeShared<FJsonValueBoolean>(true);
+
+		case 0xca:
+		{
+			if (!Reader.ReadBigEndian(4, Payload))
+			{
+				return nullptr;
+			}
+			const uint32 Bits = static_cast<uint32>(Payload);
+			float Value = 0.0f;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			return MakeShared<FJsonValueNumber>(Value);
+		}
+		case 0xcb:
+		{
+			if (!Reader.ReadBigEndian(8, Payload))
+			{
+				return nullptr;
+			}
+			double Value = 0.0;
+			FMemory::Memcpy(&Value, &Payload, sizeof(Value));
+			return MakeShared<FJsonValueNumber>(Value);
+		}
+
+		case 0xcc:
+		case 0xcd:
+		case 0xce:
+		case 0xcf:
+			return Reader.ReadBigEndian(1 << (Tag - 0xcc), Payload) ? MakeNumber(static_cast<double>(Payload)) : nullptr;
+
+		case 0xd0:
+			return Reader.ReadBigEndian(1, Payload) ? MakeNumber(static_cast<double>(static_cast<int8>(Payload))) : nullptr;
+		case 0xd1:
+			return Reader.ReadBigEndian(2, Payload) ? MakeNumber(static_cast<double>(static_cast<int16>(Payload))) : nullptr;
+		case 0xd2:
+			return Reader.ReadBigEndian(4, Payload) ? MakeNumber(static_cast<double>(static_cast<int32>(Payload))) : nullptr;
+		case 0xd3:
+			return Reader.ReadBigEndian(8, Payload) ? MakeNumber(static_cast<double>(static_cast<int64>(Payload))) : nullptr;
+
+		case 0xd9:
+		case 0xda:
+		case 0xdb:
+			return Reader.ReadBigEndian(1 << (Tag - 0xd9), Payload) ? ReadString(Reader, Payload) : nullptr;
+
+		case 0xdc:
+		case 0xdd:
+			return Reader.ReadBigEndian(Tag == 0xdc ? 2 : 4, Payload) ? ReadArray(Reader, Payload, Depth) : nullptr;
+
+		case 0xde:
+		case 0xdf:
+			return Reader.ReadBigEndian(Tag == 0xde ? 2 : 4, Payload) ? ReadMap(Reader, Payload, Depth) : nullptr;
+
+		default:
+			// bin, ext and the reserved 0xc1 have no JSON equivalent
+			return nullptr;
+		}
+	}
+}
+
+bool FMCPMsgPack::Decode(const TArray<uint8>& Bytes, TSharedPtr<FJsonObject>& OutObject)
+{
+	FReader Reader;
+	Reader.Data = Bytes.GetData();
+	Reader.Num = Bytes.Num();
+
+	const TSharedPtr<FJsonValue> Value = ReadValue(Reader, 0);
+	if (!Value.IsValid() || Value->Type != EJson::Object || Reader.Remaining() != 0)
+	{
+		return false;
+	}
+
+	OutObject = Value->AsObject();
+	return OutObject.IsValid();
+}
+
+void FMCPMsgPack::Encode(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	WriteObject(OutBytes, *Object);
+}
+
+void FMCPMsgPack::EncodeWithRawField(const TSharedRef<FJsonObject>& Object, const FString& FieldName, const TArray<uint8>& RawValue, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset(RawValue.Num() + 64);
+	WriteLengthHeader(OutBytes, Object->Values.Num() + 1, 0x80, 15, INDEX_NONE, 0xde, 0xdf);
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values)
+	{
+		WriteString(OutBytes, Pair.Key);
+		WriteValue(OutBytes, Pair.Value);
+	}
+	WriteString(OutBytes, FieldName);
+	OutBytes.Append(RawValue);
+}
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+/**
+ * Minimal MessagePack codec for request and response bodies sent as application/msgpack.
+ * Converts directly between bytes and FJsonObject, the body type every route already works with, so a
+ * binary body skips the UTF-8 to TCHAR conversion, tokenizer and text writer of FJsonSerializer.
+ * Only the types JSON can express are supported: nil, bool, integers, floats, str, array and maps with str keys.
+ */
+class FMCPMsgPack
+{
+public:
+	/** MIME type negotiated through Content-Type and Accept */
+	static const TCHAR* ContentType;
+
+	/**
+	 * Decode a body whose top-level value is a map
+	 * @return False if the bytes are truncated, malformed, nested too deeply or use bin/ext types
+	 */
+	static bool Decode(const TArray<uint8>& Bytes, TSharedPtr<FJsonObject>& OutObject);
+
+	/**
+	 * Encode an object as a map
+	 * Whole numbers are written as integers, everything else as float 64
+	 */
+	static void Encode(const TSharedRef<FJsonObject>& Object, TArray<uint8>& OutBytes);
+
+	/**
+	 * Encode an object as a map with one more field whose value is already MessagePack
+	 * Used to wrap an encoded response body in an envelope without decoding it again
+	 * @param RawValue One complete encoded value; not validated
+	 */
+	static void EncodeWithRawField(const TSharedRef<FJsonObject>& Object, const FString& FieldName, const TArray<uint8>& RawValue, TArray<uint8>& OutBytes);
+
+	/** Maximum nesting of arrays and maps accepted by Decode */
+	static constexpr int32 MaxDepth = 64;
+};
@@ -0,0 +1,806 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPOperationRunner.h"
+#include "MCPBlueprintUtils.h"
+#include "MCPBlueprintTemplates.h"
+#include "MCPTransactionScope.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_EDITOR
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#endif
+
+bool FMCPOperationResult::IsSuccess() const
+{
+	bool bSuccess = false;
+	return Json.IsValid() && Json->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess;
+}
+
+FMCPOperationRunner::FMCPOperationRunner()
+	: TemplateCache(MakeUnique<FMCPBlueprintTemplateCache>())
+	, GCPolicy(FMCPGCPolicy::GetShared())
+{
+}
+
+FMCPOperationRunner::~FMCPOperationRunner()
+{
+	if (PendingSaves.Num() > 0)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("%d deferred package save(s) were never flushed"), PendingSaves.Num());
+	}
+}
+
+bool FMCPOperationRunner::IsKnownOperation(const FString& Route)
+{
+	return Route == TEXT("/add_node") || Route == TEXT("/stamp") || Route == TEXT("/commit");
+}
+
+int32 FMCPOperationRunner::EstimateCost(const FString& Route, const TSharedPtr<FJsonObject>& Body)
+{
+	if (Route != TEXT("/stamp") || !Body.IsValid())
+	{
+		return 1;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* PathValues = nullptr;
+	if (Body->TryGetArrayField(TEXT("paths"), PathValues))
+	{
+		return FMath::Clamp(PathValues->Num(), 1, MaxStampCount);
+	}
+
+	int32 Count = 1;
+	Body->TryGetNumberField(TEXT("count"), Count);
+	return FMath::Clamp(Count, 1, MaxStampCount);
+}
+
+FMCPOperationResult FMCPOperationRunner::Execute(const FString& Route, const TSharedPtr<FJsonObject>& Body, double DeadlineSeconds)
+{
+	FMCPOperationResult Result;
+	if (!IsKnownOperation(Route))
+	{
+		Result.Code = EHttpServerResponseCodes::NotFound;
+		Result.Json = MakeShareable(new FJsonObject);
+		Result.Json->SetBoolField(TEXT("success"), false);
+		Result.Json->SetStringField(TEXT("message"), FString::Printf(TEXT("Unknown operation '%s'"), *Route));
+		return Result;
+	}
+
+	FString TransactionName;
+	Body->TryGetStringField(TEXT("transaction"), TransactionName);
+	EMCPTransactionMode TransactionMode = EMCPTransactionMode::None;
+	if (!FMCPTransactionScope::ParseMode(TransactionName, TransactionMode))
+	{
+		Result.Code = EHttpServerResponseCodes::BadRequest;
+		Result.Json = MakeShareable(new FJsonObject);
+		Result.Json->SetBoolField(TEXT("success"), false);
+		Result.Json->SetStringField(TEXT("message"), FString::Printf(TEXT("Unsupported transaction mode '%s'. Use 'none' or 'batch'."), *TransactionName));
+		return Result;
+	}
+
+	// The deadline applies to this call only
+	TGuardValue<double> DeadlineGuard(CurrentDeadlineSeconds, DeadlineSeconds);
+	ExpiredStage = nullptr;
+
+	FMCPTransactionScope TransactionScope(TransactionMode, FText::Format(NSLOCTEXT("UnrealMCP", "OperationTransaction", "MCP {0}"), FText::FromString(Route)));
+	Result = Route == TEXT("/stamp") ? Stamp(Body) : Route == TEXT("/commit") ? Commit(Body) : AddNode(Body);
+	SetDeadlineExceeded(Result);
+
+	// Undo buffer growth of this request; stays at 0 unless the client asked for a batch transaction
+	LastUndoBytes = TransactionScope.GetUndoBytes();
+	MaxUndoBytes = FMath::Max(MaxUndoBytes, LastUndoBytes);
+	BatchTransactionCount += TransactionMode == EMCPTransactionMode::Batch ? 1 : 0;
+
+	TSharedRef<FJsonObject> TransactionJson = MakeShared<FJsonObject>();
+	TransactionScope.WriteStats(TransactionJson);
+	Result.Json->SetObjectField(TEXT("transaction"), TransactionJson);
+	return Result;
+}
+
+void FMCPOperationRunner::WriteUndoStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	OutJson->SetNumberField(TEXT("buffer_bytes"), static_cast<double>(FMCPTransactionScope::GetUndoBufferBytes()));
+	OutJson->SetNumberField(TEXT("batch_transactions"), static_cast<double>(BatchTransactionCount));
+	OutJson->SetNumberField(TEXT("last_request_bytes"), static_cast<double>(LastUndoBytes));
+	OutJson->SetNumberField(TEXT("max_request_bytes"), static_cast<double>(MaxUndoBytes));
+}
+
+bool FMCPOperationRunner::HasExpiredBefore(const TCHAR* Stage)
+{
+	if (CurrentDeadlineSeconds <= 0.0 || FPlatformTime::Seconds() < CurrentDeadlineSeconds)
+	{
+		return false;
+	}
+
+	if (!ExpiredStage)
+	{
+		ExpiredStage = Stage;
+		++ExpiredStageCount;
+		UE_LOG(LogUnrealMCP, Log, TEXT("Deadline passed, dropping remaining work before %s"), Stage);
+	}
+	return true;
+}
+
+EMCPTargetState FMCPOperationRunner::CheckTarget(const FString& BlueprintPath, const FString& ContentHash, bool bForce, UObject*& OutLoadedAsset) const
+{
+	const FMCPExistingAsset Existing = FMCPBlueprintUtils::FindExistingAsset(BlueprintPath);
+	OutLoadedAsset = Existing.LoadedAsset;
+
+	if (!bForce && !Existing.ContentHash.IsEmpty() && Existing.ContentHash == ContentHash)
+	{
+		return EMCPTargetState::Unchanged;
+	}
+
+	// An asset without a content hash was made by someone else; replacing it takes an explicit force
+	if (!bForce && Existing.bExists && Existing.ContentHash.IsEmpty())
+	{
+		return EMCPTargetState::Conflict;
+	}
+	return EMCPTargetState::Create;
+}
+
+void FMCPOperationRunner::ReplaceLoadedAssets(const TMap<FString, UObject*>& AssetsByPath, TSet<FString>& OutRemainingPaths)
+{
+#if WITH_EDITOR
+	if (AssetsByPath.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<UObject*> Assets;
+	TSet<UPackage*> Packages;
+	for (const TPair<FString, UObject*>& Pair : AssetsByPath)
+	{
+		UE_LOG(LogUnrealMCP, Log, TEXT("Replacing loaded asset %s"), *Pair.Key);
+		Assets.Add(Pair.Value);
+		Packages.Add(Pair.Value->GetOutermost());
+	}
+
+	// A deferred save keeps its asset rooted, which would block the delete
+	PendingSaves.RemoveAll([&Packages](const TPair<TStrongObjectPtr<UPackage>, TStrongObjectPtr<UBlueprint>>& PendingSave)
+	{
+		return Packages.Contains(PendingSave.Key.Get());
+	});
+
+	FMCPBlueprintUtils::DeleteAssets(Assets);
+
+	// The pointers are stale after the delete; look each path up again
+	for (const TPair<FString, UObject*>& Pair : AssetsByPath)
+	{
+		if (FMCPBlueprintUtils::FindExistingAsset(Pair.Key).LoadedAsset)
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Could not delete loaded asset %s"), *Pair.Key);
+			OutRemainingPaths.Add(Pair.Key);
+		}
+	}
+#endif
+}
+
+EMCPTargetState FMCPOperationRunner::ClaimTarget(const FString& BlueprintPath, const FString& ContentHash, bool bForce, FString& OutMessage)
+{
+	UObject* LoadedAsset = nullptr;
+	const EMCPTargetState State = CheckTarget(BlueprintPath, ContentHash, bForce, LoadedAsset);
+	if (State == EMCPTargetState::Unchanged)
+	{
+		++UnchangedAssetCount;
+		UE_LOG(LogUnrealMCP, Verbose, TEXT("Skipping unchanged asset %s"), *BlueprintPath);
+		return State;
+	}
+
+	if (State == EMCPTargetState::Conflict)
+	{
+		OutMessage = FString::Printf(TEXT("'%s' holds an asset that was not created by MCP; pass force to replace it"), *BlueprintPath);
+		return State;
+	}
+
+	if (LoadedAsset)
+	{
+		TSet<FString> RemainingPaths;
+		ReplaceLoadedAssets({ { BlueprintPath, LoadedAsset } }, RemainingPaths);
+		if (RemainingPaths.Num() > 0)
+		{
+			OutMessage = FString::Printf(TEXT("Could not delete the existing asset at '%s'; it may still be referenced"), *BlueprintPath);
+			return EMCPTargetState::Conflict;
+		}
+	}
+	return EMCPTargetState::Create;
+}
+
+void FMCPOperationRunner::SetDeadlineExceeded(FMCPOperationResult& Result) const
+{
+	if (!ExpiredStage)
+	{
+		return;
+	}
+
+	Result.Code = EHttpServerResponseCodes::GatewayTimeout;
+	Result.Json->SetBoolField(TEXT("success"), false);
+	Result.Json->SetStringField(TEXT("message"), FString::Printf(TEXT("Deadline exceeded before %s; remaining work was dropped"), ExpiredStage));
+	Result.Json->SetBoolField(TEXT("deadline_exceeded"), true);
+	Result.Json->SetStringField(TEXT("expired_before"), ExpiredStage);
+}
+
+FMCPOperationResult FMCPOperationRunner::AddNode(const TSharedPtr<FJsonObject>& Body)
+{
+	FMCPGCBatchScope GCBatch(*GCPolicy);
+
+	FMCPOperationResult Result;
+	Result.Json = MakeShareable(new FJsonObject);
+	TSharedPtr<FJsonObject>& ResponseJson = Result.Json;
+
+	// Extract blueprint_path and node_type from request
+	FString BlueprintPath = Body->GetStringField(TEXT("blueprint_path"));
+	FString NodeType = Body->GetStringField(TEXT("node_type"));
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Add node request - Blueprint: %s, NodeType: %s"), *BlueprintPath, *NodeType);
+
+	bool bDryRun = false;
+	Body->TryGetBoolField(TEXT("dry_run"), bDryRun);
+	if (bDryRun)
+	{
+		return DryRunAddNode(BlueprintPath, NodeType);
+	}
+
+	bool bForce = false;
+	Body->TryGetBoolField(TEXT("force"), bForce);
+	if (FMCPBlueprintUtils::IsSupportedNodeType(NodeType))
+	{
+		FString TargetMessage;
+		const EMCPTargetState TargetState = ClaimTarget(BlueprintPath, FMCPBlueprintUtils::ComputeContentHash({ NodeType }), bForce, TargetMessage);
+		if (TargetState == EMCPTargetState::Unchanged)
+		{
+			ResponseJson->SetBoolField(TEXT("success"), true);
+			ResponseJson->SetBoolField(TEXT("unchanged"), true);
+			ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Blueprint at '%s' already has a %s node"), *BlueprintPath, *NodeType));
+			ResponseJson->SetStringField(TEXT("blueprint_path"), BlueprintPath);
+			ResponseJson->SetStringField(TEXT("node_type"), NodeType);
+			return Result;
+		}
+
+		if (TargetState == EMCPTargetState::Conflict)
+		{
+			Result.Code = EHttpServerResponseCodes::Conflict;
+			ResponseJson->SetBoolField(TEXT("success"), false);
+			ResponseJson->SetStringField(TEXT("message"), TargetMessage);
+			ResponseJson->SetStringField(TEXT("blueprint_path"), BlueprintPath);
+			ResponseJson->SetStringField(TEXT("node_type"), NodeType);
+			return Result;
+		}
+	}
+
+	// Call the actual blueprint creation function
+	TSharedRef<FJsonObject> CompileJson = MakeShared<FJsonObject>();
+	bool bSuccess = CreateBlueprintWithPrintString(BlueprintPath, NodeType, CompileJson);
+
+	ResponseJson->SetBoolField(TEXT("success"), bSuccess);
+	ResponseJson->SetBoolField(TEXT("unchanged"), false);
+	if (bSuccess)
+	{
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Blueprint created with %s node at '%s'"), *NodeType, *BlueprintPath));
+	}
+	else if (CompileJson->HasField(TEXT("status")) && CompileJson->GetStringField(TEXT("status")) == TEXT("error"))
+	{
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Blueprint at '%s' failed to compile with %d error(s); nothing was saved"), *BlueprintPath, static_cast<int32>(CompileJson->GetNumberField(TEXT("errors")))));
+	}
+	else
+	{
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Failed to create Blueprint with %s node at '%s'"), *NodeType, *BlueprintPath));
+	}
+	ResponseJson->SetStringField(TEXT("blueprint_path"), BlueprintPath);
+	ResponseJson->SetStringField(TEXT("node_type"), NodeType);
+	if (CompileJson->Values.Num() > 0)
+	{
+		ResponseJson->SetObjectField(TEXT("compile"), CompileJson);
+	}
+
+	return Result;
+}
+
+FMCPOperationResult FMCPOperationRunner::Stamp(const TSharedPtr<FJsonObject>& Body)
+{
+	FMCPGCBatchScope GCBatch(*GCPolicy);
+	FMCPAssetNotifyBatchScope NotifyBatch(AssetNotifier);
+
+	FMCPOperationResult Result;
+	Result.Json = MakeShareable(new FJsonObject);
+	TSharedPtr<FJsonObject>& ResponseJson = Result.Json;
+
+	FString TemplateName = FMCPBlueprintTemplateCache::DefaultTemplateName;
+	Body->TryGetStringField(TEXT("template"), TemplateName);
+
+	// An inline node list registers (or updates) the template before stamping
+	const TArray<TSharedPtr<FJsonValue>>* NodeTypeValues = nullptr;
+	if (Body->TryGetArrayField(TEXT("node_types"), NodeTypeValues))
+	{
+		TArray<FString> NodeTypes;
+		for (const TSharedPtr<FJsonValue>& Value : *NodeTypeValues)
+		{
+			NodeTypes.Add(Value->AsString());
+		}
+
+		FString RegisterError;
+		if (!TemplateCache->RegisterTemplate(TemplateName, NodeTypes, RegisterError))
+		{
+			Result.Code = EHttpServerResponseCodes::BadRequest;
+			ResponseJson->SetBoolField(TEXT("success"), false);
+			ResponseJson->SetStringField(TEXT("message"), RegisterError);
+			return Result;
+		}
+	}
+
+	if (!TemplateCache->HasTemplate(TemplateName))
+	{
+		Result.Code = EHttpServerResponseCodes::NotFound;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Unknown template '%s'"), *TemplateName));
+		return Result;
+	}
+
+	// Target paths are either listed explicitly or generated from a prefix and a count.
+	// The requested size is checked before any path is built, so an oversized count allocates nothing.
+	TArray<FString> TargetPaths;
+	const TArray<TSharedPtr<FJsonValue>>* PathValues = nullptr;
+	FString PathPrefix;
+	bool bValidCount = false;
+	if (Body->TryGetArrayField(TEXT("paths"), PathValues))
+	{
+		bValidCount = PathValues->Num() >= 1 && PathValues->Num() <= MaxStampCount;
+		if (bValidCount)
+		{
+			TargetPaths.Reserve(PathValues->Num());
+			for (const TSharedPtr<FJsonValue>& Value : *PathValues)
+			{
+				TargetPaths.Add(Value->AsString());
+			}
+		}
+	}
+	else if (Body->TryGetStringField(TEXT("path_prefix"), PathPrefix))
+	{
+		int32 Count = 1;
+		int32 StartIndex = 0;
+		Body->TryGetNumberField(TEXT("count"), Count);
+		Body->TryGetNumberField(TEXT("start_index"), StartIndex);
+
+		bValidCount = Count >= 1 && Count <= MaxStampCount;
+		if (bValidCount)
+		{
+			TargetPaths.Reserve(Count);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				TargetPaths.Add(FString::Printf(TEXT("%s%d"), *PathPrefix, StartIndex + Index));
+			}
+		}
+	}
+
+	if (!bValidCount)
+	{
+		Result.Code = EHttpServerResponseCodes::BadRequest;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Provide 'paths' or 'path_prefix' + 'count' for 1 to %d assets"), MaxStampCount));
+		return Result;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Stamp request - Template: %s, Count: %d"), *TemplateName, TargetPaths.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	bool bForce = false;
+	Body->TryGetBoolField(TEXT("force"), bForce);
+	const FString ContentHash = TemplateCache->GetContentHash(TemplateName);
+
+	// Every target is classified first, so the loaded assets to rebuild are deleted together with one collection
+	TArray<EMCPTargetState> TargetStates;
+	TargetStates.Reserve(TargetPaths.Num());
+	TMap<FString, UObject*> AssetsToReplace;
+	for (const FString& TargetPath : TargetPaths)
+	{
+		UObject* LoadedAsset = nullptr;
+		const EMCPTargetState TargetState = CheckTarget(TargetPath, ContentHash, bForce, LoadedAsset);
+		TargetStates.Add(TargetState);
+		if (TargetState == EMCPTargetState::Create && LoadedAsset)
+		{
+			AssetsToReplace.Add(TargetPath, LoadedAsset);
+		}
+	}
+
+	bool bDryRun = false;
+	Body->TryGetBoolField(TEXT("dry_run"), bDryRun);
+	if (bDryRun)
+	{
+		// Nothing is built: report which paths a real run would create, skip or refuse
+		TArray<TSharedPtr<FJsonValue>> WouldCreateValues;
+		TArray<TSharedPtr<FJsonValue>> UnchangedValues;
+		TArray<TSharedPtr<FJsonValue>> ConflictValues;
+		for (int32 TargetIndex = 0; TargetIndex < TargetPaths.Num(); ++TargetIndex)
+		{
+			const EMCPTargetState TargetState = TargetStates[TargetIndex];
+			TArray<TSharedPtr<FJsonValue>>& Values = TargetState == EMCPTargetState::Unchanged ? UnchangedValues
+				: TargetState == EMCPTargetState::Conflict ? ConflictValues
+				: WouldCreateValues;
+			Values.Add(MakeShareable(new FJsonValueString(TargetPaths[TargetIndex])));
+		}
+
+		ResponseJson->SetBoolField(TEXT("success"), true);
+		ResponseJson->SetBoolField(TEXT("dry_run"), true);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Dry run: would stamp %d of %d asset(s) from template '%s'; nothing was saved"), WouldCreateValues.Num(), TargetPaths.Num(), *TemplateName));
+		ResponseJson->SetStringField(TEXT("template"), TemplateName);
+		ResponseJson->SetStringField(TEXT("content_hash"), ContentHash);
+		ResponseJson->SetArrayField(TEXT("would_create"), WouldCreateValues);
+		ResponseJson->SetArrayField(TEXT("unchanged"), UnchangedValues);
+		ResponseJson->SetArrayField(TEXT("conflicts"), ConflictValues);
+		return Result;
+	}
+
+	TSet<FString> UndeletedPaths;
+	ReplaceLoadedAssets(AssetsToReplace, UndeletedPaths);
+
+	TArray<TSharedPtr<FJsonValue>> CreatedValues;
+	TArray<TSharedPtr<FJsonValue>> UnchangedValues;
+	TArray<TSharedPtr<FJsonValue>> FailedValues;
+	int32 SkippedCount = 0;
+	for (int32 TargetIndex = 0; TargetIndex < TargetPaths.Num(); ++TargetIndex)
+	{
+		const FString& TargetPath = TargetPaths[TargetIndex];
+		if (TargetStates[TargetIndex] == EMCPTargetState::Unchanged)
+		{
+			++UnchangedAssetCount;
+			UnchangedValues.Add(MakeShareable(new FJsonValueString(TargetPath)));
+			continue;
+		}
+
+		if (TargetStates[TargetIndex] == EMCPTargetState::Conflict || UndeletedPaths.Contains(TargetPath))
+		{
+			TSharedPtr<FJsonObject> FailedJson = MakeShareable(new FJsonObject);
+			FailedJson->SetStringField(TEXT("blueprint_path"), TargetPath);
+			FailedJson->SetStringField(TEXT("message"), UndeletedPaths.Contains(TargetPath)
+				? FString::Printf(TEXT("Could not delete the existing asset at '%s'; it may still be referenced"), *TargetPath)
+				: FString::Printf(TEXT("'%s' holds an asset that was not created by MCP; pass force to replace it"), *TargetPath));
+			FailedJson->SetBoolField(TEXT("conflict"), true);
+			FailedValues.Add(MakeShareable(new FJsonValueObject(FailedJson)));
+			continue;
+		}
+
+		// Duplicating the prototype regenerates (compiles) the new class
+		if (HasExpiredBefore(TEXT("compile")))
+		{
+			SkippedCount = TargetPaths.Num() - CreatedValues.Num() - UnchangedValues.Num() - FailedValues.Num();
+			break;
+		}
+
+		FString Error;
+		UBlueprint* NewBlueprint = TemplateCache->Stamp(TemplateName, TargetPath, Error);
+		if (NewBlueprint && HasExpiredBefore(TEXT("save")))
+		{
+			FMCPBlueprintUtils::DiscardPackage(NewBlueprint->GetOutermost());
+			SkippedCount = TargetPaths.Num() - CreatedValues.Num() - UnchangedValues.Num() - FailedValues.Num();
+			break;
+		}
+
+		if (NewBlueprint)
+		{
+			FMCPBlueprintUtils::SetContentHash(NewBlueprint, ContentHash);
+		}
+
+		if (NewBlueprint && !CommitNewAsset(NewBlueprint->GetOutermost(), NewBlueprint))
+		{
+			Error = FString::Printf(TEXT("Failed to save '%s'"), *TargetPath);
+			NewBlueprint = nullptr;
+		}
+
+		if (NewBlueprint)
+		{
+			CreatedValues.Add(MakeShareable(new FJsonValueString(TargetPath)));
+		}
+		else
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Stamp failed for %s: %s"), *TargetPath, *Error);
+
+			TSharedPtr<FJsonObject> FailedJson = MakeShareable(new FJsonObject);
+			FailedJson->SetStringField(TEXT("blueprint_path"), TargetPath);
+			FailedJson->SetStringField(TEXT("message"), Error);
+			FailedValues.Add(MakeShareable(new FJsonValueObject(FailedJson)));
+		}
+	}
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	ResponseJson->SetBoolField(TEXT("success"), FailedValues.Num() == 0);
+	ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Stamped %d of %d asset(s) from template '%s' (%d unchanged)"), CreatedValues.Num(), TargetPaths.Num(), *TemplateName, UnchangedValues.Num()));
+	ResponseJson->SetStringField(TEXT("template"), TemplateName);
+	ResponseJson->SetArrayField(TEXT("created"), CreatedValues);
+	ResponseJson->SetArrayField(TEXT("unchanged"), UnchangedValues);
+	ResponseJson->SetArrayField(TEXT("failed"), FailedValues);
+	ResponseJson->SetNumberField(TEXT("skipped"), SkippedCount);
+	ResponseJson->SetNumberField(TEXT("template_build_ms"), TemplateCache->GetBuildSeconds(TemplateName) * 1000.0);
+	ResponseJson->SetNumberField(TEXT("elapsed_ms"), ElapsedSeconds * 1000.0);
+	if (const TSharedPtr<FJsonObject> CompileJson = TemplateCache->GetCompileResult(TemplateName))
+	{
+		ResponseJson->SetObjectField(TEXT("compile"), CompileJson);
+	}
+
+	return Result;
+}
+
+FMCPOperationResult FMCPOperationRunner::DryRunAddNode(const FString& BlueprintPath, const FString& NodeType)
+{
+	FMCPOperationResult Result;
+	Result.Json = MakeShareable(new FJsonObject);
+	TSharedPtr<FJsonObject>& ResponseJson = Result.Json;
+	ResponseJson->SetBoolField(TEXT("dry_run"), true);
+	ResponseJson->SetStringField(TEXT("blueprint_path"), BlueprintPath);
+	ResponseJson->SetStringField(TEXT("node_type"), NodeType);
+
+#if WITH_EDITOR
+	FString PackageName, AssetName;
+	if (!FMCPBlueprintUtils::IsSupportedNodeType(NodeType) || !FMCPBlueprintUtils::SplitBlueprintPath(BlueprintPath, PackageName, AssetName))
+	{
+		Result.Code = EHttpServerResponseCodes::BadRequest;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Cannot build a %s node at '%s'"), *NodeType, *BlueprintPath));
+		return Result;
+	}
+
+	if (HasExpiredBefore(TEXT("compile")))
+	{
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Built under /Temp: never saved, never announced to the asset registry
+	FString DryRunId;
+	UPackage* Package = CreatePackage(*DryRunStore.MakePackageName(AssetName, DryRunId));
+	TSharedRef<FJsonObject> CompileJson = MakeShared<FJsonObject>();
+	bool bCompiled = false;
+	UBlueprint* Blueprint = Package ? FMCPBlueprintUtils::BuildAndCompileActorBlueprint(Package, AssetName, { NodeType }, CompileJson, bCompiled) : nullptr;
+	if (!Blueprint)
+	{
+		FMCPBlueprintUtils::DiscardPackage(Package);
+		Result.Code = EHttpServerResponseCodes::ServerError;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Failed to build dry run for '%s'"), *BlueprintPath));
+		return Result;
+	}
+
+	TSharedRef<FJsonObject> GraphJson = MakeShared<FJsonObject>();
+	FMCPBlueprintUtils::WriteGraphSummary(Blueprint, GraphJson);
+
+	const FString ContentHash = FMCPBlueprintUtils::ComputeContentHash({ NodeType });
+	FMCPBlueprintUtils::SetContentHash(Blueprint, ContentHash);
+
+	// What committing would do at the target; the existing asset is left alone
+	UObject* LoadedAsset = nullptr;
+	const EMCPTargetState TargetState = CheckTarget(BlueprintPath, ContentHash, false, LoadedAsset);
+
+	const bool bKept = DryRunStore.Add(DryRunId, BlueprintPath, ContentHash, Blueprint);
+
+	ResponseJson->SetBoolField(TEXT("success"), bCompiled);
+	ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Dry run %s for '%s'; nothing was saved"), bCompiled ? TEXT("compiled") : TEXT("failed to compile"), *BlueprintPath));
+	if (bKept)
+	{
+		ResponseJson->SetStringField(TEXT("dry_run_id"), DryRunId);
+	}
+	ResponseJson->SetBoolField(TEXT("kept"), bKept);
+	ResponseJson->SetBoolField(TEXT("target_unchanged"), TargetState == EMCPTargetState::Unchanged);
+	ResponseJson->SetBoolField(TEXT("target_conflict"), TargetState == EMCPTargetState::Conflict);
+	ResponseJson->SetStringField(TEXT("content_hash"), ContentHash);
+	ResponseJson->SetObjectField(TEXT("compile"), CompileJson);
+	ResponseJson->SetObjectField(TEXT("graph"), GraphJson);
+	ResponseJson->SetNumberField(TEXT("elapsed_ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+#else
+	Result.Code = EHttpServerResponseCodes::ServerError;
+	ResponseJson->SetBoolField(TEXT("success"), false);
+	ResponseJson->SetStringField(TEXT("message"), TEXT("Dry runs are only supported in editor builds"));
+#endif
+	return Result;
+}
+
+FMCPOperationResult FMCPOperationRunner::Commit(const TSharedPtr<FJsonObject>& Body)
+{
+	FMCPGCBatchScope GCBatch(*GCPolicy);
+
+	FMCPOperationResult Result;
+	Result.Json = MakeShareable(new FJsonObject);
+	TSharedPtr<FJsonObject>& ResponseJson = Result.Json;
+
+	FString DryRunId;
+	Body->TryGetStringField(TEXT("dry_run_id"), DryRunId);
+	ResponseJson->SetStringField(TEXT("dry_run_id"), DryRunId);
+
+	FMCPDryRunResult DryRun;
+	if (!DryRunStore.Take(DryRunId, DryRun))
+	{
+		Result.Code = EHttpServerResponseCodes::NotFound;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("No kept dry run '%s'; it may have expired or already been committed"), *DryRunId));
+		return Result;
+	}
+	ResponseJson->SetStringField(TEXT("blueprint_path"), DryRun.BlueprintPath);
+
+#if WITH_EDITOR
+	UBlueprint* Blueprint = DryRun.Blueprint.Get();
+
+	bool bForce = false;
+	Body->TryGetBoolField(TEXT("force"), bForce);
+	FString TargetMessage;
+	const EMCPTargetState TargetState = ClaimTarget(DryRun.BlueprintPath, DryRun.ContentHash, bForce, TargetMessage);
+	if (TargetState == EMCPTargetState::Unchanged)
+	{
+		FMCPDryRunStore::Release(Blueprint);
+		ResponseJson->SetBoolField(TEXT("success"), true);
+		ResponseJson->SetBoolField(TEXT("unchanged"), true);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Blueprint at '%s' already has this content"), *DryRun.BlueprintPath));
+		return Result;
+	}
+
+	if (TargetState == EMCPTargetState::Conflict)
+	{
+		FMCPDryRunStore::Release(Blueprint);
+		Result.Code = EHttpServerResponseCodes::Conflict;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), TargetMessage);
+		return Result;
+	}
+
+	FString PackageName, AssetName;
+	FMCPBlueprintUtils::SplitBlueprintPath(DryRun.BlueprintPath, PackageName, AssetName);
+	if (FindPackage(nullptr, *PackageName))
+	{
+		FMCPDryRunStore::Release(Blueprint);
+		Result.Code = EHttpServerResponseCodes::Conflict;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Package '%s' is loaded and does not hold a Blueprint this route can replace"), *PackageName));
+		return Result;
+	}
+
+	if (HasExpiredBefore(TEXT("save")))
+	{
+		FMCPDryRunStore::Release(Blueprint);
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		return Result;
+	}
+
+	// Moving the package promotes the compiled Blueprint as is; the asset was built with the target's name
+	UPackage* Package = Blueprint->GetOutermost();
+	Package->Rename(*PackageName, nullptr, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+	if (!CommitNewAsset(Package, Blueprint))
+	{
+		FMCPBlueprintUtils::DiscardPackage(Package);
+		Result.Code = EHttpServerResponseCodes::ServerError;
+		ResponseJson->SetBoolField(TEXT("success"), false);
+		ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Failed to save '%s'"), *DryRun.BlueprintPath));
+		return Result;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Committed dry run %s to %s"), *DryRunId, *DryRun.BlueprintPath);
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	ResponseJson->SetBoolField(TEXT("unchanged"), false);
+	ResponseJson->SetStringField(TEXT("message"), FString::Printf(TEXT("Committed dry run '%s' to '%s'"), *DryRunId, *DryRun.BlueprintPath));
+#else
+	Result.Code = EHttpServerResponseCodes::ServerError;
+	ResponseJson->SetBoolField(TEXT("success"), false);
+	ResponseJson->SetStringField(TEXT("message"), TEXT("Commit is only supported in editor builds"));
+#endif
+	return Result;
+}
+
+bool FMCPOperationRunner::CreateBlueprintWithPrintString(const FString& BlueprintPath, const FString& NodeType, const TSharedPtr<FJsonObject>& OutCompileJson)
+{
+#if WITH_EDITOR
+	// ✅ 확인됨: UE5.6 소스코드에서 검증된 블루프린트 생성 방법
+	UE_LOG(LogUnrealMCP, Log, TEXT("Creating Blueprint at path: %s with node type: %s"), *BlueprintPath, *NodeType);
+
+	if (!FMCPBlueprintUtils::IsSupportedNodeType(NodeType))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Unsupported node type: %s. Only 'PrintString' is currently supported."), *NodeType);
+		return false;
+	}
+
+	// Parse the asset path to extract package and asset names
+	FString FullPackageName, AssetName;
+	if (!FMCPBlueprintUtils::SplitBlueprintPath(BlueprintPath, FullPackageName, AssetName))
+	{
+		return false;
+	}
+
+	// Creating the Blueprint compiles it
+	if (HasExpiredBefore(TEXT("compile")))
+	{
+		return false;
+	}
+
+	UPackage* Package = CreatePackage(*FullPackageName);
+	if (!Package)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to create package: %s"), *FullPackageName);
+		return false;
+	}
+
+	// A single full compile with a results log produces the diagnostics, and a Blueprint that does not compile is not saved
+	TSharedRef<FJsonObject> CompileJson = OutCompileJson.IsValid() ? OutCompileJson.ToSharedRef() : MakeShared<FJsonObject>();
+	bool bCompiled = false;
+	UBlueprint* NewBlueprint = FMCPBlueprintUtils::BuildAndCompileActorBlueprint(Package, AssetName, { NodeType }, CompileJson, bCompiled);
+	if (!NewBlueprint)
+	{
+		return false;
+	}
+
+	if (!bCompiled)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Blueprint %s failed to compile with %d error(s)"), *BlueprintPath, static_cast<int32>(CompileJson->GetNumberField(TEXT("errors"))));
+		FMCPBlueprintUtils::DiscardPackage(Package);
+		return false;
+	}
+
+	if (HasExpiredBefore(TEXT("save")))
+	{
+		FMCPBlueprintUtils::DiscardPackage(Package);
+		return false;
+	}
+
+	FMCPBlueprintUtils::SetContentHash(NewBlueprint, FMCPBlueprintUtils::ComputeContentHash({ NodeType }));
+	if (!CommitNewAsset(Package, NewBlueprint))
+	{
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Successfully created Blueprint with PrintString node at: %s"), *BlueprintPath);
+	return true;
+
+#else
+	UE_LOG(LogUnrealMCP, Error, TEXT("Blueprint creation is only supported in editor builds"));
+	return false;
+#endif
+}
+
+bool FMCPOperationRunner::CommitNewAsset(UPackage* Package, UBlueprint* Blueprint)
+{
+#if WITH_EDITOR
+	if (bDeferSaves)
+	{
+		Package->MarkAsFullyLoaded();
+		Package->SetDirtyFlag(true);
+		PendingSaves.Emplace(TStrongObjectPtr<UPackage>(Package), TStrongObjectPtr<UBlueprint>(Blueprint));
+	}
+	else if (!FMCPBlueprintUtils::SaveBlueprintPackage(Package, Blueprint))
+	{
+		return false;
+	}
+
+	// Register with asset registry, at the end of the batch if one is open
+	AssetNotifier.NotifyAssetCreated(Blueprint);
+	++CreatedAssetCount;
+	GCPolicy->NotifyAssetCreated();
+	return true;
+#else
+	return false;
+#endif
+}
+
+int32 FMCPOperationRunner::FlushPendingSaves(int32 BatchSize)
+{
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	int32 FailedCount = 0;
+	for (int32 Index = 0; Index < PendingSaves.Num(); ++Index)
+	{
+		UPackage* Package = PendingSaves[Index].Key.Get();
+		UBlueprint* Blueprint = PendingSaves[Index].Value.Get();
+		if (!Package || !Blueprint || !FMCPBlueprintUtils::SaveBlueprintPackage(Package, Blueprint))
+		{
+			++FailedCount;
+		}
+
+		if ((Index + 1) % BatchSize == 0 || Index + 1 == PendingSaves.Num())
+		{
+			UE_LOG(LogUnrealMCP, Display, TEXT("Saved %d/%d package(s)"), Index + 1, PendingSaves.Num());
+		}
+	}
+
+	PendingSaves.Reset();
+	return FailedCount;
+}
@@ -0,0 +1,229 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpServerConstants.h"
+#include "MCPGCPolicy.h"
+#include "MCPAssetNotifier.h"
+#include "MCPDryRunStore.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FJsonObject;
+class FMCPBlueprintTemplateCache;
+class UBlueprint;
+class UObject;
+class UPackage;
+
+/**
+ * Result of a single MCP operation, independent of the transport that carried it
+ */
+struct FMCPOperationResult
+{
+	/** Status code reported to HTTP clients */
+	EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok;
+
+	/** Response body */
+	TSharedPtr<FJsonObject> Json;
+
+	/** Whether the operation reported success */
+	bool IsSuccess() const;
+};
+
+/**
+ * What creating an asset at a path does to the asset already there
+ */
+enum class EMCPTargetState : uint8
+{
+	/** Nothing is there, or the asset there is replaced */
+	Create,
+	/** The asset there already has the requested content */
+	Unchanged,
+	/** An asset MCP did not create is there and force was not set */
+	Conflict,
+};
+
+/**
+ * Executes MCP operations (the bodies accepted by the mutating HTTP routes) against the editor.
+ * Shared by FMCPHttpServer and the UnrealMCP commandlet so both run the same engine code path.
+ */
+class FMCPOperationRunner
+{
+public:
+	FMCPOperationRunner();
+	~FMCPOperationRunner();
+
+	/**
+	 * Check whether a route is handled by Execute
+	 * @param Route Route path (e.g., "/add_node")
+	 */
+	static bool IsKnownOperation(const FString& Route);
+
+	/**
+	 * Estimate the cost of an operation in assets it will create, for admission control
+	 * @param Route Route path
+	 * @param Body Parsed request body
+	 */
+	static int32 EstimateCost(const FString& Route, const TSharedPtr<FJsonObject>& Body);
+
+	/**
+	 * Execute an operation
+	 * @param Route Route path (e.g., "/add_node" or "/stamp")
+	 * @param Body Parsed request body
+	 * The body's "transaction" field selects how the operation is recorded for undo: "none" (default) or "batch"
+	 * @param DeadlineSeconds FPlatformTime::Seconds after which remaining work is dropped before compile and before save, or 0 for none
+	 * @return Status code and response body; 504 Gateway Timeout if the deadline cut the operation short
+	 */
+	FMCPOperationResult Execute(const FString& Route, const TSharedPtr<FJsonObject>& Body, double DeadlineSeconds = 0.0);
+
+	/**
+	 * Handle an /add_node body
+	 */
+	FMCPOperationResult AddNode(const TSharedPtr<FJsonObject>& Body);
+
+	/**
+	 * Handle a /stamp body
+	 */
+	FMCPOperationResult Stamp(const TSharedPtr<FJsonObject>& Body);
+
+	/**
+	 * Handle a /commit body: save a kept dry-run result at the path it was built for
+	 */
+	FMCPOperationResult Commit(const TSharedPtr<FJsonObject>& Body);
+
+	/**
+	 * Create a new Blueprint and add a PrintString node to it
+	 * @param BlueprintPath The asset path for the new Blueprint (e.g., "/Game/MyBlueprint")
+	 * @param NodeType The type of node to add (currently only "PrintString" supported)
+	 * @param OutCompileJson Receives the compile status and diagnostics, if valid
+	 * @return True if Blueprint was created, compiled without errors and saved
+	 */
+	bool CreateBlueprintWithPrintString(const FString& BlueprintPath, const FString& NodeType, const TSharedPtr<FJsonObject>& OutCompileJson = nullptr);
+
+	/**
+	 * Defer package saves until FlushPendingSaves instead of saving each asset as it is created
+	 */
+	void SetDeferSaves(bool bInDeferSaves) { bDeferSaves = bInDeferSaves; }
+
+	/**
+	 * Save all deferred packages
+	 * @param BatchSize Number of packages saved between progress reports
+	 * @return Number of packages that failed to save
+	 */
+	int32 FlushPendingSaves(int32 BatchSize);
+
+	/** Number of packages waiting for FlushPendingSaves */
+	int32 GetPendingSaveCount() const { return PendingSaves.Num(); }
+
+	/**
+	 * Forget deferred saves without writing them
+	 * Used by the soak commandlet, which releases its assets instead of saving them
+	 */
+	void DiscardPendingSaves() { PendingSaves.Reset(); }
+
+	/** Number of assets created (saved or queued) since this runner was constructed */
+	int64 GetCreatedAssetCount() const { return CreatedAssetCount; }
+
+	/** Prototype Blueprints used by /stamp */
+	FMCPBlueprintTemplateCache& GetTemplateCache() const { return *TemplateCache; }
+
+	/** Garbage collection policy applied while operations run */
+	const FMCPGCPolicy& GetGCPolicy() const { return *GCPolicy; }
+
+	/** Asset registry notifications for created assets; hold a batch open to send them in one pass */
+	FMCPAssetNotifier& GetAssetNotifier() { return AssetNotifier; }
+	const FMCPAssetNotifier& GetAssetNotifier() const { return AssetNotifier; }
+
+	/** Number of requested assets skipped because the existing asset already had the same content hash */
+	int64 GetUnchangedAssetCount() const { return UnchangedAssetCount; }
+
+	/** Number of stage boundaries at which work was dropped because its deadline had passed */
+	int64 GetExpiredStageCount() const { return ExpiredStageCount; }
+
+	/** Write undo buffer size and per-request growth */
+	void WriteUndoStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+	/** Dry-run results waiting for /commit */
+	const FMCPDryRunStore& GetDryRunStore() const { return DryRunStore; }
+
+private:
+	/**
+	 * Check the current operation's deadline at a stage boundary
+	 * @param Stage Stage about to start, for logs and the response ("compile" or "save")
+	 * @return True if the remaining work should be dropped
+	 */
+	bool HasExpiredBefore(const TCHAR* Stage);
+
+	/**
+	 * Compare requested content with the asset already at a path, without changing anything
+	 * Only an asset carrying an MCP content hash is replaced, unless bForce is set
+	 * @param BlueprintPath Target asset path
+	 * @param ContentHash Hash of the requested operation set
+	 * @param bForce Rebuild even if the hashes match, and replace assets MCP did not create
+	 * @param OutLoadedAsset Receives the loaded asset that must be deleted before a Create, if any
+	 */
+	EMCPTargetState CheckTarget(const FString& BlueprintPath, const FString& ContentHash, bool bForce, UObject*& OutLoadedAsset) const;
+
+	/**
+	 * Delete loaded assets that are about to be rebuilt, with one garbage collection for all of them
+	 * @param AssetsByPath Loaded assets keyed by their asset path
+	 * @param OutRemainingPaths Receives the paths whose asset could not be deleted
+	 */
+	void ReplaceLoadedAssets(const TMap<FString, UObject*>& AssetsByPath, TSet<FString>& OutRemainingPaths);
+
+	/**
+	 * CheckTarget, then free the path of a loaded asset that will be rebuilt
+	 * @param OutMessage Why the path cannot be used, for a Conflict
+	 */
+	EMCPTargetState ClaimTarget(const FString& BlueprintPath, const FString& ContentHash, bool bForce, FString& OutMessage);
+
+	/**
+	 * Build and compile an /add_node Blueprint in a /Temp package without saving or registering it
+	 * The result is kept in DryRunStore for /commit
+	 */
+	FMCPOperationResult DryRunAddNode(const FString& BlueprintPath, const FString& NodeType);
+
+	/** Mark a result as cut short by the deadline */
+	void SetDeadlineExceeded(FMCPOperationResult& Result) const;
+
+	/**
+	 * Save a newly created asset, or queue it when saves are deferred, and register it with the asset registry
+	 * @return True if the asset was saved or queued
+	 */
+	bool CommitNewAsset(UPackage* Package, UBlueprint* Blueprint);
+
+	/** Maximum number of assets a single /stamp request may create */
+	static constexpr int32 MaxStampCount = 10000;
+
+	/** Prototype Blueprints used by /stamp */
+	TUniquePtr<FMCPBlueprintTemplateCache> TemplateCache;
+
+	/** Deferred saves; rooted so a forced collection cannot take an unsaved asset */
+	bool bDeferSaves = false;
+	TArray<TPair<TStrongObjectPtr<UPackage>, TStrongObjectPtr<UBlueprint>>> PendingSaves;
+
+	/** Deadline of the operation being executed, and the stage it expired before */
+	double CurrentDeadlineSeconds = 0.0;
+	const TCHAR* ExpiredStage = nullptr;
+	int64 ExpiredStageCount = 0;
+
+	/** Blueprints built by dry runs */
+	FMCPDryRunStore DryRunStore;
+
+	/** Undo buffer growth of the last and largest request, and requests run as one transaction */
+	uint64 LastUndoBytes = 0;
+	uint64 MaxUndoBytes = 0;
+	int64 BatchTransactionCount = 0;
+
+	/** Requested assets skipped as unchanged */
+	int64 UnchangedAssetCount = 0;
+
+	/** Assets created so far; the x axis for memory growth tracking */
+	int64 CreatedAssetCount = 0;
+
+	/** Sends, or holds back during a batch, asset registry notifications */
+	FMCPAssetNotifier AssetNotifier;
+
+	/** Defers engine collections during bursts and forces them by asset count or memory growth; shared by all runners */
+	TSharedRef<FMCPGCPolicy> GCPolicy;
+};
@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPServerWarmUp.h"
+#include "MCPBlueprintUtils.h"
+#include "MCPBlueprintTemplates.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Modules/ModuleManager.h"
+
+#if WITH_EDITOR
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#endif
+
+void FMCPServerWarmUp::Begin(FMCPBlueprintTemplateCache* InTemplateCache)
+{
+	TemplateCache = InTemplateCache;
+	NextStageIndex = 0;
+	Timings.Reset();
+
+	Stages.Reset();
+	Stages.Add({ TEXT("modules"), &FMCPServerWarmUp::WarmModules });
+	Stages.Add({ TEXT("schema"), &FMCPServerWarmUp::WarmSchema });
+	Stages.Add({ TEXT("function_index"), &FMCPServerWarmUp::WarmFunctionIndex });
+	Stages.Add({ TEXT("compiler"), &FMCPServerWarmUp::WarmCompiler });
+	Stages.Add({ TEXT("templates"), [this]() { return WarmTemplates(); } });
+}
+
+bool FMCPServerWarmUp::RunNextStage()
+{
+	if (IsComplete())
+	{
+		return false;
+	}
+
+	const FStage& Stage = Stages[NextStageIndex++];
+
+	const double StartTime = FPlatformTime::Seconds();
+	FMCPWarmUpStageTiming& Timing = Timings.AddDefaulted_GetRef();
+	Timing.Name = Stage.Name;
+	Timing.bSucceeded = Stage.Run();
+	Timing.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Warm-up stage '%s' %s in %.2f ms"),
+		*Timing.Name, Timing.bSucceeded ? TEXT("completed") : TEXT("failed"), Timing.Seconds * 1000.0);
+
+	if (IsComplete())
+	{
+		UE_LOG(LogUnrealMCP, Log, TEXT("Warm-up completed in %.2f ms"), GetTotalSeconds() * 1000.0);
+	}
+	return !IsComplete();
+}
+
+void FMCPServerWarmUp::Finish()
+{
+	while (RunNextStage())
+	{
+	}
+}
+
+double FMCPServerWarmUp::GetTotalSeconds() const
+{
+	double TotalSeconds = 0.0;
+	for (const FMCPWarmUpStageTiming& Timing : Timings)
+	{
+		TotalSeconds += Timing.Seconds;
+	}
+	return TotalSeconds;
+}
+
+void FMCPServerWarmUp::WriteTimings(const TSharedRef<FJsonObject>& OutJson) const
+{
+	OutJson->SetBoolField(TEXT("complete"), HasStarted() && IsComplete());
+	OutJson->SetNumberField(TEXT("total_ms"), GetTotalSeconds() * 1000.0);
+
+	TSharedPtr<FJsonObject> StagesJson = MakeShareable(new FJsonObject);
+	for (const FMCPWarmUpStageTiming& Timing : Timings)
+	{
+		StagesJson->SetNumberField(Timing.Name, Timing.Seconds * 1000.0);
+	}
+	OutJson->SetObjectField(TEXT("stages_ms"), StagesJson);
+}
+
+bool FMCPServerWarmUp::WarmModules()
+{
+	// These are normally loaded on first use by the Blueprint editor and the Kismet compiler
+	static const TCHAR* ModuleNames[] = {
+		TEXT("AssetRegistry"),
+		TEXT("BlueprintGraph"),
+		TEXT("KismetCompiler"),
+		TEXT("Kismet"),
+	};
+
+	bool bAllLoaded = true;
+	for (const TCHAR* ModuleName : ModuleNames)
+	{
+		if (!FModuleManager::Get().LoadModule(ModuleName))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Warm-up could not load module '%s'"), ModuleName);
+			bAllLoaded = false;
+		}
+	}
+	return bAllLoaded;
+}
+
+bool FMCPServerWarmUp::WarmSchema()
+{
+#if WITH_EDITOR
+	return GetDefault<UEdGraphSchema_K2>() != nullptr;
+#else
+	return false;
+#endif
+}
+
+bool FMCPServerWarmUp::WarmFunctionIndex()
+{
+	FMCPBlueprintUtils::BuildNodeFunctionIndex();
+	return true;
+}
+
+bool FMCPServerWarmUp::WarmCompiler()
+{
+#if WITH_EDITOR
+	// A unique name per warm-up, so a restart never builds over an object left from the last one
+	const FName PackageName = MakeUniqueObjectName(nullptr, UPackage::StaticClass(), FName(TEXT("/Temp/UnrealMCP/WarmUp/MCPWarmUpBlueprint")));
+	UPackage* Package = CreatePackage(*PackageName.ToString());
+	Package->SetFlags(RF_Transient);
+
+	// Built and compiled the same way as /add_node, so the first request finds the same code paths warm
+	TSharedRef<FJsonObject> CompileJson = MakeShared<FJsonObject>();
+	bool bCompiled = false;
+	UBlueprint* Blueprint = FMCPBlueprintUtils::BuildAndCompileActorBlueprint(Package, TEXT("MCPWarmUpBlueprint"), { TEXT("PrintString") }, CompileJson, bCompiled);
+	if (!Blueprint)
+	{
+		FMCPBlueprintUtils::DiscardPackage(Package);
+		return false;
+	}
+
+	// Nothing references the throwaway Blueprint, so it is discarded for the next garbage collection to reclaim
+	FMCPBlueprintUtils::DiscardPackage(Package);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FMCPServerWarmUp::WarmTemplates()
+{
+	return TemplateCache && TemplateCache->Prebuild(FMCPBlueprintTemplateCache::DefaultTemplateName);
+}
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FMCPBlueprintTemplateCache;
+
+/**
+ * Timing for a single warm-up stage
+ */
+struct FMCPWarmUpStageTiming
+{
+	FString Name;
+	double Seconds = 0.0;
+	bool bSucceeded = true;
+};
+
+/**
+ * Pays the lazy-initialization costs of the Blueprint pipeline before the first request does.
+ * Stages run one per tick so the HTTP listener can keep answering /status while warming up.
+ */
+class FMCPServerWarmUp
+{
+public:
+	/**
+	 * Reset and prepare all stages
+	 * @param InTemplateCache Template cache whose default prototype is prebuilt, may be null
+	 */
+	void Begin(FMCPBlueprintTemplateCache* InTemplateCache);
+
+	/**
+	 * Run the next pending stage
+	 * @return True while more stages remain
+	 */
+	bool RunNextStage();
+
+	/** Run every remaining stage immediately */
+	void Finish();
+
+	/** Check whether all stages have run */
+	bool IsComplete() const { return NextStageIndex >= Stages.Num(); }
+
+	/** Check whether Begin has been called */
+	bool HasStarted() const { return Stages.Num() > 0; }
+
+	/** Total time spent in completed stages */
+	double GetTotalSeconds() const;
+
+	/** Write stage timings into a JSON object */
+	void WriteTimings(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	/** Load the editor modules the Blueprint pipeline depends on */
+	static bool WarmModules();
+
+	/** Touch the K2 schema default object */
+	static bool WarmSchema();
+
+	/** Build the node type to function index */
+	static bool WarmFunctionIndex();
+
+	/** Build and compile a throwaway Blueprint in a transient package */
+	static bool WarmCompiler();
+
+	/** Build the default template prototype used by /stamp */
+	bool WarmTemplates();
+
+	struct FStage
+	{
+		FString Name;
+		TFunction<bool()> Run;
+	};
+
+	TArray<FStage> Stages;
+	TArray<FMCPWarmUpStageTiming> Timings;
+	int32 NextStageIndex = 0;
+	FMCPBlueprintTemplateCache* TemplateCache = nullptr;
+};
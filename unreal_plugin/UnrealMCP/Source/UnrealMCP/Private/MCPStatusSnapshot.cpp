@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPStatusSnapshot.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	const TCHAR* GetRequestClassName(EMCPRequestClass RequestClass)
+	{
+		switch (RequestClass)
+		{
+		case EMCPRequestClass::Health:
+			return TEXT("health");
+		case EMCPRequestClass::Read:
+			return TEXT("read");
+		case EMCPRequestClass::Mutation:
+			return TEXT("mutation");
+		default:
+			return TEXT("unknown");
+		}
+	}
+
+	/** Nearest-rank percentile of sorted samples */
+	double Percentile(const TArray<float>& SortedSamples, double Fraction)
+	{
+		if (SortedSamples.Num() == 0)
+		{
+			return 0.0;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+}
+
+void FMCPLatencyWindow::Add(double Seconds)
+{
+	const float Ms = static_cast<float>(Seconds * 1000.0);
+	if (SamplesMs.Num() < WindowSize)
+	{
+		SamplesMs.Add(Ms);
+	}
+	else
+	{
+		SamplesMs[NextSample] = Ms;
+		NextSample = (NextSample + 1) % WindowSize;
+	}
+
+	++Count;
+	MaxMs = FMath::Max(MaxMs, static_cast<double>(Ms));
+}
+
+void FMCPLatencyWindow::Write(const TSharedRef<FJsonObject>& OutJson) const
+{
+	TArray<float> Sorted = SamplesMs;
+	Sorted.Sort();
+
+	OutJson->SetNumberField(TEXT("count"), static_cast<double>(Count));
+	OutJson->SetNumberField(TEXT("p50_ms"), Percentile(Sorted, 0.50));
+	OutJson->SetNumberField(TEXT("p99_ms"), Percentile(Sorted, 0.99));
+	OutJson->SetNumberField(TEXT("max_ms"), MaxMs);
+}
+
+void FMCPStatusSnapshot::Publish(const TSharedRef<FJsonObject>& StatusJson)
+{
+	FScopeLock ScopeLock(&Lock);
+	Status = StatusJson;
+	PublishedSeconds = FPlatformTime::Seconds();
+}
+
+void FMCPStatusSnapshot::BeginJob(const FString& Route, uint64 JobId)
+{
+	FScopeLock ScopeLock(&Lock);
+	ActiveRoute = Route;
+	ActiveJobId = JobId;
+	ActiveSinceSeconds = FPlatformTime::Seconds();
+}
+
+void FMCPStatusSnapshot::EndJob()
+{
+	FScopeLock ScopeLock(&Lock);
+	ActiveRoute.Reset();
+	ActiveJobId = 0;
+}
+
+void FMCPStatusSnapshot::RecordLatency(EMCPRequestClass RequestClass, double Seconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	Latency[static_cast<int32>(RequestClass)].Add(Seconds);
+}
+
+void FMCPStatusSnapshot::WriteLatency(const TSharedRef<FJsonObject>& OutJson) const
+{
+	FScopeLock ScopeLock(&Lock);
+	for (int32 Index = 0; Index < static_cast<int32>(EMCPRequestClass::Count); ++Index)
+	{
+		TSharedRef<FJsonObject> ClassJson = MakeShared<FJsonObject>();
+		Latency[Index].Write(ClassJson);
+		OutJson->SetObjectField(GetRequestClassName(static_cast<EMCPRequestClass>(Index)), ClassJson);
+	}
+}
+
+bool FMCPStatusSnapshot::Serialize(FString& OutBody) const
+{
+	// Shallow copy: the published values are never modified, so they can be shared with this thread
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!Status.IsValid())
+		{
+			return false;
+		}
+
+		const double NowSeconds = FPlatformTime::Seconds();
+		ResponseJson->Values = Status->Values;
+		ResponseJson->SetStringField(TEXT("source"), TEXT("snapshot"));
+		ResponseJson->SetNumberField(TEXT("snapshot_age_ms"), (NowSeconds - PublishedSeconds) * 1000.0);
+
+		TSharedRef<FJsonObject> BusyJson = MakeShared<FJsonObject>();
+		BusyJson->SetBoolField(TEXT("running_job"), ActiveJobId != 0);
+		if (ActiveJobId != 0)
+		{
+			BusyJson->SetStringField(TEXT("route"), ActiveRoute);
+			BusyJson->SetNumberField(TEXT("job_id"), static_cast<double>(ActiveJobId));
+			BusyJson->SetNumberField(TEXT("running_ms"), (NowSeconds - ActiveSinceSeconds) * 1000.0);
+		}
+		ResponseJson->SetObjectField(TEXT("game_thread"), BusyJson);
+	}
+
+	TSharedRef<FJsonObject> DispatchJson = MakeShared<FJsonObject>();
+	WriteLatency(DispatchJson);
+	ResponseJson->SetObjectField(TEXT("dispatch"), DispatchJson);
+
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutBody);
+	return FJsonSerializer::Serialize(ResponseJson, Writer);
+}
+
+FMCPLatencyScope::FMCPLatencyScope(FMCPStatusSnapshot& InSnapshot, EMCPRequestClass InRequestClass)
+	: Snapshot(InSnapshot)
+	, RequestClass(InRequestClass)
+	, StartSeconds(FPlatformTime::Seconds())
+{
+}
+
+FMCPLatencyScope::~FMCPLatencyScope()
+{
+	Snapshot.RecordLatency(RequestClass, FPlatformTime::Seconds() - StartSeconds);
+}
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FJsonObject;
+
+/**
+ * Dispatch class of a request, from highest to lowest priority
+ * Health is answered from a snapshot, Read runs as soon as the router ticks, Mutation goes through the budgeted job queue
+ */
+enum class EMCPRequestClass : uint8
+{
+	Health,
+	Read,
+	Mutation,
+	Count
+};
+
+/**
+ * Rolling window of request latencies for one dispatch class
+ */
+class FMCPLatencyWindow
+{
+public:
+	/** Record one request */
+	void Add(double Seconds);
+
+	/** Write count, p50, p99 and max over the window */
+	void Write(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	/** Samples kept for percentiles */
+	static constexpr int32 WindowSize = 1024;
+
+	TArray<float> SamplesMs;
+	int32 NextSample = 0;
+	int64 Count = 0;
+	double MaxMs = 0.0;
+};
+
+/**
+ * Thread-safe copy of the /status response
+ * The game thread publishes a fresh snapshot every few frames and marks the job it is running;
+ * FMCPHealthListener serves it from its own thread, so health checks are answered even while a
+ * long mutation holds the game thread.
+ */
+class FMCPStatusSnapshot
+{
+public:
+	/** Replace the published status; the object must not be modified afterwards (game thread) */
+	void Publish(const TSharedRef<FJsonObject>& StatusJson);
+
+	/** Mark a queued job as running on the game thread */
+	void BeginJob(const FString& Route, uint64 JobId);
+
+	/** Clear the running job */
+	void EndJob();
+
+	/** Record a completed request (any thread) */
+	void RecordLatency(EMCPRequestClass RequestClass, double Seconds);
+
+	/** Write per-class latency windows (any thread) */
+	void WriteLatency(const TSharedRef<FJsonObject>& OutJson) const;
+
+	/**
+	 * Serialize the last published status with its age, the running job and live latency windows (any thread)
+	 * @param OutBody Receives the JSON body
+	 * @return False if nothing has been published yet
+	 */
+	bool Serialize(FString& OutBody) const;
+
+private:
+	mutable FCriticalSection Lock;
+
+	/** Last published status, immutable once published */
+	TSharedPtr<FJsonObject> Status;
+	double PublishedSeconds = 0.0;
+
+	/** Job running on the game thread, if any */
+	FString ActiveRoute;
+	uint64 ActiveJobId = 0;
+	double ActiveSinceSeconds = 0.0;
+
+	FMCPLatencyWindow Latency[static_cast<int32>(EMCPRequestClass::Count)];
+};
+
+/**
+ * Records the lifetime of the scope as one request of the given class
+ */
+class FMCPLatencyScope
+{
+public:
+	FMCPLatencyScope(FMCPStatusSnapshot& InSnapshot, EMCPRequestClass InRequestClass);
+	~FMCPLatencyScope();
+
+private:
+	FMCPStatusSnapshot& Snapshot;
+	EMCPRequestClass RequestClass;
+	double StartSeconds;
+};
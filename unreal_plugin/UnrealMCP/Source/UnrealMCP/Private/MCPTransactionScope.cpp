@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPTransactionScope.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ITransaction.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "ScopedTransaction.h"
+#endif
+
+FMCPTransactionScope::FMCPTransactionScope(EMCPTransactionMode InMode, const FText& Description)
+	: Mode(InMode)
+	, UndoBytesAtStart(GetUndoBufferBytes())
+{
+	if (Mode == EMCPTransactionMode::None)
+	{
+		// Modify() only records into GUndo, so without one nothing is snapshotted
+		SavedUndo = GUndo;
+		GUndo = nullptr;
+	}
+#if WITH_EDITOR
+	else
+	{
+		Transaction = MakeUnique<FScopedTransaction>(Description);
+	}
+#endif
+}
+
+FMCPTransactionScope::~FMCPTransactionScope()
+{
+#if WITH_EDITOR
+	Transaction.Reset();
+#endif
+	if (Mode == EMCPTransactionMode::None)
+	{
+		GUndo = SavedUndo;
+	}
+}
+
+bool FMCPTransactionScope::ParseMode(const FString& Name, EMCPTransactionMode& OutMode)
+{
+	if (Name.IsEmpty() || Name.Equals(TEXT("none"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EMCPTransactionMode::None;
+		return true;
+	}
+	if (Name.Equals(TEXT("batch"), ESearchCase::IgnoreCase))
+	{
+		OutMode = EMCPTransactionMode::Batch;
+		return true;
+	}
+	return false;
+}
+
+uint64 FMCPTransactionScope::GetUndoBufferBytes()
+{
+#if WITH_EDITOR
+	if (const UTransBuffer* TransBuffer = GEditor ? Cast<UTransBuffer>(GEditor->Trans) : nullptr)
+	{
+		return TransBuffer->GetUndoSize();
+	}
+#endif
+	return 0;
+}
+
+uint64 FMCPTransactionScope::GetUndoBytes() const
+{
+	const uint64 UndoBytes = GetUndoBufferBytes();
+	return UndoBytes > UndoBytesAtStart ? UndoBytes - UndoBytesAtStart : 0;
+}
+
+void FMCPTransactionScope::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	OutJson->SetStringField(TEXT("mode"), Mode == EMCPTransactionMode::Batch ? TEXT("batch") : TEXT("none"));
+	OutJson->SetNumberField(TEXT("undo_bytes"), static_cast<double>(GetUndoBytes()));
+	OutJson->SetNumberField(TEXT("undo_buffer_bytes"), static_cast<double>(GetUndoBufferBytes()));
+}
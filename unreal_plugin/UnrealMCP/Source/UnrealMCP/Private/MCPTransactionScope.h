@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+class FScopedTransaction;
+class ITransaction;
+
+/** How an operation is recorded in the editor's undo buffer */
+enum class EMCPTransactionMode : uint8
+{
+	/** Nothing is recorded; Modify() calls made by the operation are not snapshotted */
+	None,
+	/** The whole operation is one undoable transaction */
+	Batch
+};
+
+/**
+ * Applies an EMCPTransactionMode for the lifetime of the scope and measures how much the undo
+ * buffer grew while it was open. Generated assets default to None, so long automated sessions do
+ * not fill the undo buffer with snapshots nobody will ever undo.
+ */
+class FMCPTransactionScope
+{
+public:
+	/**
+	 * @param InMode Transaction mode for the operation
+	 * @param Description Undo history entry for Batch mode
+	 */
+	FMCPTransactionScope(EMCPTransactionMode InMode, const FText& Description);
+	~FMCPTransactionScope();
+
+	/**
+	 * Parse a mode name ("none" or "batch")
+	 * @return True if the name was recognised
+	 */
+	static bool ParseMode(const FString& Name, EMCPTransactionMode& OutMode);
+
+	/** Current size of the editor's undo buffer in bytes, or 0 when there is none */
+	static uint64 GetUndoBufferBytes();
+
+	/** Undo buffer growth since the scope was opened */
+	uint64 GetUndoBytes() const;
+
+	/** Write the mode and undo buffer growth */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	EMCPTransactionMode Mode;
+	uint64 UndoBytesAtStart = 0;
+
+	/** Restores GUndo after None mode */
+	ITransaction* SavedUndo = nullptr;
+
+#if WITH_EDITOR
+	/** Open transaction in Batch mode */
+	TUniquePtr<FScopedTransaction> Transaction;
+#endif
+};
@@ -0,0 +1,580 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MCPWebSocketServer.h"
+#include "IUnrealMCP.h"
+#include "MCPHttpServer.h"
+#include "MCPMsgPack.h"
+#include "UnrealMCPSettings.h"
+#include "HttpServerRequest.h"
+#include "HttpPath.h"
+#include "IWebSocketNetworkingModule.h"
+#include "IWebSocketServer.h"
+#include "INetworkingWebSocket.h"
+#include "WebSocketNetworkingDelegates.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+	/** Bytes of the little-endian length in front of every message */
+	constexpr int32 LengthPrefixBytes = 4;
+
+	/** Response headers copied into the envelope, since a message has no headers of its own */
+	const TCHAR* const ForwardedHeaders[] = { TEXT("Retry-After"), TEXT("Idempotent-Replayed") };
+
+	/** JSON messages start with an object, possibly after whitespace; anything else is taken as MessagePack */
+	bool IsJsonMessage(const TArray<uint8>& Message)
+	{
+		for (const uint8 Byte : Message)
+		{
+			if (Byte != ' ' && Byte != '\t' && Byte != '\r' && Byte != '\n')
+			{
+				return Byte == '{';
+			}
+		}
+		return true;
+	}
+
+	FString SerializeCondensed(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Text;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Text;
+	}
+
+	void AppendUtf8(TArray<uint8>& Out, const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text, Text.Len());
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	/** Encode an object as JSON text or MessagePack */
+	void EncodeObject(const TSharedRef<FJsonObject>& Object, bool bMsgPack, TArray<uint8>& OutBytes)
+	{
+		if (bMsgPack)
+		{
+			FMCPMsgPack::Encode(Object, OutBytes);
+			return;
+		}
+		OutBytes.Reset();
+		AppendUtf8(OutBytes, SerializeCondensed(Object));
+	}
+
+	bool ParseJsonObject(const uint8* Data, int32 Num, TSharedPtr<FJsonObject>& OutObject)
+	{
+		const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Data), Num);
+		TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FString(Text.Length(), Text.Get()));
+		return FJsonSerializer::Deserialize(Reader, OutObject) && OutObject.IsValid();
+	}
+
+	/**
+	 * Whether a handshake's Origin header allows the connection
+	 * Clients outside a browser send none; a browser page is accepted only when it is served from this machine,
+	 * so a web page the user happens to visit cannot drive the editor
+	 */
+	bool IsLocalOrigin(const FString& Origin)
+	{
+		if (Origin.IsEmpty())
+		{
+			return true;
+		}
+
+		// scheme://host[:port][/...], with an IPv6 host in brackets
+		FString Host;
+		if (!Origin.Split(TEXT("://"), nullptr, &Host))
+		{
+			return false;
+		}
+		int32 End = INDEX_NONE;
+		if (Host.StartsWith(TEXT("[")))
+		{
+			Host = Host.FindChar(TEXT(']'), End) ? Host.Mid(1, End - 1) : FString();
+		}
+		else
+		{
+			if (Host.FindChar(TEXT('/'), End))
+			{
+				Host.LeftInline(End);
+			}
+			if (Host.FindChar(TEXT(':'), End))
+			{
+				Host.LeftInline(End);
+			}
+		}
+
+		return Host.Equals(TEXT("localhost"), ESearchCase::IgnoreCase) || Host == TEXT("127.0.0.1") || Host == TEXT("::1");
+	}
+
+	TSharedRef<FJsonObject> MakeError(const FString& Message)
+	{
+		TSharedRef<FJsonObject> Body = MakeShared<FJsonObject>();
+		Body->SetBoolField(TEXT("success"), false);
+		Body->SetStringField(TEXT("message"), Message);
+		return Body;
+	}
+}
+
+FMCPWebSocketServer::FMCPWebSocketServer(FMCPHttpServer& InHttpServer)
+	: HttpServer(InHttpServer)
+{
+}
+
+FMCPWebSocketServer::~FMCPWebSocketServer()
+{
+	Stop();
+}
+
+bool FMCPWebSocketServer::Start(uint32 InPort)
+{
+	Stop();
+
+	IWebSocketNetworkingModule* WebSocketModule = FModuleManager::LoadModulePtr<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking"));
+	if (!WebSocketModule)
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("WebSocketNetworking module is not available; WebSocket endpoint disabled"));
+		return false;
+	}
+
+	// Loopback only, like the health listener: the routes create and replace assets without authentication
+	Server = WebSocketModule->CreateServer();
+	if (Server.IsValid())
+	{
+		Server->SetFilterConnectionCallback(FWebSocketFilterConnectionCallback::CreateRaw(this, &FMCPWebSocketServer::OnFilterConnection));
+	}
+	if (!Server.IsValid() || !Server->Init(InPort, FWebSocketClientConnectedCallBack::CreateRaw(this, &FMCPWebSocketServer::OnClientConnected), TEXT("127.0.0.1")))
+	{
+		UE_LOG(LogUnrealMCP, Error, TEXT("Failed to start WebSocket server on port %d"), InPort);
+		Server.Reset();
+		return false;
+	}
+
+	// libwebsockets does its I/O and calls back only when serviced, so the server is ticked every frame
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPWebSocketServer::Tick));
+	Port = InPort;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("MCP WebSocket server started on 127.0.0.1:%d"), Port);
+	return true;
+}
+
+void FMCPWebSocketServer::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	for (const TPair<uint64, FConnection>& Pair : Connections)
+	{
+		if (!Pair.Value.SubscriberId.IsEmpty())
+		{
+			HttpServer.GetEventHub().Detach(Pair.Value.SubscriberId);
+		}
+	}
+
+	// Sockets close when deleted; they go before the server that services them
+	Connections.Empty();
+	if (Server.IsValid())
+	{
+		Server.Reset();
+		UE_LOG(LogUnrealMCP, Log, TEXT("MCP WebSocket server stopped"));
+	}
+	Port = 0;
+}
+
+EWebsocketConnectionFilterResult FMCPWebSocketServer::OnFilterConnection(FString Origin, FString ClientIP)
+{
+	if (IsLocalOrigin(Origin))
+	{
+		return EWebsocketConnectionFilterResult::ConnectionAccepted;
+	}
+
+	UE_LOG(LogUnrealMCP, Warning, TEXT("Refused WebSocket connection from %s with Origin '%s'"), *ClientIP, *Origin);
+	++RefusedConnections;
+	return EWebsocketConnectionFilterResult::ConnectionRefused;
+}
+
+void FMCPWebSocketServer::OnClientConnected(INetworkingWebSocket* Socket)
+{
+	const uint64 ConnectionId = NextConnectionId++;
+	Socket->SetReceiveCallBack(FWebSocketPacketReceivedCallBack::CreateRaw(this, &FMCPWebSocketServer::OnReceive, ConnectionId));
+	Socket->SetSocketClosedCallBack(FWebSocketInfoCallBack::CreateRaw(this, &FMCPWebSocketServer::OnClosed, ConnectionId));
+
+	FConnection& Connection = Connections.Add(ConnectionId);
+	Connection.Socket.Reset(Socket);
+	++AcceptedConnections;
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("WebSocket client %s connected (connection %llu)"), *Socket->RemoteEndPoint(true), ConnectionId);
+}
+
+void FMCPWebSocketServer::OnReceive(void* Data, int32 Size, uint64 ConnectionId)
+{
+	FConnection* Connection = Connections.Find(ConnectionId);
+	if (!Connection || Connection->bClosed)
+	{
+		return;
+	}
+
+	Connection->Pending.Append(static_cast<const uint8*>(Data), Size);
+
+	// Whole messages are consumed by advancing an offset; the consumed bytes are removed once at the end,
+	// so a chunk holding many small messages is not shifted down once per message
+	int32 ReadOffset = 0;
+	const int64 MaxMessageBytes = static_cast<int64>(GetDefault<UUnrealMCPSettings>()->MaxInflatedRequestMB) * 1024 * 1024;
+	while (Connection && !Connection->bClosed && Connection->Pending.Num() - ReadOffset >= LengthPrefixBytes)
+	{
+		const uint8* Prefix = Connection->Pending.GetData() + ReadOffset;
+		const uint32 Length = Prefix[0] | (Prefix[1] << 8) | (Prefix[2] << 16) | (static_cast<uint32>(Prefix[3]) << 24);
+		if (Length > MaxMessageBytes)
+		{
+			// Without a trustworthy length there is no way to find the next message
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Closing WebSocket connection %llu: message of %u bytes exceeds the %lld byte limit"), ConnectionId, Length, MaxMessageBytes);
+			++RejectedMessages;
+			Connection->Pending.Empty();
+			Connection->bClosed = true;
+			return;
+		}
+		if (Connection->Pending.Num() - ReadOffset - LengthPrefixBytes < static_cast<int64>(Length))
+		{
+			break;
+		}
+
+		const TArray<uint8> Message(Prefix + LengthPrefixBytes, static_cast<int32>(Length));
+		ReadOffset += LengthPrefixBytes + static_cast<int32>(Length);
+		HandleMessage(ConnectionId, Message);
+
+		Connection = Connections.Find(ConnectionId);
+	}
+
+	if (Connection && ReadOffset > 0)
+	{
+		Connection->Pending.RemoveAt(0, ReadOffset, EAllowShrinking::No);
+	}
+}
+
+void FMCPWebSocketServer::OnClosed(uint64 ConnectionId)
+{
+	if (FConnection* Connection = Connections.Find(ConnectionId))
+	{
+		Connection->bClosed = true;
+	}
+}
+
+bool FMCPWebSocketServer::Tick(float DeltaTime)
+{
+	if (!Server.IsValid())
+	{
+		return true;
+	}
+
+	Server->Tick();
+
+	// Sockets are deleted here rather than in their own callbacks, which run inside the server tick
+	for (auto It = Connections.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().bClosed)
+		{
+			continue;
+		}
+
+		if (!It.Value().SubscriberId.IsEmpty())
+		{
+			HttpServer.GetEventHub().Detach(It.Value().SubscriberId);
+		}
+		UE_LOG(LogUnrealMCP, Log, TEXT("WebSocket connection %llu closed"), It.Key());
+		It.RemoveCurrent();
+	}
+	return true;
+}
+
+void FMCPWebSocketServer::HandleMessage(uint64 ConnectionId, const TArray<uint8>& Message)
+{
+	++ReceivedMessages;
+
+	const bool bMsgPack = !IsJsonMessage(Message);
+	TSharedPtr<FJsonObject> Envelope;
+	const bool bParsed = bMsgPack ? FMCPMsgPack::Decode(Message, Envelope) : ParseJsonObject(Message.GetData(), Message.Num(), Envelope);
+
+	const TSharedPtr<FJsonValue> Id = bParsed ? Envelope->TryGetField(TEXT("id")) : nullptr;
+	const bool bValidId = Id.IsValid() && (Id->Type == EJson::String || Id->Type == EJson::Number);
+	FString Route;
+	if (!bValidId || !Envelope->TryGetStringField(TEXT("route"), Route) || !Route.StartsWith(TEXT("/")))
+	{
+		++RejectedMessages;
+		SendJson(ConnectionId, bValidId ? Id : nullptr, bMsgPack, EHttpServerResponseCodes::BadRequest,
+			MakeError(TEXT("Messages must be an object with a string or number \"id\" and a \"route\" such as \"/add_node\"")));
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* BodyObject = nullptr;
+	Envelope->TryGetObjectField(TEXT("body"), BodyObject);
+
+	if (Route == TEXT("/subscribe") || Route == TEXT("/unsubscribe"))
+	{
+		HandleSubscription(ConnectionId, Id, Route, BodyObject ? *BodyObject : nullptr, bMsgPack);
+		return;
+	}
+
+	// The message stands in for an HTTP request, so routes read the same headers they get over HTTP
+	const TCHAR* ContentType = bMsgPack ? FMCPMsgPack::ContentType : TEXT("application/json");
+	FHttpServerRequest Request;
+	Request.RelativePath = FHttpPath(Route);
+	Request.Headers.Add(TEXT("Content-Type"), { ContentType });
+	Request.Headers.Add(TEXT("Accept"), { ContentType });
+	Request.Headers.Add(TEXT("X-MCP-Request-Id"), { Id->AsString() });
+
+	double DeadlineMs = 0.0;
+	if (Envelope->TryGetNumberField(TEXT("deadline_ms"), DeadlineMs))
+	{
+		Request.Headers.Add(TEXT("X-MCP-Deadline-Ms"), { FString::Printf(TEXT("%lld"), static_cast<int64>(DeadlineMs)) });
+	}
+
+	FString IdempotencyKey;
+	if (Envelope->TryGetStringField(TEXT("idempotency_key"), IdempotencyKey))
+	{
+		Request.Headers.Add(TEXT("Idempotency-Key"), { IdempotencyKey });
+	}
+
+	const TSharedPtr<FJsonObject>* QueryObject = nullptr;
+	if (Envelope->TryGetObjectField(TEXT("query"), QueryObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*QueryObject)->Values)
+		{
+			FString Value;
+			if (Pair.Value.IsValid() && Pair.Value->TryGetString(Value))
+			{
+				Request.QueryParams.Add(Pair.Key, Value);
+			}
+		}
+	}
+
+	// Routes parse Request.Body themselves, so the body goes back out in the message's encoding
+	if (BodyObject && BodyObject->IsValid())
+	{
+		EncodeObject(BodyObject->ToSharedRef(), bMsgPack, Request.Body);
+	}
+
+	// Responses go out as each route completes, so a queued mutation does not hold back later reads
+	const FHttpResultCallback OnComplete = [this, ConnectionId, Id, bMsgPack](TUniquePtr<FHttpServerResponse>&& Response)
+	{
+		if (Response.IsValid())
+		{
+			SendResponse(ConnectionId, Id, bMsgPack, *Response);
+		}
+	};
+
+	if (!HttpServer.DispatchRequest(Request, OnComplete))
+	{
+		++RejectedMessages;
+		SendJson(ConnectionId, Id, bMsgPack, EHttpServerResponseCodes::NotFound, MakeError(FString::Printf(TEXT("Unknown route '%s'"), *Route)));
+	}
+}
+
+void FMCPWebSocketServer::HandleSubscription(uint64 ConnectionId, const TSharedPtr<FJsonValue>& Id, const FString& Route, const TSharedPtr<FJsonObject>& Body, bool bMsgPack)
+{
+	FConnection* Connection = Connections.Find(ConnectionId);
+	if (!Connection)
+	{
+		return;
+	}
+
+	FMCPEventHub& EventHub = HttpServer.GetEventHub();
+	if (Route == TEXT("/unsubscribe"))
+	{
+		if (!Connection->SubscriberId.IsEmpty())
+		{
+			EventHub.Detach(Connection->SubscriberId);
+			Connection->SubscriberId.Reset();
+		}
+
+		TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+		ResponseJson->SetBoolField(TEXT("success"), true);
+		SendJson(ConnectionId, Id, bMsgPack, EHttpServerResponseCodes::Ok, ResponseJson);
+		return;
+	}
+
+	FString Topics;
+	if (Body.IsValid())
+	{
+		Body->TryGetStringField(TEXT("topics"), Topics);
+	}
+
+	uint32 TopicMask = 0;
+	if (!FMCPEventHub::ParseTopics(Topics, TopicMask))
+	{
+		SendJson(ConnectionId, Id, bMsgPack, EHttpServerResponseCodes::BadRequest,
+			MakeError(FString::Printf(TEXT("Unknown topic in '%s'; expected job, compile or log"), *Topics)));
+		return;
+	}
+
+	const FString SubscriberId = FString::Printf(TEXT("ws-%llu"), ConnectionId);
+	const bool bAttached = EventHub.Attach(SubscriberId, TopicMask, [this, ConnectionId](const TArray<TSharedPtr<const FMCPEvent>>& Events, int64 Dropped)
+	{
+		PushEvents(ConnectionId, Events, Dropped);
+	});
+	if (!bAttached)
+	{
+		SendJson(ConnectionId, Id, bMsgPack, EHttpServerResponseCodes::ServiceUnavail,
+			MakeError(TEXT("Event subscriber limit reached; try again later")));
+		return;
+	}
+
+	Connection->SubscriberId = SubscriberId;
+
+	TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+	ResponseJson->SetBoolField(TEXT("success"), true);
+	ResponseJson->SetStringField(TEXT("subscriber"), SubscriberId);
+	SendJson(ConnectionId, Id, bMsgPack, EHttpServerResponseCodes::Ok, ResponseJson);
+}
+
+void FMCPWebSocketServer::SendResponse(uint64 ConnectionId, const TSharedPtr<FJsonValue>& Id, bool bMsgPack, const FHttpServerResponse& Response)
+{
+	TSharedRef<FJsonObject> Envelope = MakeShared<FJsonObject>();
+	Envelope->SetField(TEXT("id"), Id);
+	Envelope->SetNumberField(TEXT("status"), static_cast<int32>(Response.Code));
+
+	TSharedRef<FJsonObject> HeadersJson = MakeShared<FJsonObject>();
+	for (const TCHAR* HeaderName : ForwardedHeaders)
+	{
+		const TArray<FString>* Values = Response.Headers.Find(HeaderName);
+		if (Values && Values->Num() > 0)
+		{
+			HeadersJson->SetStringField(FString(HeaderName).ToLower(), (*Values)[0]);
+		}
+	}
+	if (HeadersJson->Values.Num() > 0)
+	{
+		Envelope->SetObjectField(TEXT("headers"), HeadersJson);
+	}
+
+	const TArray<FString>* ContentTypes = Response.Headers.Find(TEXT("Content-Type"));
+	const FString ContentType = ContentTypes && ContentTypes->Num() > 0 ? (*ContentTypes)[0] : FString();
+	const bool bJsonBody = ContentType.StartsWith(TEXT("application/json"));
+	const bool bMsgPackBody = ContentType.StartsWith(FMCPMsgPack::ContentType);
+
+	// A body already in the message's encoding is spliced into the envelope as is, rather than decoded and written again
+	TArray<uint8> Payload;
+	if (bJsonBody && !bMsgPack)
+	{
+		FString Head = SerializeCondensed(Envelope);
+		Head.LeftChopInline(1);
+		Head += TEXT(",\"body\":");
+		AppendUtf8(Payload, Head);
+		Payload.Append(Response.Body);
+		Payload.Add('}');
+	}
+	else if (bMsgPackBody && bMsgPack)
+	{
+		FMCPMsgPack::EncodeWithRawField(Envelope, TEXT("body"), Response.Body, Payload);
+	}
+	else
+	{
+		TSharedPtr<FJsonObject> BodyObject;
+		if (bJsonBody && ParseJsonObject(Response.Body.GetData(), Response.Body.Num(), BodyObject))
+		{
+			Envelope->SetObjectField(TEXT("body"), BodyObject);
+		}
+		else if (bMsgPackBody && FMCPMsgPack::Decode(Response.Body, BodyObject))
+		{
+			Envelope->SetObjectField(TEXT("body"), BodyObject);
+		}
+		else
+		{
+			// Line-oriented bodies such as /export_graph format=ndjson travel as text
+			const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Response.Body.GetData()), Response.Body.Num());
+			Envelope->SetStringField(TEXT("content_type"), ContentType);
+			Envelope->SetStringField(TEXT("text"), FString(Text.Length(), Text.Get()));
+		}
+		EncodeObject(Envelope, bMsgPack, Payload);
+	}
+
+	if (SendMessage(ConnectionId, Payload))
+	{
+		++SentResponses;
+	}
+	else
+	{
+		// The client disconnected while its request was queued or running
+		++DroppedResponses;
+	}
+}
+
+void FMCPWebSocketServer::SendJson(uint64 ConnectionId, const TSharedPtr<FJsonValue>& Id, bool bMsgPack, EHttpServerResponseCodes Code, const TSharedRef<FJsonObject>& Body)
+{
+	TSharedRef<FJsonObject> Envelope = MakeShared<FJsonObject>();
+	Envelope->SetField(TEXT("id"), Id.IsValid() ? Id : MakeShared<FJsonValueNull>());
+	Envelope->SetNumberField(TEXT("status"), static_cast<int32>(Code));
+	Envelope->SetObjectField(TEXT("body"), Body);
+
+	TArray<uint8> Payload;
+	EncodeObject(Envelope, bMsgPack, Payload);
+	if (SendMessage(ConnectionId, Payload))
+	{
+		++SentResponses;
+	}
+	else
+	{
+		++DroppedResponses;
+	}
+}
+
+void FMCPWebSocketServer::PushEvents(uint64 ConnectionId, const TArray<TSharedPtr<const FMCPEvent>>& Events, int64 Dropped)
+{
+	// Pushes have no "id", which is how clients tell them from responses; event data is already JSON text
+	TArray<uint8> Payload;
+	if (Dropped > 0)
+	{
+		AppendUtf8(Payload, FString::Printf(TEXT("{\"event\":\"dropped\",\"dropped\":%lld}"), Dropped));
+		SendMessage(ConnectionId, Payload);
+	}
+
+	for (const TSharedPtr<const FMCPEvent>& Event : Events)
+	{
+		Payload.Reset();
+		AppendUtf8(Payload, FString::Printf(TEXT("{\"event\":\"%s\",\"event_id\":%llu,\"data\":"), FMCPEventHub::GetTopicName(Event->Topic), Event->Id));
+		AppendUtf8(Payload, Event->Data);
+		Payload.Add('}');
+		if (!SendMessage(ConnectionId, Payload))
+		{
+			return;
+		}
+		++PushedEvents;
+	}
+}
+
+bool FMCPWebSocketServer::SendMessage(uint64 ConnectionId, const TArray<uint8>& Payload)
+{
+	FConnection* Connection = Connections.Find(ConnectionId);
+	if (!Connection || Connection->bClosed)
+	{
+		return false;
+	}
+
+	// bPrependSize writes the 4-byte little-endian length clients split messages on
+	return Connection->Socket->Send(Payload.GetData(), Payload.Num(), true);
+}
+
+void FMCPWebSocketServer::WriteStats(const TSharedRef<FJsonObject>& OutJson) const
+{
+	int32 Subscribed = 0;
+	for (const TPair<uint64, FConnection>& Pair : Connections)
+	{
+		Subscribed += Pair.Value.SubscriberId.IsEmpty() ? 0 : 1;
+	}
+
+	OutJson->SetNumberField(TEXT("port"), Port);
+	OutJson->SetNumberField(TEXT("connections"), Connections.Num());
+	OutJson->SetNumberField(TEXT("subscribed"), Subscribed);
+	OutJson->SetNumberField(TEXT("accepted"), static_cast<double>(AcceptedConnections));
+	OutJson->SetNumberField(TEXT("refused"), static_cast<double>(RefusedConnections));
+	OutJson->SetNumberField(TEXT("messages"), static_cast<double>(ReceivedMessages));
+	OutJson->SetNumberField(TEXT("rejected"), static_cast<double>(RejectedMessages));
+	OutJson->SetNumberField(TEXT("responses"), static_cast<double>(SentResponses));
+	OutJson->SetNumberField(TEXT("dropped_responses"), static_cast<double>(DroppedResponses));
+	OutJson->SetNumberField(TEXT("pushed_events"), static_cast<double>(PushedEvents));
+}
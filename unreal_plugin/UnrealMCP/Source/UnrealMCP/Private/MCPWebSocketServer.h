@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HttpServerResponse.h"
+#include "MCPEventHub.h"
+#include "WebSocketNetworkingDelegates.h"
+
+class FJsonObject;
+class FJsonValue;
+class FMCPHttpServer;
+class INetworkingWebSocket;
+class IWebSocketServer;
+
+/**
+ * Persistent WebSocket transport for the same routes as the HTTP server, on its own port
+ * Each message carries a client-chosen "id" that is echoed in its response, so many requests share one
+ * connection and complete in any order: reads answer at once while mutations wait in the job queue.
+ * "/subscribe" attaches the connection to FMCPEventHub, which then pushes events without polling.
+ *
+ * Messages are binary, prefixed with a 4-byte little-endian length like INetworkingWebSocket::Send with
+ * bPrependSize, because libwebsockets may hand a large message to the receive callback in pieces.
+ * The payload is JSON text or MessagePack, told apart by its first byte; responses use the request's encoding.
+ * Listens on loopback only and refuses browser handshakes whose Origin is not this machine.
+ * Game thread only.
+ */
+class FMCPWebSocketServer
+{
+public:
+	explicit FMCPWebSocketServer(FMCPHttpServer& InHttpServer);
+	~FMCPWebSocketServer();
+
+	/**
+	 * Start listening
+	 * @param Port The port to listen on
+	 * @return True if the server is accepting connections
+	 */
+	bool Start(uint32 Port);
+
+	/** Close every connection and stop listening */
+	void Stop();
+
+	/** Port being listened on, or 0 if stopped */
+	uint32 GetPort() const { return Port; }
+
+	/** Write connection, message and push counters */
+	void WriteStats(const TSharedRef<FJsonObject>& OutJson) const;
+
+private:
+	/** One client connection */
+	struct FConnection
+	{
+		TUniquePtr<INetworkingWebSocket> Socket;
+
+		/** Received bytes not yet forming a whole message */
+		TArray<uint8> Pending;
+
+		/** Event hub subscriber ID while subscribed */
+		FString SubscriberId;
+
+		/** Set by the closed callback; the connection is deleted after the server tick that reported it */
+		bool bClosed = false;
+	};
+
+	/** Refuse a handshake whose Origin header names another host (server tick) */
+	EWebsocketConnectionFilterResult OnFilterConnection(FString Origin, FString ClientIP);
+
+	/** Accept a new connection (server tick) */
+	void OnClientConnected(INetworkingWebSocket* Socket);
+
+	/** Buffer received bytes and handle every whole message in them (server tick) */
+	void OnReceive(void* Data, int32 Size, uint64 ConnectionId);
+
+	/** Mark a connection for deletion (server tick) */
+	void OnClosed(uint64 ConnectionId);
+
+	/**
+	 * Service the WebSocket server and delete closed connections
+	 * @return True to keep ticking
+	 */
+	bool Tick(float DeltaTime);
+
+	/** Decode one message and dispatch it to its route */
+	void HandleMessage(uint64 ConnectionId, const TArray<uint8>& Message);
+
+	/** Handle "/subscribe" and "/unsubscribe"; the body of /subscribe may list "topics" like /events */
+	void HandleSubscription(uint64 ConnectionId, const TSharedPtr<FJsonValue>& Id, const FString& Route, const TSharedPtr<FJsonObject>& Body, bool bMsgPack);
+
+	/** Send a route's response in an envelope carrying the request ID */
+	void SendResponse(uint64 ConnectionId, const TSharedPtr<FJsonValue>& Id, bool bMsgPack, const FHttpServerResponse& Response);
+
+	/** Send a JSON body built here, e.g. an error for a message that never reached a route */
+	void SendJson(uint64 ConnectionId, const TSharedPtr<FJsonValue>& Id, bool bMsgPack, EHttpServerResponseCodes Code, const TSharedRef<FJsonObject>& Body);
+
+	/** Push events to a subscribed connection, one message per event */
+	void PushEvents(uint64 ConnectionId, const TArray<TSharedPtr<const FMCPEvent>>& Events, int64 Dropped);
+
+	/**
+	 * Send one length-prefixed message
+	 * @return False if the connection is gone or closing
+	 */
+	bool SendMessage(uint64 ConnectionId, const TArray<uint8>& Payload);
+
+	/** Owns the routes messages are dispatched to, and the event hub */
+	FMCPHttpServer& HttpServer;
+
+	TUniquePtr<IWebSocketServer> Server;
+	FTSTicker::FDelegateHandle TickerHandle;
+	uint32 Port = 0;
+
+	TMap<uint64, FConnection> Connections;
+	uint64 NextConnectionId = 1;
+
+	/** Counters */
+	int64 AcceptedConnections = 0;
+	int64 RefusedConnections = 0;
+	int64 ReceivedMessages = 0;
+	int64 RejectedMessages = 0;
+	int64 SentResponses = 0;
+	int64 DroppedResponses = 0;
+	int64 PushedEvents = 0;
+};
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "MCPIdempotencyCache.h"
+#include "MCPMsgPack.h"
+#include "UnrealMCPSettings.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace MCPIdempotencyTest
+{
+	TSharedPtr<FJsonObject> Parse(const FString& Text)
+	{
+		TSharedPtr<FJsonObject> Object;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		FJsonSerializer::Deserialize(Reader, Object);
+		return Object;
+	}
+
+	/** What FMCPWebSocketServer puts in Request.Body for a JSON message: the envelope's body, condensed */
+	TSharedPtr<FJsonObject> RoundTripCondensed(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Text;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Text);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Parse(Text);
+	}
+
+	/** The same for a MessagePack message */
+	TSharedPtr<FJsonObject> RoundTripMsgPack(const TSharedRef<FJsonObject>& Object)
+	{
+		TArray<uint8> Bytes;
+		FMCPMsgPack::Encode(Object, Bytes);
+		TSharedPtr<FJsonObject> Decoded;
+		FMCPMsgPack::Decode(Bytes, Decoded);
+		return Decoded;
+	}
+}
+
+/**
+ * The Python bridge sends a request over WebSocket and, if the connection drops, retries it over HTTP
+ * with the same Idempotency-Key. The retry must replay the result rather than be rejected as a different body.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCPIdempotencyTransportTest, "UnrealMCP.Idempotency.TransportFallback", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPIdempotencyTransportTest::RunTest(const FString& Parameters)
+{
+	using namespace MCPIdempotencyTest;
+
+	// json.dumps output: spaces after separators, keys in the caller's order
+	const TSharedPtr<FJsonObject> HttpBody = Parse(TEXT("{\"node_type\": \"PrintString\", \"blueprint_path\": \"/Game/BP_Retry\", \"force\": false, \"count\": 3, \"tags\": [\"a\", 1.5]}"));
+	const TSharedPtr<FJsonObject> ReorderedBody = Parse(TEXT("{\"tags\":[\"a\",1.5],\"count\":3.0,\"force\":false,\"blueprint_path\":\"/Game/BP_Retry\",\"node_type\":\"PrintString\"}"));
+	const TSharedPtr<FJsonObject> OtherBody = Parse(TEXT("{\"node_type\": \"PrintString\", \"blueprint_path\": \"/Game/BP_Other\", \"force\": false, \"count\": 3, \"tags\": [\"a\", 1.5]}"));
+	if (!TestTrue(TEXT("Bodies parse"), HttpBody.IsValid() && ReorderedBody.IsValid() && OtherBody.IsValid()))
+	{
+		return false;
+	}
+
+	const uint32 HttpHash = FMCPIdempotencyCache::HashBody(HttpBody);
+	TestTrue(TEXT("WebSocket JSON body hashes like the HTTP body"), FMCPIdempotencyCache::HashBody(RoundTripCondensed(HttpBody.ToSharedRef())) == HttpHash);
+	TestTrue(TEXT("WebSocket MessagePack body hashes like the HTTP body"), FMCPIdempotencyCache::HashBody(RoundTripMsgPack(HttpBody.ToSharedRef())) == HttpHash);
+	TestTrue(TEXT("Key order and number spelling do not change the hash"), FMCPIdempotencyCache::HashBody(ReorderedBody) == HttpHash);
+	TestTrue(TEXT("A different body hashes differently"), FMCPIdempotencyCache::HashBody(OtherBody) != HttpHash);
+
+	if (GetDefault<UUnrealMCPSettings>()->IdempotencyCacheSize <= 0)
+	{
+		AddWarning(TEXT("Idempotency Cache Size is 0; skipping the replay check"));
+		return true;
+	}
+
+	// The WebSocket request runs first; the HTTP retry with the same key replays its result
+	FMCPIdempotencyCache Cache;
+	const FString Key = TEXT("/add_node retry-key");
+
+	EMCPIdempotencyLookup Lookup = EMCPIdempotencyLookup::Miss;
+	const TSharedPtr<FMCPIdempotencyEntry> Entry = Cache.Begin(Key, FMCPIdempotencyCache::HashBody(RoundTripMsgPack(HttpBody.ToSharedRef())), Lookup);
+	if (!TestTrue(TEXT("WebSocket request registers the key"), Entry.IsValid() && Lookup == EMCPIdempotencyLookup::Miss))
+	{
+		return false;
+	}
+
+	FMCPOperationResult Result;
+	Result.Json = MakeShared<FJsonObject>();
+	Result.Json->SetBoolField(TEXT("success"), true);
+	Cache.Complete(Key, Entry, Result, true);
+
+	const TSharedPtr<FMCPIdempotencyEntry> Replayed = Cache.Begin(Key, HttpHash, Lookup);
+	TestTrue(TEXT("HTTP retry replays instead of mismatching"), Lookup == EMCPIdempotencyLookup::Completed);
+	TestTrue(TEXT("HTTP retry gets the WebSocket request's result"), Replayed.IsValid() && Replayed->Result.Json == Result.Json);
+
+	Cache.Begin(Key, FMCPIdempotencyCache::HashBody(OtherBody), Lookup);
+	TestTrue(TEXT("The key reused for another body is rejected"), Lookup == EMCPIdempotencyLookup::Mismatch);
+	return true;
+}
+
+#endif
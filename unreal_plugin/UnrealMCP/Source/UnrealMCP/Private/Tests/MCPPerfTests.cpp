@@ -0,0 +1,705 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "MCPBlueprintUtils.h"
+#include "MCPAssetNotifier.h"
+#include "MCPMsgPack.h"
+#include "MCPCompression.h"
+#include "MCPEventHub.h"
+#include "MCPHttpServer.h"
+#include "UnrealMCPEditorSubsystem.h"
+#include "HttpServerResponse.h"
+#include "UnrealMCPSettings.h"
+#include "IUnrealMCP.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Interfaces/IPluginManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace MCPPerf
+{
+	/** Package root for everything a perf test creates; /Temp is never cooked or indexed as project content */
+	const TCHAR* PackageRoot = TEXT("/Temp/UnrealMCP/Perf");
+
+	/** Blueprints created between garbage collections, outside the timed region */
+	constexpr int32 ReleaseInterval = 250;
+
+	const TCHAR* OperationNames[] = {
+		TEXT("CreateBlueprint"),
+		TEXT("SpawnNode"),
+		TEXT("Compile"),
+		TEXT("CompileDiagnostics"),
+		TEXT("Save"),
+		TEXT("RegistryNotify"),
+		TEXT("RegistryNotifyBatched"),
+		TEXT("JsonParse"),
+		TEXT("JsonSerialize"),
+		TEXT("BatchJsonParse"),
+		TEXT("BatchMsgPackParse"),
+		TEXT("BatchJsonSerialize"),
+		TEXT("BatchMsgPackSerialize"),
+		TEXT("GzipCompress"),
+		TEXT("GzipInflate"),
+		TEXT("EventPublish"),
+		TEXT("RequestLog"),
+	};
+
+	const int32 IterationCounts[] = { 1, 100, 10000 };
+
+	/** Per-iteration timings of one run */
+	struct FSamples
+	{
+		TArray<double> Seconds;
+
+		/** Run Fn once and record its duration */
+		template <typename FunctorType>
+		void Time(FunctorType&& Fn)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Fn();
+			Seconds.Add(FPlatformTime::Seconds() - StartTime);
+		}
+
+		double MeanMs() const
+		{
+			double Total = 0.0;
+			for (double Value : Seconds)
+			{
+				Total += Value;
+			}
+			return Seconds.Num() > 0 ? Total * 1000.0 / Seconds.Num() : 0.0;
+		}
+
+		double PercentileMs(double Fraction) const
+		{
+			if (Seconds.Num() == 0)
+			{
+				return 0.0;
+			}
+			TArray<double> Sorted = Seconds;
+			Sorted.Sort();
+			const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+			return Sorted[Index] * 1000.0;
+		}
+	};
+
+	/**
+	 * Packages created by a test, released in bulk so garbage collection stays out of the timings
+	 */
+	class FTransientAssets
+	{
+	public:
+		~FTransientAssets()
+		{
+			Release();
+		}
+
+		UPackage* NewPackage(const FString& AssetName)
+		{
+			UPackage* Package = CreatePackage(*FString::Printf(TEXT("%s/%s"), PackageRoot, *AssetName));
+			Packages.Add(Package);
+			return Package;
+		}
+
+		/** Build and compile a PrintString Blueprint as /add_node does; null unless it compiled */
+		UBlueprint* NewBlueprint(const FString& AssetName)
+		{
+			TSharedRef<FJsonObject> CompileJson = MakeShared<FJsonObject>();
+			bool bCompiled = false;
+			UBlueprint* Blueprint = FMCPBlueprintUtils::BuildAndCompileActorBlueprint(NewPackage(AssetName), AssetName, { TEXT("PrintString") }, CompileJson, bCompiled);
+			return bCompiled ? Blueprint : nullptr;
+		}
+
+		/** Release everything created so far and delete any saved package files */
+		void Release()
+		{
+			for (const TWeakObjectPtr<UPackage>& WeakPackage : Packages)
+			{
+				UPackage* Package = WeakPackage.Get();
+				if (!Package)
+				{
+					continue;
+				}
+
+				const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+				IFileManager::Get().Delete(*Filename, false, true, true);
+
+				ForEachObjectWithPackage(Package, [](UObject* Object)
+				{
+					Object->ClearFlags(RF_Public | RF_Standalone);
+					Object->MarkAsGarbage();
+					return true;
+				});
+				Package->ClearFlags(RF_Standalone);
+				Package->MarkAsGarbage();
+			}
+
+			if (Packages.Num() > 0)
+			{
+				Packages.Reset();
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+		}
+
+		/** Release once every ReleaseInterval iterations */
+		void ReleaseEvery(int32 Iteration)
+		{
+			if ((Iteration + 1) % ReleaseInterval == 0)
+			{
+				Release();
+			}
+		}
+
+	private:
+		TArray<TWeakObjectPtr<UPackage>> Packages;
+	};
+
+	/** An /add_node body as sent by the Python bridge */
+	const TCHAR* AddNodePayload = TEXT("{\"blueprint_path\": \"/Game/Generated/BP_PerfActor_0042\", \"node_type\": \"PrintString\"}");
+
+	/** A /stamp body with an explicit path list */
+	FString MakeStampPayload()
+	{
+		FString Paths;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			Paths += FString::Printf(TEXT("%s\"/Game/Generated/BP_Stamped_%d\""), Index > 0 ? TEXT(", ") : TEXT(""), Index);
+		}
+		return FString::Printf(TEXT("{\"template\": \"PrintStringActor\", \"node_types\": [\"PrintString\"], \"paths\": [%s]}"), *Paths);
+	}
+
+	/** A /stamp response for 100 created assets, the largest body a batch client routinely receives */
+	TSharedRef<FJsonObject> MakeStampResponse()
+	{
+		TArray<TSharedPtr<FJsonValue>> CreatedValues;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			CreatedValues.Add(MakeShareable(new FJsonValueString(FString::Printf(TEXT("/Game/Generated/BP_Stamped_%d"), Index))));
+		}
+
+		TSharedRef<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+		ResponseJson->SetBoolField(TEXT("success"), true);
+		ResponseJson->SetStringField(TEXT("message"), TEXT("Stamped 100 of 100 asset(s) from template 'PrintStringActor' (0 unchanged)"));
+		ResponseJson->SetStringField(TEXT("template"), TEXT("PrintStringActor"));
+		ResponseJson->SetArrayField(TEXT("created"), CreatedValues);
+		ResponseJson->SetArrayField(TEXT("unchanged"), TArray<TSharedPtr<FJsonValue>>());
+		ResponseJson->SetArrayField(TEXT("failed"), TArray<TSharedPtr<FJsonValue>>());
+		ResponseJson->SetNumberField(TEXT("skipped"), 0);
+		ResponseJson->SetNumberField(TEXT("template_build_ms"), 212.75);
+		ResponseJson->SetNumberField(TEXT("elapsed_ms"), 1840.5);
+		ResponseJson->SetNumberField(TEXT("job_id"), 4711);
+		return ResponseJson;
+	}
+
+	/**
+	 * Load the checked-in thresholds from the plugin's Config/PerfBaselines.json
+	 * @return The "operations" object, or nullptr if the file is missing or invalid
+	 */
+	TSharedPtr<FJsonObject> LoadBaselines(double& OutTolerance)
+	{
+		OutTolerance = 1.0;
+
+		TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealMCP"));
+		if (!Plugin.IsValid())
+		{
+			return nullptr;
+		}
+
+		FString BaselineString;
+		const FString BaselinePath = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Config"), TEXT("PerfBaselines.json"));
+		if (!FFileHelper::LoadFileToString(BaselineString, *BaselinePath))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> BaselineJson;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BaselineString);
+		if (!FJsonSerializer::Deserialize(Reader, BaselineJson) || !BaselineJson.IsValid())
+		{
+			return nullptr;
+		}
+
+		BaselineJson->TryGetNumberField(TEXT("tolerance"), OutTolerance);
+
+		// Slower machines can widen every threshold without editing the baselines
+		FParse::Value(FCommandLine::Get(), TEXT("MCPPerfTolerance="), OutTolerance);
+
+		const TSharedPtr<FJsonObject>* Operations = nullptr;
+		return BaselineJson->TryGetObjectField(TEXT("operations"), Operations) ? *Operations : nullptr;
+	}
+
+	/**
+	 * Run one operation for the given number of iterations
+	 * @return False if the operation itself failed
+	 */
+	bool RunOperation(const FString& Operation, int32 Iterations, FSamples& Samples, FAutomationTestBase& Test)
+	{
+		FTransientAssets Assets;
+
+		if (Operation == TEXT("CreateBlueprint"))
+		{
+			// Same work as FMCPOperationRunner::CreateBlueprintWithPrintString, minus the save: build and one diagnostic compile
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				UBlueprint* Blueprint = nullptr;
+				const FString AssetName = FString::Printf(TEXT("BP_PerfCreate_%d"), Index);
+				Samples.Time([&]() { Blueprint = Assets.NewBlueprint(AssetName); });
+				if (!Blueprint)
+				{
+					return false;
+				}
+				Assets.ReleaseEvery(Index);
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("SpawnNode"))
+		{
+			UEdGraph* EventGraph = nullptr;
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				if (Index % ReleaseInterval == 0)
+				{
+					Assets.Release();
+					UBlueprint* Blueprint = Assets.NewBlueprint(FString::Printf(TEXT("BP_PerfSpawn_%d"), Index));
+					EventGraph = Blueprint ? FBlueprintEditorUtils::FindEventGraph(Blueprint) : nullptr;
+					if (!EventGraph)
+					{
+						return false;
+					}
+				}
+
+				UEdGraphNode* Node = nullptr;
+				Samples.Time([&]() { Node = FMCPBlueprintUtils::SpawnNode(EventGraph, TEXT("PrintString"), 200, 200 + (Index % ReleaseInterval) * 150); });
+				if (!Node)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("Compile"))
+		{
+			UBlueprint* Blueprint = nullptr;
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				if (Index % ReleaseInterval == 0)
+				{
+					Assets.Release();
+					Blueprint = Assets.NewBlueprint(FString::Printf(TEXT("BP_PerfCompile_%d"), Index));
+					if (!Blueprint)
+					{
+						return false;
+					}
+				}
+
+				FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+				Samples.Time([&]() { FKismetEditorUtilities::CompileBlueprint(Blueprint); });
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("CompileDiagnostics"))
+		{
+			// Compile as /add_node does, with a silent results log turned into JSON diagnostics;
+			// compare with Compile for the cost of collecting them
+			UBlueprint* Blueprint = nullptr;
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				if (Index % ReleaseInterval == 0)
+				{
+					Assets.Release();
+					Blueprint = Assets.NewBlueprint(FString::Printf(TEXT("BP_PerfDiagnostics_%d"), Index));
+					if (!Blueprint)
+					{
+						return false;
+					}
+				}
+
+				FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+				bool bCompiled = false;
+				Samples.Time([&]()
+				{
+					TSharedRef<FJsonObject> CompileJson = MakeShared<FJsonObject>();
+					bCompiled = FMCPBlueprintUtils::CompileBlueprint(Blueprint, CompileJson);
+				});
+				if (!bCompiled)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("Save"))
+		{
+			Test.AddExpectedMessage(TEXT("Package path conversion"), EAutomationExpectedMessageFlags::Contains, 0);
+
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				UBlueprint* Blueprint = Assets.NewBlueprint(FString::Printf(TEXT("BP_PerfSave_%d"), Index));
+				if (!Blueprint)
+				{
+					return false;
+				}
+
+				bool bSaved = false;
+				Samples.Time([&]() { bSaved = FMCPBlueprintUtils::SaveBlueprintPackage(Blueprint->GetOutermost(), Blueprint); });
+				if (!bSaved)
+				{
+					return false;
+				}
+				Assets.ReleaseEvery(Index);
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("RegistryNotify") || Operation == TEXT("RegistryNotifyBatched"))
+		{
+			// Per-asset cost of the registry notification, sent immediately or held for one pass at the end of a batch
+			const bool bBatched = Operation == TEXT("RegistryNotifyBatched");
+			FMCPAssetNotifier Notifier;
+			for (int32 BatchStart = 0; BatchStart < Iterations; BatchStart += ReleaseInterval)
+			{
+				TArray<UBlueprint*> Blueprints;
+				for (int32 Index = BatchStart; Index < FMath::Min(BatchStart + ReleaseInterval, Iterations); ++Index)
+				{
+					UBlueprint* Blueprint = Assets.NewBlueprint(FString::Printf(TEXT("BP_PerfNotify_%d"), Index));
+					if (!Blueprint)
+					{
+						return false;
+					}
+					Blueprints.Add(Blueprint);
+				}
+
+				const int32 FirstSample = Samples.Seconds.Num();
+				if (bBatched)
+				{
+					Notifier.BeginBatch();
+				}
+				for (UBlueprint* Blueprint : Blueprints)
+				{
+					Samples.Time([&]() { Notifier.NotifyAssetCreated(Blueprint); });
+				}
+				if (bBatched)
+				{
+					// The flush is spread over the assets it announced
+					const double FlushStartTime = FPlatformTime::Seconds();
+					Notifier.EndBatch();
+					const double FlushShare = (FPlatformTime::Seconds() - FlushStartTime) / Blueprints.Num();
+					for (int32 Sample = FirstSample; Sample < Samples.Seconds.Num(); ++Sample)
+					{
+						Samples.Seconds[Sample] += FlushShare;
+					}
+				}
+
+				// Keep released assets out of the registry for the next batch
+				for (UBlueprint* Blueprint : Blueprints)
+				{
+					FAssetRegistryModule::AssetDeleted(Blueprint);
+				}
+				Assets.Release();
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("JsonParse"))
+		{
+			const FString StampPayload = MakeStampPayload();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				bool bParsed = false;
+				Samples.Time([&]()
+				{
+					TSharedPtr<FJsonObject> AddNodeJson;
+					TSharedPtr<FJsonObject> StampJson;
+					TSharedRef<TJsonReader<>> AddNodeReader = TJsonReaderFactory<>::Create(AddNodePayload);
+					TSharedRef<TJsonReader<>> StampReader = TJsonReaderFactory<>::Create(StampPayload);
+					bParsed = FJsonSerializer::Deserialize(AddNodeReader, AddNodeJson) && FJsonSerializer::Deserialize(StampReader, StampJson);
+				});
+				if (!bParsed)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("JsonSerialize"))
+		{
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				Samples.Time([&]()
+				{
+					// Mirrors the /add_node response
+					TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
+					ResponseJson->SetBoolField(TEXT("success"), true);
+					ResponseJson->SetStringField(TEXT("message"), TEXT("Blueprint created with PrintString node at '/Game/Generated/BP_PerfActor_0042'"));
+					ResponseJson->SetStringField(TEXT("blueprint_path"), TEXT("/Game/Generated/BP_PerfActor_0042"));
+					ResponseJson->SetStringField(TEXT("node_type"), TEXT("PrintString"));
+
+					FString ResponseString;
+					TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
+					FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
+				});
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("BatchJsonParse") || Operation == TEXT("BatchMsgPackParse"))
+		{
+			// The /stamp body as it arrives on the wire, decoded the way FMCPHttpServer::ParseJsonBody does
+			const bool bMsgPack = Operation == TEXT("BatchMsgPackParse");
+			TArray<uint8> Body;
+			if (bMsgPack)
+			{
+				TSharedPtr<FJsonObject> StampJson;
+				TSharedRef<TJsonReader<>> StampReader = TJsonReaderFactory<>::Create(MakeStampPayload());
+				if (!FJsonSerializer::Deserialize(StampReader, StampJson) || !StampJson.IsValid())
+				{
+					return false;
+				}
+				FMCPMsgPack::Encode(StampJson.ToSharedRef(), Body);
+			}
+			else
+			{
+				FTCHARToUTF8 Utf8Payload(*MakeStampPayload());
+				Body.Append(reinterpret_cast<const uint8*>(Utf8Payload.Get()), Utf8Payload.Length());
+			}
+
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				bool bParsed = false;
+				Samples.Time([&]()
+				{
+					TSharedPtr<FJsonObject> StampJson;
+					if (bMsgPack)
+					{
+						bParsed = FMCPMsgPack::Decode(Body, StampJson);
+						return;
+					}
+
+					TArray<uint8> NullTerminatedBody = Body;
+					NullTerminatedBody.Add(0);
+					TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(FUTF8ToTCHAR(reinterpret_cast<const char*>(NullTerminatedBody.GetData()))));
+					bParsed = FJsonSerializer::Deserialize(Reader, StampJson) && StampJson.IsValid();
+				});
+				if (!bParsed)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("BatchJsonSerialize") || Operation == TEXT("BatchMsgPackSerialize"))
+		{
+			// The /stamp response down to wire bytes, as FMCPHttpServer::MakeJsonResponse produces them
+			const bool bMsgPack = Operation == TEXT("BatchMsgPackSerialize");
+			const TSharedRef<FJsonObject> ResponseJson = MakeStampResponse();
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				Samples.Time([&]()
+				{
+					TArray<uint8> ResponseBytes;
+					if (bMsgPack)
+					{
+						FMCPMsgPack::Encode(ResponseJson, ResponseBytes);
+						return;
+					}
+
+					FString ResponseString;
+					TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
+					FJsonSerializer::Serialize(ResponseJson, Writer);
+					FTCHARToUTF8 Utf8Response(*ResponseString);
+					ResponseBytes.Append(reinterpret_cast<const uint8*>(Utf8Response.Get()), Utf8Response.Length());
+				});
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("GzipCompress") || Operation == TEXT("GzipInflate"))
+		{
+			// The /stamp response through the worker-thread compression in FMCPHttpServer::WithResponseCompression,
+			// and a compressed body back through FMCPHttpServer::DecodeRequestBody, at the configured level
+			FString ResponseString;
+			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseString);
+			FJsonSerializer::Serialize(MakeStampResponse(), Writer);
+			FTCHARToUTF8 Utf8Response(*ResponseString);
+			const TArray<uint8> ResponseBytes(reinterpret_cast<const uint8*>(Utf8Response.Get()), Utf8Response.Length());
+
+			const int32 Level = GetDefault<UUnrealMCPSettings>()->CompressionLevel;
+			TArray<uint8> CompressedBytes;
+			if (!FMCPCompression::Compress(EMCPContentCoding::Gzip, ResponseBytes, Level, CompressedBytes))
+			{
+				return false;
+			}
+
+			const bool bInflate = Operation == TEXT("GzipInflate");
+			bool bSucceeded = true;
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				Samples.Time([&]()
+				{
+					TArray<uint8> OutBytes;
+					bSucceeded &= bInflate
+						? FMCPCompression::Decompress(CompressedBytes, ResponseBytes.Num(), OutBytes) && OutBytes == ResponseBytes
+						: FMCPCompression::Compress(EMCPContentCoding::Gzip, ResponseBytes, Level, OutBytes);
+				});
+			}
+			return bSucceeded;
+		}
+
+		if (Operation == TEXT("EventPublish"))
+		{
+			// A job event fanned out to a full set of /events subscribers, as FMCPHttpServer::PublishJobEvent does
+			// Nobody reads during the run, so once buffers fill every publish also drops the oldest event per subscriber
+			FMCPEventHub EventHub;
+			const int32 SubscriberCount = GetDefault<UUnrealMCPSettings>()->MaxEventSubscribers;
+			for (int32 Index = 0; Index < SubscriberCount; ++Index)
+			{
+				EventHub.Poll(FString::Printf(TEXT("perf-%d"), Index), 0, MAX_uint32, 0.0, EMCPEventFormat::Json, [](TUniquePtr<FHttpServerResponse>&&) {});
+			}
+
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				Samples.Time([&]()
+				{
+					TSharedRef<FJsonObject> EventJson = MakeShared<FJsonObject>();
+					EventJson->SetNumberField(TEXT("job_id"), Index + 1);
+					EventJson->SetStringField(TEXT("route"), TEXT("/add_node"));
+					EventJson->SetStringField(TEXT("state"), TEXT("completed"));
+					EventJson->SetNumberField(TEXT("code"), 200);
+					EventJson->SetBoolField(TEXT("success"), true);
+					EventJson->SetStringField(TEXT("message"), TEXT("Blueprint created with PrintString node at '/Game/Generated/BP_PerfActor_0042'"));
+					EventHub.Publish(EMCPEventTopic::Job, EventJson);
+				});
+			}
+			return true;
+		}
+
+		if (Operation == TEXT("RequestLog"))
+		{
+			// What FMCPHttpServer::WithRequestLog does on every completion: the OnRequestLogged delegate into
+			// UUnrealMCPEditorSubsystem::AddRequestLog. The log starts full so every call also trims the oldest entry.
+			TStrongObjectPtr<UUnrealMCPEditorSubsystem> Subsystem(NewObject<UUnrealMCPEditorSubsystem>());
+			FMCPOnRequestLogged OnRequestLogged;
+			OnRequestLogged.BindUObject(Subsystem.Get(), &UUnrealMCPEditorSubsystem::AddRequestLog);
+
+			const FString Method = TEXT("POST");
+			const FString Path = TEXT("/add_node");
+			const FString ClientIP = TEXT("127.0.0.1");
+			const int32 MaxLogEntries = GetDefault<UUnrealMCPSettings>()->MaxLogEntries;
+			for (int32 Index = 0; Index < MaxLogEntries; ++Index)
+			{
+				OnRequestLogged.Execute(Method, Path, 200, ClientIP);
+			}
+
+			for (int32 Index = 0; Index < Iterations; ++Index)
+			{
+				Samples.Time([&]()
+				{
+					OnRequestLogged.ExecuteIfBound(Method, Path, 200, ClientIP);
+				});
+			}
+			return Subsystem->GetRequestLogs().Num() == MaxLogEntries;
+		}
+
+		return false;
+	}
+}
+
+/**
+ * Times the in-process hot paths behind the HTTP routes at 1, 100 and 10,000 iterations and
+ * fails when the mean cost per iteration exceeds the checked-in baseline.
+ * Run with: UnrealEditor-Cmd Project.uproject -ExecCmds="Automation RunTests UnrealMCP.Perf; Quit" -nullrhi -unattended
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMCPPerfTest, "UnrealMCP.Perf", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FMCPPerfTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const TCHAR* Operation : MCPPerf::OperationNames)
+	{
+		for (int32 Iterations : MCPPerf::IterationCounts)
+		{
+			const FString TestName = FString::Printf(TEXT("%s.%d"), Operation, Iterations);
+			OutBeautifiedNames.Add(TestName);
+			OutTestCommands.Add(TestName);
+		}
+	}
+}
+
+bool FMCPPerfTest::RunTest(const FString& Parameters)
+{
+	FString Operation;
+	FString IterationString;
+	if (!Parameters.Split(TEXT("."), &Operation, &IterationString))
+	{
+		AddError(FString::Printf(TEXT("Malformed test parameters '%s'"), *Parameters));
+		return false;
+	}
+	const int32 Iterations = FCString::Atoi(*IterationString);
+
+	MCPPerf::FSamples Samples;
+	Samples.Seconds.Reserve(Iterations);
+	if (!MCPPerf::RunOperation(Operation, Iterations, Samples, *this))
+	{
+		AddError(FString::Printf(TEXT("%s failed after %d of %d iteration(s)"), *Operation, Samples.Seconds.Num(), Iterations));
+		return false;
+	}
+
+	const double MeanMs = Samples.MeanMs();
+	const double P99Ms = Samples.PercentileMs(0.99);
+	AddInfo(FString::Printf(TEXT("%s x%d: mean %.4f ms, p50 %.4f ms, p99 %.4f ms, max %.4f ms"),
+		*Operation, Iterations, MeanMs, Samples.PercentileMs(0.50), P99Ms, Samples.PercentileMs(1.0)));
+	AddTelemetryData(TEXT("MeanMs"), MeanMs, Parameters);
+	AddTelemetryData(TEXT("P99Ms"), P99Ms, Parameters);
+
+	double Tolerance = 1.0;
+	TSharedPtr<FJsonObject> Baselines = MCPPerf::LoadBaselines(Tolerance);
+	if (!Baselines.IsValid())
+	{
+		AddError(TEXT("Could not load Config/PerfBaselines.json from the UnrealMCP plugin"));
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* OperationBaselines = nullptr;
+	double MaxMeanMs = 0.0;
+	if (!Baselines->TryGetObjectField(Operation, OperationBaselines) || !(*OperationBaselines)->TryGetNumberField(IterationString, MaxMeanMs))
+	{
+		AddWarning(FString::Printf(TEXT("No baseline for %s; measured mean %.4f ms"), *Parameters, MeanMs));
+		return true;
+	}
+
+	const double ThresholdMs = MaxMeanMs * Tolerance;
+	if (MeanMs > ThresholdMs)
+	{
+		AddError(FString::Printf(TEXT("%s regressed: mean %.4f ms per iteration exceeds baseline %.4f ms (x%.2f tolerance)"),
+			*Parameters, MeanMs, MaxMeanMs, Tolerance));
+		return false;
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
@@ -9,6 +9,7 @@
 #include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Layout/SBox.h"
 #include "Styling/AppStyle.h"
+#include "HAL/PlatformTime.h"
 #include "UnrealMCPEditorSubsystem.h"
 #include "Widgets/SMCPServerControlWidget.h"
 
@@ -33,6 +34,10 @@ public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
+	/** IUnrealMCP implementation */
+	virtual double GetModuleStartupSeconds() const override { return ModuleStartupSeconds; }
+	virtual double GetToolbarInitSeconds() const override { return ToolbarInitSeconds; }
+
 private:
 	/** Initialize Level Editor toolbar extension */
 	void InitializeToolbarExtension();
@@ -51,21 +56,28 @@ private:
 
 	/** Reference to the MCP Server Control window */
 	TWeakPtr<SWindow> MCPServerControlWindowPtr;
+
+	/** Startup cost added by this plugin */
+	double ModuleStartupSeconds = 0.0;
+	double ToolbarInitSeconds = 0.0;
 };
 
 void FUnrealMCPModule::StartupModule()
 {
 	UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP Module Starting Up"));
+	const double StartTime = FPlatformTime::Seconds();
 
 	// Initialize toolbar extension after ToolMenus system is ready
 	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FUnrealMCPModule::InitializeToolbarExtension));
 
-	UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP Module Startup Completed"));
+	ModuleStartupSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogUnrealMCP, Log, TEXT("UnrealMCP Module Startup Completed in %.3f ms"), ModuleStartupSeconds * 1000.0);
 }
 
 void FUnrealMCPModule::InitializeToolbarExtension()
 {
 	UE_LOG(LogUnrealMCP, Log, TEXT("Initializing UnrealMCP Toolbar Extension"));
+	const double StartTime = FPlatformTime::Seconds();
 
 	// Extend the Level Editor toolbar
 	UToolMenu* LevelEditorToolbar = UToolMenus::Get()->ExtendMenu("LevelEditor.LevelEditorToolBar.User");
@@ -86,6 +98,8 @@ void FUnrealMCPModule::InitializeToolbarExtension()
 	{
 		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to extend Level Editor toolbar"));
 	}
+
+	ToolbarInitSeconds = FPlatformTime::Seconds() - StartTime;
 }
 
 void FUnrealMCPModule::CleanupToolbarExtension()
@@ -8,21 +8,33 @@
 #include "Editor.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreMisc.h"
+#include "Dom/JsonObject.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnrealMCPEditor, Log, All);
 
 void UUnrealMCPEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
-	Super::Initialize(Collection);
+	const double StartTime = FPlatformTime::Seconds();
 
-	UE_LOG(LogUnrealMCPEditor, Log, TEXT("UnrealMCP Editor Subsystem initialized"));
+	Super::Initialize(Collection);
 
 	// Initialize server based on settings
 	InitializeServer();
+
+	StartupTimings.SubsystemInitMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	UE_LOG(LogUnrealMCPEditor, Log, TEXT("UnrealMCP Editor Subsystem initialized in %.3f ms"), StartupTimings.SubsystemInitMs);
 }
 
 void UUnrealMCPEditorSubsystem::Deinitialize()
 {
+	if (AutoStartTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AutoStartTickerHandle);
+		AutoStartTickerHandle.Reset();
+	}
+
 	// Stop server if running
 	if (IsServerRunning())
 	{
@@ -49,15 +61,20 @@ bool UUnrealMCPEditorSubsystem::StartServer(int32 Port)
 	if (!HttpServer.IsValid())
 	{
 		HttpServer = MakeUnique<FMCPHttpServer>();
+		HttpServer->OnRequestLogged().BindUObject(this, &UUnrealMCPEditorSubsystem::AddRequestLog);
+		HttpServer->OnWriteStartupStats().BindUObject(this, &UUnrealMCPEditorSubsystem::WriteStartupStats);
 	}
 
 	// ✅ 확인됨: FMCPHttpServer::StartServer 시그니처 uint32 매개변수
+	const double StartTime = FPlatformTime::Seconds();
 	bool bServerStarted = HttpServer->StartServer(static_cast<uint32>(Port));
 
 	if (bServerStarted)
 	{
 		CurrentPort = Port;
 		ServerStartTime = FDateTime::Now();
+		StartupTimings.ServerStartMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		StartupTimings.RouterBindMs = static_cast<float>(HttpServer->GetRouterBindSeconds() * 1000.0);
 
 		UE_LOG(LogUnrealMCPEditor, Log, TEXT("HTTP Server started successfully on port %d"), Port);
 
@@ -103,18 +120,34 @@ void UUnrealMCPEditorSubsystem::StopServer()
 
 void UUnrealMCPEditorSubsystem::RestartServer()
 {
-	UE_LOG(LogUnrealMCPEditor, Log, TEXT("Restarting HTTP Server..."));
+	RestartServerOnPort(CurrentPort);
+}
 
-	int32 PortToRestart = CurrentPort;
+bool UUnrealMCPEditorSubsystem::RestartServerOnPort(int32 Port)
+{
+	UE_LOG(LogUnrealMCPEditor, Log, TEXT("Restarting HTTP Server on port %d..."), Port);
 
-	// Stop current server
-	if (IsServerRunning())
+	if (!IsServerRunning())
 	{
-		StopServer();
+		return StartServer(Port);
+	}
+
+	// Same port: rebind only our routes; a new port stops and starts the server to release the old listener
+	const bool bRestarted = HttpServer->RestartServer(static_cast<uint32>(Port));
+	if (bRestarted)
+	{
+		CurrentPort = Port;
+		StartupTimings.LastRestartMs = static_cast<float>(HttpServer->GetLastRestartSeconds() * 1000.0);
+
+		UE_LOG(LogUnrealMCPEditor, Log, TEXT("HTTP Server restarted on port %d in %.3f ms"), Port, StartupTimings.LastRestartMs);
+		OnServerStatusChanged.Broadcast(true);
+	}
+	else
+	{
+		ShowNotification(FText::FromString(FString::Printf(TEXT("Failed to restart MCP Server on port %d"), Port)), true);
 	}
 
-	// Start server on the same port
-	StartServer(PortToRestart);
+	return bRestarted;
 }
 
 bool UUnrealMCPEditorSubsystem::IsServerRunning() const
@@ -137,6 +170,10 @@ FString UUnrealMCPEditorSubsystem::GetServerStatus() const
 {
 	if (IsServerRunning())
 	{
+		if (!HttpServer->IsServerReady())
+		{
+			return FString::Printf(TEXT("Starting on port %d (warming up)"), GetServerPort());
+		}
 		return FString::Printf(TEXT("Running on port %d"), GetServerPort());
 	}
 	else
@@ -145,6 +182,29 @@ FString UUnrealMCPEditorSubsystem::GetServerStatus() const
 	}
 }
 
+FMCPStartupTimings UUnrealMCPEditorSubsystem::GetStartupTimings() const
+{
+	FMCPStartupTimings Timings = StartupTimings;
+
+	// Module timings are owned by the module so they cover work done before the subsystem exists
+	if (IUnrealMCP::IsAvailable())
+	{
+		Timings.ModuleStartupMs = static_cast<float>(IUnrealMCP::Get().GetModuleStartupSeconds() * 1000.0);
+		Timings.ToolbarInitMs = static_cast<float>(IUnrealMCP::Get().GetToolbarInitSeconds() * 1000.0);
+	}
+	return Timings;
+}
+
+void UUnrealMCPEditorSubsystem::WriteStartupStats(const TSharedRef<FJsonObject>& StartupJson) const
+{
+	const FMCPStartupTimings Timings = GetStartupTimings();
+	StartupJson->SetNumberField(TEXT("module_startup_ms"), Timings.ModuleStartupMs);
+	StartupJson->SetNumberField(TEXT("toolbar_init_ms"), Timings.ToolbarInitMs);
+	StartupJson->SetNumberField(TEXT("subsystem_init_ms"), Timings.SubsystemInitMs);
+	StartupJson->SetNumberField(TEXT("server_start_ms"), Timings.ServerStartMs);
+	StartupJson->SetNumberField(TEXT("auto_start_delay_ms"), Timings.AutoStartDelayMs);
+	StartupJson->SetBoolField(TEXT("auto_started"), Timings.bAutoStarted);
+}
 
 bool UUnrealMCPEditorSubsystem::TestConnection()
 {
@@ -221,7 +281,43 @@ void UUnrealMCPEditorSubsystem::InitializeServer()
 		return;
 	}
 
-	// Auto-start removed - server now starts manually via UI control
+	if (!Settings->bAutoStartServer)
+	{
+		return;
+	}
+
+	if (IsRunningCommandlet())
+	{
+		UE_LOG(LogUnrealMCPEditor, Log, TEXT("Skipping MCP server auto-start in commandlet"));
+		return;
+	}
+
+	// Starting here would add the router bind and warm-up to editor startup.
+	// The core ticker only runs once the main loop is up, so defer the start to an idle frame.
+	AutoStartRequestTime = FPlatformTime::Seconds();
+	AutoStartIdleFrames = 0;
+	AutoStartTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUnrealMCPEditorSubsystem::TickAutoStart));
+
+	UE_LOG(LogUnrealMCPEditor, Log, TEXT("MCP server auto-start scheduled for after editor startup"));
+}
+
+bool UUnrealMCPEditorSubsystem::TickAutoStart(float DeltaTime)
+{
+	// Wait while a slow task (asset loading, map load) is still running
+	if (GIsSlowTask || ++AutoStartIdleFrames < AutoStartIdleFrameCount)
+	{
+		return true;
+	}
+
+	AutoStartTickerHandle.Reset();
+	StartupTimings.AutoStartDelayMs = static_cast<float>((FPlatformTime::Seconds() - AutoStartRequestTime) * 1000.0);
+
+	const UUnrealMCPSettings* Settings = UUnrealMCPSettings::Get();
+	const int32 Port = Settings ? Settings->DefaultPort : CurrentPort;
+
+	UE_LOG(LogUnrealMCPEditor, Log, TEXT("Auto-starting MCP server on port %d (%.1f ms after subsystem init)"), Port, StartupTimings.AutoStartDelayMs);
+	StartupTimings.bAutoStarted = StartServer(Port);
+	return false;
 }
 
 
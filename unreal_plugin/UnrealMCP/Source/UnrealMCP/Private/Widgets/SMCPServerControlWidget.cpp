@@ -475,8 +475,17 @@ FReply SMCPServerControlWidget::OnRestartServerClicked()
 {
 	if (MCPSubsystem.IsValid())
 	{
-		MCPSubsystem->RestartServer();
-		ShowNotification(LOCTEXT("ServerRestarted", "MCP Server restarted"));
+		// A changed port in the settings box is applied as a hot port change
+		const FString PortString = PortEditBox->GetText().ToString();
+		const int32 Port = IsPortValid(PortString) ? FCString::Atoi(*PortString) : MCPSubsystem->GetServerPort();
+		if (MCPSubsystem->RestartServerOnPort(Port))
+		{
+			ShowNotification(LOCTEXT("ServerRestarted", "MCP Server restarted"));
+		}
+		else
+		{
+			ShowNotification(LOCTEXT("ServerRestartFailed", "Failed to restart MCP Server"), true);
+		}
 	}
 	return FReply::Handled();
 }
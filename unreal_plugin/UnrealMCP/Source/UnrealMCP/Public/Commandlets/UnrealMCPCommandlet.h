@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPCommandlet.generated.h"
+
+/**
+ * Runs a JSONL manifest of MCP operations without the editor UI, the HTTP server or the Python bridge.
+ * Each line is either {"route": "/stamp", "body": {...}} or an /add_node body such as
+ * {"blueprint_path": "/Game/MyBP", "node_type": "PrintString"}.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=UnrealMCP -manifest=Ops.jsonl [-report=Summary.json] [-savebatch=100] [-nullrhi]
+ */
+UCLASS()
+class UNREALMCP_API UUnrealMCPCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
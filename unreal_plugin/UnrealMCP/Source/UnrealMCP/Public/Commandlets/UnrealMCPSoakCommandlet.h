@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UnrealMCPSoakCommandlet.generated.h"
+
+/**
+ * Drives a large number of MCP create operations through the same code path as the HTTP routes,
+ * releasing the created assets between samples, and reports UObject, package and RSS growth that
+ * does not level off. Assets are created under /Temp/UnrealMCP/Soak.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd Project.uproject -run=UnrealMCPSoak [-ops=200000] [-route=add_node|stamp] [-batch=100]
+ *       [-sampleevery=1000] [-nosave] [-report=Soak.json] [-nullrhi]
+ */
+UCLASS()
+class UNREALMCP_API UUnrealMCPSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPSoakCommandlet();
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+};
@@ -35,4 +35,14 @@ public:
 	{
 		return FModuleManager::Get().IsModuleLoaded("UnrealMCP");
 	}
+
+	/**
+	 * Time spent in StartupModule, in seconds
+	 */
+	virtual double GetModuleStartupSeconds() const = 0;
+
+	/**
+	 * Time spent extending the Level Editor toolbar once ToolMenus is ready, in seconds
+	 */
+	virtual double GetToolbarInitSeconds() const = 0;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "EditorSubsystem.h"
 #include "Engine/DeveloperSettings.h"
+#include "Containers/Ticker.h"
 #include "MCPHttpServer.h"
 #include "UnrealMCPEditorSubsystem.generated.h"
 
@@ -45,6 +46,47 @@ struct FMCPRequestLogEntry
 	}
 };
 
+/**
+ * Startup cost added by the plugin, in milliseconds
+ */
+USTRUCT(BlueprintType)
+struct FMCPStartupTimings
+{
+	GENERATED_BODY()
+
+	/** Time spent in FUnrealMCPModule::StartupModule */
+	UPROPERTY(BlueprintReadOnly)
+	float ModuleStartupMs = 0.0f;
+
+	/** Time spent extending the Level Editor toolbar */
+	UPROPERTY(BlueprintReadOnly)
+	float ToolbarInitMs = 0.0f;
+
+	/** Time spent in UUnrealMCPEditorSubsystem::Initialize */
+	UPROPERTY(BlueprintReadOnly)
+	float SubsystemInitMs = 0.0f;
+
+	/** Time spent creating the HTTP router and binding routes */
+	UPROPERTY(BlueprintReadOnly)
+	float RouterBindMs = 0.0f;
+
+	/** Time spent in the last StartServer call, including router bind */
+	UPROPERTY(BlueprintReadOnly)
+	float ServerStartMs = 0.0f;
+
+	/** Delay between subsystem init and the deferred auto-start, or 0 if auto-start did not run */
+	UPROPERTY(BlueprintReadOnly)
+	float AutoStartDelayMs = 0.0f;
+
+	/** Time spent rebinding routes in the last restart */
+	UPROPERTY(BlueprintReadOnly)
+	float LastRestartMs = 0.0f;
+
+	/** Whether the server was started by the auto-start setting */
+	UPROPERTY(BlueprintReadOnly)
+	bool bAutoStarted = false;
+};
+
 /**
  * Editor Subsystem for managing UnrealMCP HTTP Server
  * Provides centralized control and monitoring of the HTTP server
@@ -77,6 +119,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "UnrealMCP")
 	void RestartServer();
 
+	/** Restart the HTTP server on a port, rebinding only this plugin's routes */
+	UFUNCTION(BlueprintCallable, Category = "UnrealMCP")
+	bool RestartServerOnPort(int32 Port);
+
 	/** Check if the HTTP server is currently running */
 	UFUNCTION(BlueprintPure, Category = "UnrealMCP")
 	bool IsServerRunning() const;
@@ -90,6 +136,10 @@ public:
 	FString GetServerStatus() const;
 
 
+	/** Get the startup cost added by the plugin */
+	UFUNCTION(BlueprintPure, Category = "UnrealMCP")
+	FMCPStartupTimings GetStartupTimings() const;
+
 	/** Test connection to the server */
 	UFUNCTION(BlueprintCallable, Category = "UnrealMCP")
 	bool TestConnection();
@@ -127,9 +177,26 @@ private:
 	TArray<FMCPRequestLogEntry> RequestLogs;
 
 
+	/** Startup timings recorded by the subsystem and the server */
+	FMCPStartupTimings StartupTimings;
+
+	/** Deferred auto-start state */
+	FTSTicker::FDelegateHandle AutoStartTickerHandle;
+	double AutoStartRequestTime = 0.0;
+	int32 AutoStartIdleFrames = 0;
+
+	/** Number of idle main-loop frames to wait before auto-starting the server */
+	static constexpr int32 AutoStartIdleFrameCount = 2;
+
+	/** Add the subsystem's startup timings to the "startup" object of /status */
+	void WriteStartupStats(const TSharedRef<FJsonObject>& StartupJson) const;
+
 	/** Initialize server based on settings */
 	void InitializeServer();
 
+	/** Start the server once the editor main loop is running and idle */
+	bool TickAutoStart(float DeltaTime);
+
 
 	/** Show notification to user */
 	void ShowNotification(const FText& Message, bool bIsError = false);
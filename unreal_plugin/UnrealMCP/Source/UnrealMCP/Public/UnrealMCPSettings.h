@@ -29,10 +29,102 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (DisplayName = "Auto Start Server"))
 	bool bAutoStartServer = false;
 
+	/** Whether to pre-load the Blueprint pipeline and compile a throwaway Blueprint when the server starts */
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (DisplayName = "Warm Up On Start"))
+	bool bWarmUpOnStart = true;
+
 	/** Default port for the HTTP server */
 	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (DisplayName = "Default Port", ClampMin = 1024, ClampMax = 65535))
 	int32 DefaultPort = 8080;
 
+	/** Port of the health listener that answers /status from a snapshot without waiting for the game thread (0 = disabled) */
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (DisplayName = "Health Port", ClampMin = 0, ClampMax = 65535))
+	int32 HealthPort = 8081;
+
+	/** Port of the WebSocket endpoint that multiplexes requests and pushes events over one persistent connection (0 = disabled, e.g. 8082 to enable) */
+	UPROPERTY(Config, EditAnywhere, Category = "Server", meta = (DisplayName = "WebSocket Port", ClampMin = 0, ClampMax = 65535))
+	int32 WebSocketPort = 0;
+
+	/** Maximum number of mutation requests waiting to run; further requests get 429 Too Many Requests */
+	UPROPERTY(Config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Max Queued Requests", ClampMin = 1, ClampMax = 10000))
+	int32 MaxQueuedJobs = 64;
+
+	/** Maximum total estimated cost (assets to create) of queued requests */
+	UPROPERTY(Config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Max Queued Cost", ClampMin = 1))
+	int32 MaxQueuedCost = 20000;
+
+	/** Game-thread time per frame spent running queued requests; at least one request runs every frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Frame Budget (ms)", ClampMin = 1.0, ClampMax = 1000.0))
+	float QueueFrameBudgetMs = 16.0f;
+
+	/** Number of Idempotency-Key results kept for replay; least recently used keys are evicted first (0 = ignore the header) */
+	UPROPERTY(Config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Idempotency Cache Size", ClampMin = 0, ClampMax = 100000))
+	int32 IdempotencyCacheSize = 1024;
+
+	/** How long a completed Idempotency-Key result is replayed */
+	UPROPERTY(Config, EditAnywhere, Category = "Queue", meta = (DisplayName = "Idempotency Key TTL (s)", ClampMin = 1.0))
+	float IdempotencyTTLSeconds = 600.0f;
+
+	/** Number of dry-run results kept for /commit; older ones are released (0 = release every dry run right away) */
+	UPROPERTY(Config, EditAnywhere, Category = "Dry Run", meta = (DisplayName = "Results Kept", ClampMin = 0, ClampMax = 1000))
+	int32 DryRunResultsKept = 16;
+
+	/** How long a dry-run result can still be committed */
+	UPROPERTY(Config, EditAnywhere, Category = "Dry Run", meta = (DisplayName = "Result TTL (s)", ClampMin = 1.0))
+	float DryRunTTLSeconds = 600.0f;
+
+	/** Compress response bodies for clients that send Accept-Encoding: gzip or deflate */
+	UPROPERTY(Config, EditAnywhere, Category = "Compression", meta = (DisplayName = "Compress Responses"))
+	bool bCompressResponses = true;
+
+	/** Responses smaller than this are sent uncompressed; compressing them costs more than it saves */
+	UPROPERTY(Config, EditAnywhere, Category = "Compression", meta = (DisplayName = "Response Threshold (bytes)", ClampMin = 0, EditCondition = "bCompressResponses"))
+	int32 CompressionThresholdBytes = 8192;
+
+	/** zlib level, 1 (fastest) to 9 (smallest); compression runs on a worker thread, not the game thread */
+	UPROPERTY(Config, EditAnywhere, Category = "Compression", meta = (DisplayName = "Compression Level", ClampMin = 1, ClampMax = 9, EditCondition = "bCompressResponses"))
+	int32 CompressionLevel = 6;
+
+	/** Largest size a gzip or deflate request body may inflate to; larger bodies are rejected */
+	UPROPERTY(Config, EditAnywhere, Category = "Compression", meta = (DisplayName = "Max Inflated Request (MB)", ClampMin = 1, ClampMax = 1024))
+	int32 MaxInflatedRequestMB = 64;
+
+	/** Events kept per /events subscriber; when a slow reader's buffer is full the oldest events are dropped and counted */
+	UPROPERTY(Config, EditAnywhere, Category = "Events", meta = (DisplayName = "Buffer Size", ClampMin = 16, ClampMax = 100000))
+	int32 EventBufferSize = 1024;
+
+	/** Subscribers tracked at once; a new one evicts the subscriber that has gone longest without polling */
+	UPROPERTY(Config, EditAnywhere, Category = "Events", meta = (DisplayName = "Max Subscribers", ClampMin = 1, ClampMax = 1000))
+	int32 MaxEventSubscribers = 64;
+
+	/** A subscriber that does not poll for this long is forgotten along with its buffer */
+	UPROPERTY(Config, EditAnywhere, Category = "Events", meta = (DisplayName = "Subscriber Idle Timeout (s)", ClampMin = 1.0))
+	float EventSubscriberIdleSeconds = 60.0f;
+
+	/** Hold asset registry notifications for assets created by a batch (/stamp, commandlet runs) and send them in one pass when it ends */
+	UPROPERTY(Config, EditAnywhere, Category = "Asset Registry", meta = (DisplayName = "Batch Registry Notifications"))
+	bool bBatchAssetNotifications = true;
+
+	/** Whether MCP operations manage garbage collection (defer during bursts, budgeted incremental work, forced collections) */
+	UPROPERTY(Config, EditAnywhere, Category = "Garbage Collection", meta = (DisplayName = "Manage Garbage Collection"))
+	bool bManageGarbageCollection = true;
+
+	/** Force a collection after this many assets have been created since the last one (0 = never) */
+	UPROPERTY(Config, EditAnywhere, Category = "Garbage Collection", meta = (DisplayName = "Collect After Operations", ClampMin = 0, EditCondition = "bManageGarbageCollection"))
+	int32 GCCollectAfterOperations = 1000;
+
+	/** Force a collection once RSS has grown by this many MB since the last one (0 = never) */
+	UPROPERTY(Config, EditAnywhere, Category = "Garbage Collection", meta = (DisplayName = "Collect After Growth (MB)", ClampMin = 0, EditCondition = "bManageGarbageCollection"))
+	int32 GCCollectAfterGrowthMB = 1024;
+
+	/** Time per frame spent on pending incremental reachability analysis and purging */
+	UPROPERTY(Config, EditAnywhere, Category = "Garbage Collection", meta = (DisplayName = "Incremental Frame Budget (ms)", ClampMin = 0.1, ClampMax = 50.0, EditCondition = "bManageGarbageCollection"))
+	float GCFrameBudgetMs = 2.0f;
+
+	/** How long after the last operation the engine's periodic collection stays deferred */
+	UPROPERTY(Config, EditAnywhere, Category = "Garbage Collection", meta = (DisplayName = "Burst Grace Period (s)", ClampMin = 0.0, ClampMax = 60.0, EditCondition = "bManageGarbageCollection"))
+	float GCBurstGraceSeconds = 1.0f;
+
 	/** Log level for UnrealMCP operations (0=NoLogging, 1=Fatal, 2=Error, 3=Warning, 4=Display, 5=Log, 6=Verbose, 7=VeryVerbose) */
 	UPROPERTY(Config, EditAnywhere, Category = "Logging", meta = (DisplayName = "Log Level", ClampMin = 0, ClampMax = 7))
 	uint8 LogLevel = 3;
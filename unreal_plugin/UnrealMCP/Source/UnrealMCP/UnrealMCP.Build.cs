@@ -25,8 +25,12 @@ public class UnrealMCP : ModuleRules
 				"JsonUtilities",
 				"HTTP",
 				"Sockets",
+				"Networking",
+				"WebSocketNetworking",
 				"DeveloperSettings",
-				"InputCore"
+				"InputCore",
+				"Projects",
+				"AssetRegistry"
 			}
 		);
 
@@ -48,5 +52,8 @@ public class UnrealMCP : ModuleRules
 				}
 			);
 		}
+
+		// gzip/deflate for HTTP request and response bodies
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
 	}
 }
\ No newline at end of file